@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+
+#include <filament/Box.h>
+#include <filament/RenderableManager.h>
+#include <filament/TransformManager.h>
+#include <gltfio/Animator.h>
+#include <gltfio/FilamentAsset.h>
+#include <math/vec3.h>
+
+namespace polyvox {
+
+    enum class AnimatedBoundsMode : int {
+        // every renderable keeps the bounding box computed at load (i.e. the bind pose)
+        BIND_POSE = 0,
+        // skinned renderables are bounded by the bind pose and every pose of each glTF animation currently playing (including layers),
+        // precomputed once per animation
+        PER_CLIP = 1,
+        // skinned renderables are bounded by their joints' current positions, recomputed every frame they're posed
+        PER_FRAME = 2
+    };
+
+    //
+    // Joint-based bounds for the skinned renderables of a single asset.
+    //
+    // A skinned renderable is bounded by the positions of its joints (in the renderable's space), padded by how far its bind-pose
+    // box extends beyond its joints at the bind pose.
+    //
+    struct AnimatedBounds {
+        AnimatedBoundsMode mMode = AnimatedBoundsMode::BIND_POSE;
+        // added to every box when it is set on a renderable (e.g. to allow for morph targets, whose extents aren't known at runtime)
+        float mExtraPadding = 0.0f;
+        // set when the mode or padding changes, so the boxes are recomputed on the next frame even if nothing is animating
+        bool mDirty = false;
+        std::vector<filament::RenderableManager::Instance> mRenderables;
+        std::vector<filament::TransformManager::Instance> mRenderableTransforms;
+        // the box each renderable had at load
+        std::vector<filament::Box> mBindBoxes;
+        std::vector<float> mPadding;
+        // every joint of every skin (a renderable is bounded by all of them, as which skin it uses isn't exposed)
+        std::vector<filament::TransformManager::Instance> mJoints;
+        // PER_CLIP only: the glTF animations the current boxes were computed for
+        std::vector<int> mClips;
+        // reusable scratch buffer
+        std::vector<filament::math::float3> mJointPositions;
+    };
+
+    //
+    // Collects the skinned renderables of [asset] and measures their padding. Returns false if [asset] has none.
+    //
+    bool initAnimatedBounds(
+        AnimatedBounds& bounds,
+        filament::gltfio::FilamentAsset* asset,
+        filament::RenderableManager& rm,
+        filament::TransformManager& tm);
+
+    //
+    // Writes the padded joint box of each renderable in [bounds] for the current pose into [boxes] (one per renderable), or grows
+    // the boxes already there if [accumulate] is true.
+    //
+    void computeJointBounds(
+        AnimatedBounds& bounds,
+        filament::TransformManager& tm,
+        std::vector<filament::Box>& boxes,
+        bool accumulate);
+
+    //
+    // Samples glTF animation [clipIndex] at [sampleRate] and returns the union of the padded joint boxes of each renderable over every
+    // sample (or nothing if [clipIndex] is invalid). Poses [asset], then restores its local transforms before returning.
+    //
+    std::vector<filament::Box> bakeClipBounds(
+        AnimatedBounds& bounds,
+        int clipIndex,
+        filament::gltfio::FilamentAsset* asset,
+        filament::gltfio::Animator* animator,
+        filament::TransformManager& tm,
+        float sampleRate);
+}
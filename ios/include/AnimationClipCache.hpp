@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <filament/TransformManager.h>
+#include <gltfio/Animator.h>
+#include <gltfio/FilamentAsset.h>
+
+namespace polyvox {
+
+    //
+    // A glTF animation pre-sampled at a fixed rate into a table of local node transforms.
+    //
+    // Only nodes that the animation actually moves are stored. Frames are stored SoA (see BoneTracks.hpp), quantized to 16 bits per component:
+    // rotations as SNORM16, translations and scales as half floats.
+    //
+    struct BakedClip {
+        float sampleRate = 0.0f;
+        float duration = 0.0f;
+        uint32_t numFrames = 0;
+        // indices into FilamentAsset::getEntities() of the animated nodes
+        std::vector<uint32_t> nodes;
+        // [frame][x, y, z, w][node]
+        std::vector<int16_t> rotations;
+        // [frame][tx, ty, tz, sx, sy, sz][node]
+        std::vector<uint16_t> translationsAndScales;
+
+        //
+        // Decodes [frame] into a single float SoA frame in the BoneTracks.hpp layout.
+        // [out] must have space for nodes.size() * BoneTrack::COMPONENT_COUNT floats.
+        //
+        void decodeFrame(uint32_t frame, float* out) const;
+
+        size_t getSizeInBytes() const {
+            return rotations.size() * sizeof(int16_t) + translationsAndScales.size() * sizeof(uint16_t) + nodes.size() * sizeof(uint32_t);
+        }
+    };
+
+    //
+    // Bakes glTF animations into BakedClips, shared by every asset loaded from the same source.
+    //
+    class AnimationClipCache {
+        public:
+            //
+            // Returns the baked clip for animation [clipIndex] of the asset loaded from [key], baking it with [animator] (which belongs to [asset]) if necessary.
+            // Baking poses [asset], then restores its local transforms before returning.
+            //
+            std::shared_ptr<const BakedClip> getOrBake(
+                const std::string& key,
+                int clipIndex,
+                filament::gltfio::FilamentAsset* asset,
+                filament::gltfio::Animator* animator,
+                filament::TransformManager& transformManager,
+                float sampleRate);
+
+            //
+            // Releases all clips baked for [key]. Assets currently playing one of these clips keep it alive until they stop.
+            //
+            void remove(const std::string& key);
+
+            // releases every clip (as per remove)
+            void clear() { _clips.clear(); }
+
+        private:
+            static std::shared_ptr<BakedClip> bake(
+                int clipIndex,
+                filament::gltfio::FilamentAsset* asset,
+                filament::gltfio::Animator* animator,
+                filament::TransformManager& transformManager,
+                float sampleRate);
+
+            std::map<std::pair<std::string, int>, std::shared_ptr<const BakedClip>> _clips;
+    };
+}
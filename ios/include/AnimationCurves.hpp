@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace polyvox {
+
+    enum class CurveInterpolation : int {
+        STEP = 0,
+        LINEAR = 1,
+        // Hermite spline using each key's in/out tangents (in units per second, as per glTF's CUBICSPLINE)
+        CUBIC = 2
+    };
+
+    struct CurveKey {
+        float time;
+        float value;
+        float inTangent;
+        float outTangent;
+    };
+
+    struct AnimationCurve {
+        // the index written to by AnimationCurves::evaluate
+        uint32_t target;
+        CurveInterpolation interpolation;
+        // sorted by time
+        std::vector<CurveKey> keys;
+
+        //
+        // Returns the value of the curve at [time] (held at the first/last key outside the curve's range).
+        // [cursor] caches the current key between calls, so evaluating at nearby times (in either direction) doesn't need to search.
+        //
+        float evaluate(float time, uint32_t& cursor) const;
+    };
+
+    //
+    // A set of keyframed curves evaluated natively every frame, as a compact alternative to dense per-frame weights/transforms
+    // for procedurally authored morph/bone animations.
+    //
+    struct AnimationCurves {
+        std::vector<AnimationCurve> curves;
+        // the time of the last key in any curve
+        float duration = 0.0f;
+
+        //
+        // Builds [numCurves] curves from flattened arrays:
+        // - [targets], [interpolations] and [keyCounts] each hold one entry per curve (every target must be less than [numTargets]);
+        // - [keys] holds the keys for every curve in turn, as 4 floats per key (time in seconds, value, in tangent, out tangent).
+        // Returns nullptr (after logging why) if the curves are invalid.
+        //
+        static std::shared_ptr<AnimationCurves> create(
+            const int* const targets,
+            const int* const interpolations,
+            const int* const keyCounts,
+            const float* const keys,
+            int numCurves,
+            int numTargets);
+
+        //
+        // Writes the value of each curve at [time] to out[curve.target]. Targets without a curve are left untouched.
+        // [cursors] must hold one entry per curve.
+        //
+        void evaluate(float time, uint32_t* cursors, float* out) const;
+    };
+}
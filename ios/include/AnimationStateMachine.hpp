@@ -0,0 +1,92 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace polyvox {
+
+    enum class TransitionConditionOp : int {
+        GREATER = 0,
+        LESS = 1,
+        EQUAL = 2,
+        NOT_EQUAL = 3,
+        // true while the parameter is non-zero; the parameter is reset to zero when the transition is taken
+        TRIGGER = 4
+    };
+
+    struct TransitionCondition {
+        int mParameter;
+        TransitionConditionOp mOp;
+        float mValue;
+    };
+
+    //
+    // A state plays one glTF animation, or blends between several by the value of a parameter (e.g. idle/walk/run by speed).
+    // Every animation in a state shares the same normalized time, so blended animations of different lengths stay in step.
+    //
+    struct AnimationState {
+        std::string mName;
+        // sorted by threshold
+        std::vector<int> mClipIndices;
+        std::vector<float> mThresholds;
+        std::vector<float> mDurations;
+        // the parameter blended by (ignored for a single animation)
+        int mBlendParameter = -1;
+        float mSpeed = 1.0f;
+        bool mLoop = true;
+    };
+
+    struct StateTransition {
+        // -1 for a transition from any state (other than [mTo])
+        int mFrom;
+        int mTo;
+        // the crossfade duration in seconds
+        float mDuration;
+        // if >= 0, the transition is only taken once the normalized time of the state being left reaches this (i.e. 1 is the end of the animation)
+        float mExitTime = -1.0f;
+        // all must hold
+        std::vector<TransitionCondition> mConditions;
+    };
+
+    //
+    // A state and the blend layers playing it (see AnimationLayerStack).
+    //
+    struct ActiveAnimationState {
+        int mState = -1;
+        float mNormalizedTime = 0.0f;
+        // the number of layers (one per animation in the state)
+        size_t mNumLayers = 0;
+    };
+
+    //
+    // Evaluated in AssetManager::updateAnimations. The layers of the state being faded out and the current state always occupy the start of
+    // the asset's AnimationLayerStack (in that order), so any layers added with AssetManager::addAnimationLayer are blended over them.
+    //
+    struct AnimationStateMachine {
+        std::vector<AnimationState> mStates;
+        std::vector<StateTransition> mTransitions;
+        std::vector<std::string> mParameterNames;
+        std::vector<float> mParameters;
+
+        ActiveAnimationState mCurrent;
+        ActiveAnimationState mPrevious;
+        float mFadeElapsed = 0.0f;
+        float mFadeDuration = 0.0f;
+        // reusable scratch buffer for the weight of each animation in a state
+        std::vector<float> mMotionWeights;
+
+        size_t getNumLayers() const {
+            return mPrevious.mNumLayers + mCurrent.mNumLayers;
+        }
+    };
+
+    //
+    // Writes the weight of each animation in [state] for the current parameter values to [out] (which sums to 1).
+    //
+    void getMotionWeights(const AnimationState& state, const std::vector<float>& parameters, float* out);
+
+    //
+    // Returns the index of the first transition that can be taken from the current state, or -1 if none can.
+    //
+    int findTransition(const AnimationStateMachine& machine);
+}
@@ -2,6 +2,7 @@
 
 #include <mutex>
 
+#include <filament/Camera.h>
 #include <filament/Scene.h>
 
 #include <gltfio/AssetLoader.h>
@@ -9,7 +10,13 @@
 #include <gltfio/ResourceLoader.h>
 
 #include "SceneAsset.hpp"
+#include "AnimationClipCache.hpp"
+#include "AssetMetadata.hpp"
+#include "InstancedMesh.hpp"
+#include "Tween.hpp"
+#include "WorkerPool.hpp"
 #include "ResourceBuffer.hpp"
+#include "material/SpecializedMaterialProvider.hpp"
 
 typedef int32_t EntityId;
 
@@ -27,11 +34,17 @@ namespace polyvox {
             ~AssetManager();
             EntityId loadGltf(const char* uri, const char* relativeResourcePath);
             EntityId loadGlb(const char* uri, bool unlit);
+            bool addMaterialSpecialization(const char* packageUri, uint32_t features);
             FilamentAsset* getAssetByEntityId(EntityId entityId);
             void remove(EntityId entity);
             void destroyAll();
             unique_ptr<vector<string>> getAnimationNames(EntityId entity);
             float getAnimationDuration(EntityId entity, int animationIndex);
+            //
+            // Returns the metadata gathered when [entity] was loaded (or null if it isn't loaded). Safe to call from any thread, and never waits
+            // on the render thread; the result stays valid after the asset is removed.
+            //
+            shared_ptr<const AssetMetadata> getMetadata(EntityId entity);
             unique_ptr<vector<string>> getMorphTargetNames(EntityId entity, const char *meshName);
             void transformToUnitCube(EntityId e);
             inline void updateTransform(EntityId e);
@@ -42,7 +55,14 @@ namespace polyvox {
             size_t getCameraEntityCount(EntityId e);
             const utils::Entity* getLightEntities(EntityId e) const noexcept;
             size_t getLightEntityCount(EntityId e) const noexcept;
-            void updateAnimations();
+            void updateAnimations(float deltaInSecs, const Camera* camera = nullptr);
+            void setAnimationLod(bool enabled, float halfRateScreenSize, float quarterRateScreenSize);
+            void getSkinUpdateStats(uint64_t* updated, uint64_t* skipped, bool reset);
+            void setAnimationTimeScale(float timeScale);
+            bool setAnimationTimeScale(EntityId entity, float timeScale);
+            void setAnimationsPaused(bool paused);
+            bool setAnimationsPaused(EntityId entity, bool paused);
+            void setFixedAnimationTimestep(float timestepInSecs);
             bool setMaterialColor(EntityId e, const char* meshName, int materialInstance, const float r, const float g, const float b, const float a);
 
             bool setMorphAnimationBuffer(
@@ -54,6 +74,23 @@ namespace polyvox {
                 int numFrames, 
                 float frameLengthInMs);
                 
+            bool setCompressedMorphAnimationBuffer(
+                EntityId entityId,
+                const char* entityName,
+                const void* const data,
+                size_t size,
+                const int* const morphIndices,
+                int numMorphTargets);
+
+            bool setMorphAnimationCurves(
+                EntityId entityId,
+                const char* entityName,
+                const int* const morphIndices,
+                const int* const interpolations,
+                const int* const keyCounts,
+                const float* const keys,
+                int numCurves);
+
             void setMorphTargetWeights(EntityId entityId, const char* const entityName, const float* const weights, int count);
 
             bool setBoneAnimationBuffer(
@@ -64,41 +101,280 @@ namespace polyvox {
                 const char** const boneNames,
                 const char** const meshName,
                 int numMeshTargets,
-                float frameLengthInMs);
-            void playAnimation(EntityId e, int index, bool loop, bool reverse, bool replaceActive, float crossfade = 0.3f);
+                float frameLengthInMs,
+                bool includesScale = false);
+            bool setCompressedBoneAnimationBuffer(
+                EntityId entity,
+                const void* const data,
+                size_t size,
+                int numBones,
+                const char** const boneNames,
+                const char** const meshName,
+                int numMeshTargets);
+            //
+            // Registers a source skeleton (see RetargetCache) and returns its handle, or -1 on error.
+            // Joint names are matched against each asset once, the first time a clip for this skeleton is set on it.
+            //
+            int createSkeleton(const char** const boneNames, int numBones, const float* const restPose);
+            bool removeSkeleton(int skeleton);
+            //
+            // Registers bone animation frames (in the same format as setBoneAnimationBuffer, one bone per skeleton bone) and returns a handle
+            // that can be passed to setBoneAnimationClip for any number of assets, or -1 on error.
+            //
+            int createBoneAnimationClip(int skeleton, const float* const frameData, int numFrames, float frameLengthInMs, bool includesScale);
+            bool removeBoneAnimationClip(int clip);
+            //
+            // Replaces the bone animation of [entity] with [clip]. Bones with no matching joint in [entity] are ignored.
+            //
+            bool setBoneAnimationClip(EntityId entity, int clip);
+            bool setBoneAnimationCurves(
+                EntityId entity,
+                const char** const boneNames,
+                int numBones,
+                const char** const meshNames,
+                int numMeshTargets,
+                const int* const channels,
+                const int* const interpolations,
+                const int* const keyCounts,
+                const float* const keys,
+                int numCurves);
+            void setAnimationCompression(bool enabled, float maxError);
+            void playAnimation(EntityId e, int index, bool loop, bool reverse, bool replaceActive, float crossfade = 0.3f, float startOffset = 0.0f);
+            void setAnimationBaking(bool enabled, float sampleRate);
+            //
+            // Creates a LivePoseStream driving the morph targets of [meshName] (if not null) and/or the joints named in [boneNames].
+            // The stream is owned by the asset and remains valid until removeLivePoseStream is called or the asset is removed.
+            //
+            LivePoseStream* createLivePoseStream(EntityId e, const char* const meshName, const char** const boneNames, int numBones);
+            bool removeLivePoseStream(EntityId e);
+
+            //
+            // Starts tweening [property] of [entity] from [from] to [to] over [durationInSecs], returning the ID of the tween (or -1 on error).
+            // [from] and [to] hold as many values as the property has components (see TweenProperty).
+            // Tweens are advanced in updateAnimations (so they are affected by the global time scale and pause state) and replace any
+            // earlier tween of the same property on the same target.
+            //
+            int32_t tween(EntityId entity, TweenProperty property, const float* const from, const float* const to, float durationInSecs, Easing easing);
+            int32_t tweenMaterialColor(EntityId entity, const char* meshName, int materialIndex, const float* const from, const float* const to, float durationInSecs, Easing easing);
+            bool cancelTween(int32_t tweenId);
+            void setTweenCallback(TweenCallback callback);
+            //
+            // Returns a handle to the joint (or any other node) named [jointName] in [entity], or 0 if none exists, so constraints
+            // can be attached without looking up names every frame.
+            //
+            EntityId getJointHandle(EntityId entity, const char* jointName);
+            //
+            // Sets how the bounding boxes of the skinned renderables in [entity] follow its animations (see AnimatedBoundsMode), so they
+            // can stay frustum culled without popping. [padding] is added to every box (e.g. to allow for morph targets).
+            //
+            bool setAnimatedBounds(EntityId entity, AnimatedBoundsMode mode, float padding);
+            //
+            // Constraints are solved on the render thread after animations have been sampled, and return an ID (or -1 on error).
+            // Joints are handles returned by getJointHandle.
+            //
+            int addTwoBoneIkConstraint(EntityId entity, EntityId upperJoint, EntityId lowerJoint, EntityId endJoint, float weight);
+            int addChainIkConstraint(EntityId entity, const EntityId* const joints, int numJoints, bool fabrik, int iterations, float weight);
+            int addLookAtConstraint(EntityId entity, EntityId joint, float forwardX, float forwardY, float forwardZ, float maxAngle, float weight);
+            bool setConstraintTarget(EntityId entity, int constraintId, float x, float y, float z);
+            bool setConstraintTargetEntity(EntityId entity, int constraintId, EntityId target);
+            bool setConstraintPole(EntityId entity, int constraintId, float x, float y, float z);
+            bool setConstraintWeight(EntityId entity, int constraintId, float weight);
+            bool removeConstraint(EntityId entity, int constraintId);
+            int addAnimationLayer(EntityId e, int index, float weight, bool additive, bool loop);
+            bool removeAnimationLayer(EntityId e, int layer);
+            bool setAnimationLayerWeight(EntityId e, int layer, float weight);
+            bool setAnimationLayerTime(EntityId e, int layer, float timeInSecs);
+            bool setAnimationLayerSpeed(EntityId e, int layer, float speed);
+            bool setAnimationLayerMask(EntityId e, int layer, const char** const jointNames, const float* const weights, int count, bool includeDescendants);
+            //
+            // Each asset can have a state machine that plays its glTF animations via blend layers, evaluated on the render thread every frame
+            // (so once set up, only parameter changes need to be sent). Parameters, states and transitions return an index (or -1 on error).
+            // A state blends [clipIndices] by [blendParameter] at ascending [thresholds] (or plays a single animation if [numClips] is 1).
+            // [fromState] is -1 for a transition from any state; [ops] are TransitionConditionOp values.
+            //
+            int addAnimationStateParameter(EntityId entity, const char* name, float value);
+            int addAnimationState(EntityId entity, const char* name, const int* const clipIndices, const float* const thresholds, int numClips, int blendParameter, float speed, bool loop);
+            int addAnimationStateTransition(EntityId entity, int fromState, int toState, float crossfadeInSecs, float exitTime, const int* const parameters, const int* const ops, const float* const values, int numConditions);
+            bool setAnimationStateParameter(EntityId entity, int parameter, float value);
+            bool setAnimationState(EntityId entity, int state, float crossfadeInSecs);
+            int getAnimationState(EntityId entity);
+            bool removeAnimationStateMachine(EntityId entity);
             void stopAnimation(EntityId e, int index);
             void setMorphTargetWeights(const char* const entityName, float *weights, int count);
             void loadTexture(EntityId entity, const char* resourcePath, int renderableIndex);
-            void setAnimationFrame(EntityId entity, int animationIndex, int animationFrame);
+            bool seekAnimation(EntityId entity, int animationIndex, float timeInSecs);
+            bool setAnimationFrame(EntityId entity, int animationIndex, int animationFrame, float framesPerSecond);
             bool hide(EntityId entity, const char* meshName);
             bool reveal(EntityId entity, const char* meshName);
             const char* getNameForEntity(EntityId entityId);
+            // as above, but only for entities in a loaded asset; safe to call from any thread
+            const char* getMetadataName(EntityId entityId);
+
+            //
+            // Draws [count] copies of the mesh [meshName] in [entity] (or only primitive [primitiveIndex], if not -1) with hardware instancing,
+            // using the mesh's materials. [transforms] are [count] column-major 4x4 matrices relative to the asset's root.
+            // Returns the entity that parents every copy (which can be transformed like any other), or 0 on error. The original mesh is left as-is.
+            // Nodes with EXT_mesh_gpu_instancing are drawn this way when loaded (parented to the node, in place of its single copy).
+            //
+            EntityId createInstancedMesh(EntityId entity, const char* meshName, int primitiveIndex, const float* const transforms, int count);
+            // replaces the transforms of copies [offset, offset + count) in one upload per renderable
+            bool setInstanceTransforms(EntityId instancedMesh, const float* const transforms, int offset, int count);
+            bool removeInstancedMesh(EntityId instancedMesh);
             
         private:
             AssetLoader* _assetLoader = nullptr;
+            AssetLoader* _unlitAssetLoader = nullptr;
             const ResourceLoaderWrapper* const _resourceLoaderWrapper;
             NameComponentManager* _ncm = nullptr;
             Engine* _engine;
             Scene* _scene;
             MaterialProvider* _ubershaderProvider = nullptr;
+            MaterialProvider* _unlitMaterialProvider = nullptr;
+            SpecializedMaterialProvider* _specializedMaterialProvider = nullptr;
             gltfio::ResourceLoader* _gltfResourceLoader = nullptr;
             gltfio::TextureProvider* _stbDecoder = nullptr;
             gltfio::TextureProvider* _ktxDecoder = nullptr;
             std::mutex _animationMutex;
+
+            // animation clock state, guarded by _animationMutex
+            float _animationTimeScale = 1.0f;
+            bool _animationsPaused = false;
+            float _fixedAnimationTimestep = 0.0f;
+
+            // animation LOD policy, guarded by _animationMutex
+            bool _animationLodEnabled = false;
+            float _halfRateScreenSize = 0.0f;
+            float _quarterRateScreenSize = 0.0f;
+            uint32_t _animationFrameCount = 0;
+
+            // the number of times skins have been recomputed (at most once per asset per frame),
+            // and the number of recomputations avoided compared to updating once per active animation
+            uint64_t _skinUpdates = 0;
+            uint64_t _skinUpdatesSkipped = 0;
+
+            // guarded by _animationMutex
+            vector<Tween> _tweens;
+            int32_t _nextTweenId = 0;
+            // the tweens ended by updateTweens (and whether each finished), reported once _animationMutex has been released
+            vector<std::pair<int32_t, bool>> _endedTweens;
+            // scratch buffer the ended tweens are swapped into to be reported (only ever touched on the render thread)
+            vector<std::pair<int32_t, bool>> _notifiedTweens;
+            // only ever invoked without _animationMutex held; recursive, so the callback can itself end a tween
+            std::recursive_mutex _tweenCallbackMutex;
+            TweenCallback _tweenCallback = nullptr;
+            int32_t addTween(Tween&& tween);
+            void updateTweens(float deltaInSecs);
+            void notifyTweenEnded(int32_t tweenId, bool finished);
+            bool applyTween(const Tween& tween, float t);
+            bool shouldEvaluateAnimations(const SceneAsset& asset, size_t assetIndex, const Camera& camera);
+            void updateHidden(EntityId entityId);
         
+            // published whenever an asset is loaded or removed (see AssetMetadataTable); read with std::atomic_load
+            shared_ptr<const AssetMetadataTable> _metadata = std::make_shared<AssetMetadataTable>();
+            void publishMetadata(shared_ptr<const AssetMetadataTable> table);
+
             vector<SceneAsset> _assets;
             tsl::robin_map<EntityId, int> _entityIdLookup;
  
             utils::Entity findEntityByName(
-                SceneAsset asset, 
+                const SceneAsset& asset,
                 const char* entityName
             );
             
             inline void updateTransform(SceneAsset& asset);
 
-            inline void setBoneTransform(SceneAsset& asset, int frameNumber);
+            AssetLoader* getLoaderForAsset(const SceneAsset& asset) {
+                return asset.mUnlit ? _unlitAssetLoader : _assetLoader;
+            }
+
+            inline void setBoneTransform(SceneAsset& asset);
+
+            struct AnimationSampleJob {
+                SceneAsset* asset;
+                // null to blend the asset's animation layers
+                AnimationStatus* animation;
+            };
+            // below this many morph/bone animations, sampling runs serially on the render thread
+            static constexpr size_t kMinParallelAnimationJobs = 8;
+            // created on first use
+            WorkerPool* _animationWorkers = nullptr;
+            vector<AnimationSampleJob> _animationSampleJobs;
+            void sampleAnimations();
+            void sampleAnimation(SceneAsset& asset, AnimationStatus& anim);
+            void sampleLayers(SceneAsset& asset);
+            void runSampleJob(const AnimationSampleJob& job);
+            void bakeLayer(SceneAsset& asset, AnimationLayer& layer);
+            void captureRestPose(SceneAsset& asset);
+            void restoreLayerNodes(SceneAsset& asset);
+            bool blendLayers(SceneAsset& asset, bool overAnimations);
+            bool applyLivePose(SceneAsset& asset);
+            AnimationLayer* getAnimationLayer(EntityId entity, int layer);
+            AnimationStateMachine* getStateMachine(EntityId entity, bool create);
+            void enterAnimationState(SceneAsset& asset, int state, float crossfadeInSecs);
+            void updateStateMachine(SceneAsset& asset, float deltaInSecs);
+            void advanceAnimationState(SceneAsset& asset, ActiveAnimationState& active, float stateWeight, float deltaInSecs, size_t& layerIndex, float& totalWeight);
+            void updateAnimatedBounds(SceneAsset& asset, bool posed);
+            void setAnimatedBoxes(SceneAsset& asset, const vector<Box>& boxes);
+            // the bounds of each glTF animation (keyed by the path assets were loaded from), baked on first use; guarded by _animationMutex
+            std::map<std::pair<std::string, int>, vector<Box>> _clipBounds;
+            vector<Box> _boundsScratch;
+            int addConstraint(EntityId entity, JointConstraint&& constraint);
+            JointConstraint* getConstraint(EntityId entity, int constraintId);
+
+            // glTF animations are pre-sampled on first play when enabled, guarded by _animationMutex
+            bool _animationBakingEnabled = false;
+            float _animationBakingRate = 30.0f;
+            AnimationClipCache _clipCache;
+            void bakeAnimation(SceneAsset& asset, AnimationStatus& anim);
+            inline void setBakedTransforms(const AnimationStatus& anim);
 
+            // keyed by the entity parenting each mesh's renderables
+            tsl::robin_map<EntityId, InstancedMesh> _instancedMeshes;
+            cgltf_data* loadSourceAsset(const SceneAsset& asset, const ResourceBuffer& rbuf, vector<ResourceBuffer>& resourceBuffers);
+            EntityId addInstancedMesh(EntityId assetId, const cgltf_mesh* mesh, int primitiveIndex, utils::Entity source, utils::Entity parent, const math::mat4f* transforms, size_t count);
+            void addGpuInstancedNodes(const SceneAsset& asset, EntityId assetId);
+            void removeInstancedMeshes(EntityId assetId);
 
+            // morph/bone animations passed as raw floats are compressed on ingestion when enabled, guarded by _animationMutex
+            bool _animationCompressionEnabled = false;
+            float _animationCompressionMaxError = 0.0f;
+            // exactly one of [morphData], [compressed] and [curves] is set
+            bool setMorphAnimationBuffer(
+                EntityId entityId,
+                const char* entityName,
+                const float* const morphData,
+                shared_ptr<const CompressedMorphTracks> compressed,
+                shared_ptr<const AnimationCurves> curves,
+                const int* const morphIndices,
+                int numMorphTargets,
+                int numFrames,
+                float frameLengthInMs);
+            // [tracks] holds SoA frames, and is null if [compressed] or [curves] is set
+            bool setBoneAnimationBuffer(
+                EntityId entity,
+                shared_ptr<const vector<float>> tracks,
+                shared_ptr<const CompressedBoneTracks> compressed,
+                shared_ptr<const AnimationCurves> curves,
+                int numFrames,
+                int numBones,
+                const char** const boneNames,
+                const char** const meshName,
+                int numMeshTargets,
+                float frameLengthInMs);
+            // called with _animationMutex held; applyBoneAnimation must follow clearBoneAnimation
+            void clearBoneAnimation(SceneAsset& asset);
+            void applyBoneAnimation(
+                SceneAsset& asset,
+                shared_ptr<const RetargetMap> retargetMap,
+                shared_ptr<const vector<float>> tracks,
+                shared_ptr<const CompressedBoneTracks> compressed,
+                shared_ptr<const AnimationCurves> curves,
+                int numFrames,
+                float frameLengthInMs);
 
+            // skeletons, the maps from each to the assets it has been applied to, and clips registered against them; guarded by _animationMutex
+            RetargetCache _retargetCache;
+            std::map<int, BoneAnimationClip> _boneClips;
+            int _nextBoneClipId = 0;
     };
 }
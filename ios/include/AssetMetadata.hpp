@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gltfio/FilamentAsset.h>
+#include <math/vec3.h>
+#include <tsl/robin_map.h>
+#include <utils/NameComponentManager.h>
+
+namespace polyvox {
+
+    struct NamedEntity {
+        std::string mName;
+        int32_t mEntity;
+    };
+
+    struct MeshMetadata {
+        std::string mName;
+        int32_t mEntity;
+        std::vector<std::string> mMorphTargetNames;
+    };
+
+    //
+    // Everything about an asset that doesn't change once it has been loaded, gathered once on load so it can be queried from any thread
+    // without waiting on the render thread. Never modified once built.
+    //
+    struct AssetMetadata {
+        std::vector<std::string> mAnimationNames;
+        std::vector<float> mAnimationDurations;
+        // one per renderable
+        std::vector<MeshMetadata> mMeshes;
+        // every joint of every skin, without duplicates
+        std::vector<std::string> mJointNames;
+        std::vector<NamedEntity> mCameras;
+        std::vector<NamedEntity> mLights;
+        // every named entity (including the above), so names can be looked up by entity
+        std::vector<NamedEntity> mEntities;
+        // the bounding box at load (in the asset's space)
+        filament::math::float3 mBoundsMin;
+        filament::math::float3 mBoundsMax;
+        // all of the above as a single JSON object, for fetching in one call
+        std::string mJson;
+
+        const MeshMetadata* findMesh(const char* name) const;
+    };
+
+    //
+    // The metadata of every loaded asset. A new table is built (sharing the metadata of every other asset) whenever an asset is added or
+    // removed and published by swapping a single pointer, so readers always see a complete table and never block the render thread.
+    //
+    struct AssetMetadataTable {
+        tsl::robin_map<int32_t, std::shared_ptr<const AssetMetadata>> mAssets;
+        // the name of every named entity in every asset; these point into the metadata above, so stay valid for as long as this table does
+        tsl::robin_map<int32_t, const char*> mEntityNames;
+
+        std::shared_ptr<const AssetMetadata> find(int32_t asset) const;
+        std::shared_ptr<AssetMetadataTable> with(int32_t asset, std::shared_ptr<const AssetMetadata> metadata) const;
+        std::shared_ptr<AssetMetadataTable> without(int32_t asset) const;
+    };
+
+    std::shared_ptr<AssetMetadata> buildAssetMetadata(
+        filament::gltfio::FilamentAsset* asset,
+        const utils::NameComponentManager& ncm);
+}
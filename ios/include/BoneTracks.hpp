@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#include <math/mat3.h>
+#include <math/mat4.h>
+#include <math/quat.h>
+#include <math/vec3.h>
+
+namespace polyvox {
+
+    //
+    // Bone animation frames are stored as structure-of-arrays: each frame holds one plane per component below,
+    // and each plane holds that component for every bone. i.e. the value for [frame, component, bone] lives at
+    //
+    //   ((frame * BoneTrack::COMPONENT_COUNT) + component) * numBones + bone
+    //
+    // This keeps every plane contiguous, so interpolating a frame is a handful of straight loops over floats
+    // that the compiler can vectorize, rather than a gather per bone.
+    //
+    namespace BoneTrack {
+        enum : size_t {
+            TX, TY, TZ,
+            RX, RY, RZ, RW,
+            SX, SY, SZ,
+            COMPONENT_COUNT
+        };
+    }
+
+    //
+    // Copies interleaved frame data (per bone: locX, locY, locZ, rotW, rotX, rotY, rotZ and, if [includesScale], scaleX, scaleY, scaleZ)
+    // into the SoA layout above. [out] must have space for numFrames * numBones * BoneTrack::COMPONENT_COUNT floats.
+    //
+    inline void interleavedToBoneTracks(const float* const in, size_t numFrames, size_t numBones, bool includesScale, float* const out) {
+        const size_t stride = includesScale ? 10 : 7;
+        for(size_t frame = 0; frame < numFrames; frame++) {
+            float* const planes = out + frame * BoneTrack::COMPONENT_COUNT * numBones;
+            for(size_t bone = 0; bone < numBones; bone++) {
+                const float* const src = in + (frame * numBones + bone) * stride;
+                planes[BoneTrack::TX * numBones + bone] = src[0];
+                planes[BoneTrack::TY * numBones + bone] = src[1];
+                planes[BoneTrack::TZ * numBones + bone] = src[2];
+                planes[BoneTrack::RW * numBones + bone] = src[3];
+                planes[BoneTrack::RX * numBones + bone] = src[4];
+                planes[BoneTrack::RY * numBones + bone] = src[5];
+                planes[BoneTrack::RZ * numBones + bone] = src[6];
+                planes[BoneTrack::SX * numBones + bone] = includesScale ? src[7] : 1.0f;
+                planes[BoneTrack::SY * numBones + bone] = includesScale ? src[8] : 1.0f;
+                planes[BoneTrack::SZ * numBones + bone] = includesScale ? src[9] : 1.0f;
+            }
+        }
+    }
+
+    //
+    // Interpolates every bone between two SoA frames, writing a single SoA frame to [out].
+    // Translation and scale are lerped. Rotations are nlerped along the shortest arc, which matches slerp closely
+    // at typical frame rates while (unlike slerp) needing no trig or branches, so the loop vectorizes.
+    //
+    inline void interpolateBoneTracks(const float* __restrict from, const float* __restrict to, float alpha, size_t numBones, float* __restrict out) {
+        if(alpha <= 0.0f || from == to) {
+            memcpy(out, from, BoneTrack::COMPONENT_COUNT * numBones * sizeof(float));
+            return;
+        }
+
+        for(size_t plane : { BoneTrack::TX, BoneTrack::TY, BoneTrack::TZ, BoneTrack::SX, BoneTrack::SY, BoneTrack::SZ }) {
+            const float* __restrict a = from + plane * numBones;
+            const float* __restrict b = to + plane * numBones;
+            float* __restrict o = out + plane * numBones;
+            for(size_t i = 0; i < numBones; i++) {
+                o[i] = a[i] + (b[i] - a[i]) * alpha;
+            }
+        }
+
+        const float* __restrict ax = from + BoneTrack::RX * numBones;
+        const float* __restrict ay = from + BoneTrack::RY * numBones;
+        const float* __restrict az = from + BoneTrack::RZ * numBones;
+        const float* __restrict aw = from + BoneTrack::RW * numBones;
+        const float* __restrict bx = to + BoneTrack::RX * numBones;
+        const float* __restrict by = to + BoneTrack::RY * numBones;
+        const float* __restrict bz = to + BoneTrack::RZ * numBones;
+        const float* __restrict bw = to + BoneTrack::RW * numBones;
+        float* __restrict ox = out + BoneTrack::RX * numBones;
+        float* __restrict oy = out + BoneTrack::RY * numBones;
+        float* __restrict oz = out + BoneTrack::RZ * numBones;
+        float* __restrict ow = out + BoneTrack::RW * numBones;
+        const float beta = 1.0f - alpha;
+        for(size_t i = 0; i < numBones; i++) {
+            const float dot = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i] + aw[i] * bw[i];
+            // q and -q are the same rotation, so flip the target onto the same hemisphere to take the shortest path
+            const float t = dot < 0.0f ? -alpha : alpha;
+            const float x = ax[i] * beta + bx[i] * t;
+            const float y = ay[i] * beta + by[i] * t;
+            const float z = az[i] * beta + bz[i] * t;
+            const float w = aw[i] * beta + bw[i] * t;
+            const float invLength = 1.0f / std::sqrt(x * x + y * y + z * z + w * w);
+            ox[i] = x * invLength;
+            oy[i] = y * invLength;
+            oz[i] = z * invLength;
+            ow[i] = w * invLength;
+        }
+    }
+
+    //
+    // Normalizes every rotation in a single SoA frame (e.g. after its components have been written independently).
+    //
+    inline void normalizeBoneRotations(float* const pose, size_t numBones) {
+        float* __restrict x = pose + BoneTrack::RX * numBones;
+        float* __restrict y = pose + BoneTrack::RY * numBones;
+        float* __restrict z = pose + BoneTrack::RZ * numBones;
+        float* __restrict w = pose + BoneTrack::RW * numBones;
+        for(size_t i = 0; i < numBones; i++) {
+            const float invLength = 1.0f / std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i] + w[i] * w[i]);
+            x[i] *= invLength;
+            y[i] *= invLength;
+            z[i] *= invLength;
+            w[i] *= invLength;
+        }
+    }
+
+    //
+    // Builds the local TRS matrix for [bone] from a single SoA frame.
+    //
+    inline filament::math::mat4f composeBoneTransform(const float* const pose, size_t numBones, size_t bone) {
+        using namespace filament::math;
+        const quatf rotation(
+            pose[BoneTrack::RW * numBones + bone],
+            pose[BoneTrack::RX * numBones + bone],
+            pose[BoneTrack::RY * numBones + bone],
+            pose[BoneTrack::RZ * numBones + bone]);
+        const mat3f r(rotation);
+        const mat3f rs(
+            r[0] * pose[BoneTrack::SX * numBones + bone],
+            r[1] * pose[BoneTrack::SY * numBones + bone],
+            r[2] * pose[BoneTrack::SZ * numBones + bone]);
+        return mat4f(rs, float3(
+            pose[BoneTrack::TX * numBones + bone],
+            pose[BoneTrack::TY * numBones + bone],
+            pose[BoneTrack::TZ * numBones + bone]));
+    }
+}
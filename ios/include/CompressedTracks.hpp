@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace polyvox {
+
+    //
+    // Compressed storage for morph/bone animation frames, decompressed on the fly when sampled.
+    //
+    // - morph weights are range-quantized to 16 bits per target;
+    // - bone rotations are stored as "smallest three" quaternions in 48 bits (the largest component is dropped and rebuilt
+    //   from the other three, each stored in 15 bits);
+    // - bone translations (and scales, if present) are range-quantized to 16 bits per component, with a range per bone and axis.
+    //
+    // Keyframe reduction optionally drops frames that can be rebuilt by interpolating their neighbours to within [maxError]
+    // (measured per component, i.e. in morph weights, quaternion components and translation/scale units).
+    // Frames are dropped from every track at once, so sampling only needs to find a single pair of keys.
+    //
+    // Tracks can also be serialized to (and deserialized from) a blob, so they can be compressed once offline
+    // and passed straight to the AssetManager. Blobs are little-endian, like every platform this plugin supports.
+    //
+
+    struct CompressedKeyframes {
+        // the number of frames in the uncompressed animation
+        uint32_t numFrames = 0;
+        float frameLengthInMs = 0;
+        // the (sorted) uncompressed frame index of each key. The first and last frames are always kept.
+        std::vector<uint32_t> keys;
+
+        //
+        // Maps a pair of uncompressed frames (and the fraction between them, as computed for the uncompressed animation) to a pair of keys.
+        //
+        void locate(int frame, int nextFrame, float alpha, uint32_t& fromKey, uint32_t& toKey, float& keyAlpha) const;
+    };
+
+    struct CompressedMorphTracks : CompressedKeyframes {
+        uint32_t numTargets = 0;
+        // per target
+        std::vector<float> minimum;
+        std::vector<float> extent;
+        // [key][target]
+        std::vector<uint16_t> weights;
+
+        //
+        // [frameData] holds [numFrames] frames of [numTargets] weights.
+        //
+        static std::shared_ptr<CompressedMorphTracks> compress(
+            const float* const frameData,
+            uint32_t numFrames,
+            uint32_t numTargets,
+            float frameLengthInMs,
+            float maxError);
+
+        //
+        // Writes the interpolated weight for every target to [out].
+        //
+        void sample(int frame, int nextFrame, float alpha, float* out) const;
+
+        //
+        // Returns the size of the serialized tracks, writing them to [out] only if [capacity] is large enough.
+        //
+        size_t serialize(uint8_t* out, size_t capacity) const;
+        static std::shared_ptr<CompressedMorphTracks> deserialize(const void* data, size_t size);
+    };
+
+    struct CompressedBoneTracks : CompressedKeyframes {
+        uint32_t numBones = 0;
+        // if false, every scale is 1 and none are stored
+        bool hasScale = false;
+        // per bone and axis ([bone * 3 + axis])
+        std::vector<float> translationMinimum;
+        std::vector<float> translationExtent;
+        std::vector<float> scaleMinimum;
+        std::vector<float> scaleExtent;
+        // [key][bone][3]
+        std::vector<uint16_t> rotations;
+        // [key][axis][bone]
+        std::vector<uint16_t> translations;
+        std::vector<uint16_t> scales;
+
+        //
+        // [frameData] holds [numFrames] SoA frames (see BoneTracks.hpp).
+        //
+        static std::shared_ptr<CompressedBoneTracks> compress(
+            const float* const frameData,
+            uint32_t numFrames,
+            uint32_t numBones,
+            bool hasScale,
+            float frameLengthInMs,
+            float maxError);
+
+        //
+        // Decodes [key] into a single SoA frame.
+        //
+        void decodeKey(uint32_t key, float* out) const;
+
+        //
+        // Writes the interpolated pose to [out] as a single SoA frame. [scratch] must have space for two SoA frames.
+        //
+        void sample(int frame, int nextFrame, float alpha, float* scratch, float* out) const;
+
+        size_t serialize(uint8_t* out, size_t capacity) const;
+        static std::shared_ptr<CompressedBoneTracks> deserialize(const void* data, size_t size);
+    };
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <filament/Engine.h>
+#include <filament/IndexBuffer.h>
+#include <filament/Material.h>
+#include <filament/MaterialInstance.h>
+#include <filament/RenderableManager.h>
+#include <filament/Scene.h>
+#include <filament/VertexBuffer.h>
+#include <math/vec4.h>
+#include <utils/Entity.h>
+
+namespace polyvox {
+
+    // the per-vertex attributes of a DynamicMesh; positions are always present, the rest are optional
+    enum DynamicMeshAttribute {
+        DYNAMIC_MESH_POSITION = 0,  // 3 floats
+        DYNAMIC_MESH_NORMAL = 1,    // 3 floats, converted to TANGENTS on upload
+        DYNAMIC_MESH_UV = 2,        // 2 floats (UV0)
+        DYNAMIC_MESH_COLOR = 3,     // 4 floats
+        DYNAMIC_MESH_CUSTOM0 = 4,   // CUSTOM0-7 each have 1-4 floats, as declared in the material
+        DYNAMIC_MESH_ATTRIBUTE_COUNT = DYNAMIC_MESH_CUSTOM0 + 8
+    };
+
+    //
+    // Procedural geometry (e.g. live sensor surfaces or trails) whose vertices and indices the caller rewrites as often as every frame.
+    //
+    // The caller writes into CPU-side slots handed out with the same single-producer/single-consumer protocol as LivePoseStream
+    // (see there), so writing and publishing never wait on the render thread. Each slot holds one block of [maxVertices] values per
+    // attribute and [maxIndices] indices; only the vertex and index counts passed to publish are used.
+    //
+    // On the render thread, the most recently published slot is uploaded by pointing VertexBuffer::setBufferAt (and
+    // IndexBuffer::setBuffer) directly at the slot's memory, into the next of a ring of [numBuffers] vertex/index buffers, so a buffer
+    // the GPU may still be reading from is never rewritten. A slot is only handed back to the producer once Filament has consumed it.
+    //
+    class DynamicMesh {
+        public:
+            static constexpr uint32_t NUM_SLOTS = 3;
+
+            struct Layout {
+                uint32_t mMaxVertices = 0;
+                uint32_t mMaxIndices = 0;
+                // the number of floats per vertex of each attribute (0 if unused); positions must have 3
+                uint8_t mComponents[DYNAMIC_MESH_ATTRIBUTE_COUNT] = {};
+            };
+
+            // takes ownership of [material]; [numBuffers] is 2 (double-buffered) or 3 (triple-buffered)
+            DynamicMesh(
+                const Layout& layout,
+                filament::RenderableManager::PrimitiveType type,
+                uint32_t numBuffers,
+                filament::Material* material,
+                filament::Engine& engine);
+
+            // waits for any uploads in flight, then destroys every Filament object created by this mesh
+            void destroy(filament::Engine& engine, filament::Scene& scene);
+
+            utils::Entity getEntity() const { return mEntity; }
+            filament::MaterialInstance* getMaterialInstance() const { return mMaterialInstance; }
+            const Layout& getLayout() const { return mLayout; }
+
+            // the values of [attribute] in [slot], or null if the mesh doesn't have it
+            float* getAttribute(uint32_t slot, DynamicMeshAttribute attribute);
+            uint32_t* getIndices(uint32_t slot) { return mSlots[slot].mIndices.data(); }
+
+            //
+            // Producer side (any single thread at a time).
+            //
+
+            uint32_t getWriteSlot() const { return mWriteSlot; }
+            // publishes the first [numVertices] vertices and [numIndices] indices of the write slot and returns the slot to write next
+            uint32_t publish(uint32_t numVertices, uint32_t numIndices);
+
+            //
+            // Consumer side (the render thread).
+            //
+
+            // uploads the most recently published slot (if any) and draws it from the next buffer in the ring
+            bool update(filament::Engine& engine, filament::Scene& scene);
+
+        private:
+            struct Slot {
+                std::vector<float> mVertices;
+                std::vector<uint32_t> mIndices;
+                // derived from the normals on the render thread, as Filament takes normals as tangent frames
+                std::vector<filament::math::short4> mTangents;
+                // written by the producer before publishing
+                uint32_t mNumVertices = 0;
+                uint32_t mNumIndices = 0;
+                // the uploads still referencing this slot; decremented by Filament once each has been consumed
+                std::atomic<int> mPendingUploads { 0 };
+            };
+
+            static uint64_t pack(uint64_t sequence, uint32_t slot) { return (sequence << 8) | slot; }
+            bool acquire();
+            void upload(Slot& slot, filament::Engine& engine, filament::Scene& scene);
+
+            const Layout mLayout;
+            const filament::RenderableManager::PrimitiveType mType;
+            // the offset of each attribute in a slot's vertices
+            size_t mOffsets[DYNAMIC_MESH_ATTRIBUTE_COUNT] = {};
+            // the vertex buffer index of each attribute (TANGENTS for normals)
+            int mBufferIndices[DYNAMIC_MESH_ATTRIBUTE_COUNT] = {};
+            std::array<Slot, NUM_SLOTS> mSlots;
+
+            utils::Entity mEntity;
+            filament::Material* mMaterial = nullptr;
+            filament::MaterialInstance* mMaterialInstance = nullptr;
+            std::vector<filament::VertexBuffer*> mVertexBuffers;
+            std::vector<filament::IndexBuffer*> mIndexBuffers;
+            uint32_t mNextBuffer = 0;
+
+            alignas(64) std::atomic<uint64_t> mPublished;
+
+            // owned by the producer
+            alignas(64) uint32_t mWriteSlot = 0;
+            uint64_t mSequence = 0;
+
+            // owned by the consumer
+            alignas(64) uint32_t mReadSlot = 1;
+            uint64_t mLastSequence = 0;
+    };
+}
@@ -27,12 +27,20 @@
 #include <math/mat3.h>
 #include <math/norm.h>
 
+#include <image/Ktx1Bundle.h>
+
 #include <fstream>
 #include <iostream>
 #include <string>
 #include <chrono>
+#include <deque>
+#include <future>
+#include <memory>
 
 #include "AssetManager.hpp"
+#include "DynamicMesh.hpp"
+#include "IblPrefilter.hpp"
+#include "ThreadPool.hpp"
 
 using namespace std;
 using namespace filament;
@@ -58,6 +66,12 @@ namespace polyvox
         FilamentViewer(const void *context, const ResourceLoaderWrapper *const resourceLoaderWrapper, void *const platform = nullptr, const char *uberArchivePath = nullptr);
         ~FilamentViewer();
 
+        ///
+        /// Configures the on-disk program binary cache used by the OpenGL backend for any FilamentViewer constructed after this call.
+        /// Pass a null [directory] to disable the cache. Cached programs are invalidated whenever the GL vendor, renderer or version changes; [driverTag] (optional) is any further identifier whose change should do the same.
+        ///
+        static void configureProgramCache(const char *directory, size_t maxSizeInBytes, const char *driverTag);
+
         void setToneMapping(ToneMapping toneMapping);
         void setBloom(float strength);
         void loadSkybox(const char *const skyboxUri);
@@ -66,6 +80,22 @@ namespace polyvox
         void loadIbl(const char *const iblUri, float intensity);
         void removeIbl();
 
+        ///
+        /// Loads a KTX skybox and/or KTX IBL (either may be null) and swaps them in together, without stalling the render thread.
+        /// The KTX files are parsed on a worker thread; the current environment stays visible until both are ready, then both are replaced on the same frame.
+        /// If [crossfadeInSecs] is greater than zero (and an IBL is being replaced), the current IBL is faded out over the first half of the crossfade
+        /// and the new IBL faded in over the second half, with the skybox swapped at the midpoint.
+        /// Environments requested while another is loading or fading are applied in order.
+        ///
+        void loadEnvironment(const char *const skyboxPath, const char *const iblPath, float intensity, float crossfadeInSecs);
+
+        ///
+        /// Loads an equirectangular HDR/EXR image as an IBL. The image is decoded on a worker thread, then prefiltered on the GPU.
+        /// Returns immediately; the current IBL (if any) is replaced on the first frame rendered after decoding completes.
+        /// If [cacheDirectory] is non-null (and exists), the decoded image is cached there, keyed by a hash of the source file.
+        ///
+        void loadIblFromEquirect(const char *const path, float intensity, const char *const cacheDirectory);
+
         void removeAsset(EntityId asset);
         void clearAssets();
 
@@ -96,6 +126,7 @@ namespace polyvox
         void moveCameraToAsset(EntityId entityId);
         void setViewFrustumCulling(bool enabled);
         void setCameraExposure(float aperture, float shutterSpeed, float sensitivity);
+        int32_t tweenCameraExposure(const float* const from, const float* const to, float durationInSecs, Easing easing);
         void setCameraPosition(float x, float y, float z);
         void setCameraRotation(float rads, float x, float y, float z);
         const math::mat4 getCameraModelMatrix();
@@ -121,6 +152,14 @@ namespace polyvox
         void clearLights();
         void setPostProcessing(bool enabled);
 
+        ///
+        /// Creates a mesh drawn with the material package at [materialPath] whose vertices and indices are written by the caller (see DynamicMesh).
+        /// [components] holds the number of floats per vertex of each DynamicMeshAttribute (0 for unused attributes).
+        /// Returns null on error.
+        ///
+        DynamicMesh *createDynamicMesh(const char *const materialPath, RenderableManager::PrimitiveType type, const int *const components, int maxVertices, int maxIndices, int numBuffers);
+        bool removeDynamicMesh(DynamicMesh *mesh);
+
 
         AssetManager *const getAssetManager()
         {
@@ -148,11 +187,74 @@ namespace polyvox
         std::mutex mtx; // mutex to ensure thread safety when removing assets
 
         vector<utils::Entity> _lights;
+        // uploaded (if anything has been published) at the start of each frame
+        vector<DynamicMesh *> _dynamicMeshes;
         Texture *_skyboxTexture = nullptr;
         Skybox *_skybox = nullptr;
         Texture *_iblTexture = nullptr;
         IndirectLight *_indirectLight = nullptr;
 
+        Texture *_iblIrradianceTexture = nullptr;
+
+        // worker thread for parsing/decoding skybox and IBL sources, created on first use
+        flutter_filament::ThreadPool *_environmentWorker = nullptr;
+        IblPrefilter *_iblPrefilter = nullptr;
+        std::future<std::unique_ptr<DecodedEquirect>> _pendingIbl;
+        float _pendingIblIntensity = 0.0f;
+        void applyPendingIbl();
+
+        struct Environment
+        {
+            Skybox *skybox = nullptr;
+            Texture *skyboxTexture = nullptr;
+            IndirectLight *indirectLight = nullptr;
+            Texture *reflections = nullptr;
+            Texture *irradiance = nullptr;
+        };
+
+        struct PendingEnvironment
+        {
+            std::future<std::unique_ptr<image::Ktx1Bundle>> skybox;
+            std::future<std::unique_ptr<image::Ktx1Bundle>> ibl;
+            float intensity = 0.0f;
+            float crossfadeInSecs = 0.0f;
+        };
+
+        struct RetiredEnvironment
+        {
+            int framesRemaining;
+            Environment environment;
+        };
+
+        struct EnvironmentFade
+        {
+            bool active = false;
+            bool swapped = false;
+            std::chrono::steady_clock::time_point start;
+            float durationInSecs = 0.0f;
+            float outgoingIntensity = 0.0f;
+            float incomingIntensity = 0.0f;
+            Environment incoming;
+            bool replaceSkybox = false;
+            bool replaceIbl = false;
+        };
+
+        // swapped-out environments are kept alive for this many frames, as they may still be referenced by frames in flight
+        static constexpr int kEnvironmentRetireFrames = 3;
+
+        std::deque<PendingEnvironment> _pendingEnvironments;
+        std::vector<RetiredEnvironment> _retiredEnvironments;
+        EnvironmentFade _environmentFade;
+
+        std::future<std::unique_ptr<image::Ktx1Bundle>> loadKtxAsync(const char *const path);
+        void updateEnvironment();
+        void beginEnvironmentSwap(Environment incoming, bool replaceSkybox, bool replaceIbl, float intensity, float crossfadeInSecs);
+        void stepEnvironmentFade();
+        void finishEnvironmentFade();
+        void swapEnvironment(Environment incoming, bool replaceSkybox, bool replaceIbl);
+        void retireEnvironment(Environment environment);
+        void destroyEnvironment(Environment &environment);
+
         bool _recomputeAabb = false;
 
         bool _actualSize = false;
@@ -188,7 +290,8 @@ namespace polyvox
         void loadTextureFromPath(string path);
        
 
-        uint32_t _lastFrameTimeInNanos;
+        uint64_t _lastFrameTimeInNanos = 0;
+        static constexpr float kMaxAnimationDeltaInSecs = 0.25f;
     };
 
 }
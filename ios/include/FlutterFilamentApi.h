@@ -53,6 +53,7 @@ typedef int32_t _ManipulatorMode;
 extern "C" {
 #endif
 
+FLUTTER_PLUGIN_EXPORT void configure_program_cache(const char* directory, size_t maxSizeInBytes, const char* driverTag);
 FLUTTER_PLUGIN_EXPORT const void* create_filament_viewer(const void* const context, const ResourceLoaderWrapper* const loader, void* const platform, const char* uberArchivePath);
 FLUTTER_PLUGIN_EXPORT void destroy_filament_viewer(const void* const viewer);
 FLUTTER_PLUGIN_EXPORT ResourceLoaderWrapper* make_resource_loader(LoadFilamentResourceFromOwner loadFn, FreeFilamentResourceFromOwner freeFn, void* owner);
@@ -66,12 +67,26 @@ FLUTTER_PLUGIN_EXPORT void set_tone_mapping(const void* const viewer, int toneMa
 FLUTTER_PLUGIN_EXPORT void set_bloom(const void* const viewer, float strength);
 FLUTTER_PLUGIN_EXPORT void load_skybox(const void* const viewer, const char *skyboxPath);
 FLUTTER_PLUGIN_EXPORT void load_ibl(const void* const viewer, const char *iblPath, float intensity);
+FLUTTER_PLUGIN_EXPORT void load_ibl_from_equirect(const void* const viewer, const char *path, float intensity, const char *cacheDirectory);
+FLUTTER_PLUGIN_EXPORT void load_environment(const void* const viewer, const char *skyboxPath, const char *iblPath, float intensity, float crossfadeInSecs);
 FLUTTER_PLUGIN_EXPORT void remove_skybox(const void* const viewer);
 FLUTTER_PLUGIN_EXPORT void remove_ibl(const void* const viewer);
 FLUTTER_PLUGIN_EXPORT EntityId add_light(const void* const viewer, uint8_t type, float colour, float intensity, float posX, float posY, float posZ, float dirX, float dirY, float dirZ, bool shadows);
 FLUTTER_PLUGIN_EXPORT void remove_light(const void* const viewer, EntityId entityId);
 FLUTTER_PLUGIN_EXPORT void clear_lights(const void* const viewer);
+// Creates a mesh whose vertices/indices are written directly into native memory and published without blocking (see DynamicMesh).
+// [primitiveType] is a RenderableManager::PrimitiveType value and [components] holds the number of floats per vertex of each of the
+// 12 DynamicMeshAttribute values (position, normal, UV, colour, custom0-7; 0 if unused). Returns null on error.
+FLUTTER_PLUGIN_EXPORT void* create_dynamic_mesh(const void* const viewer, const char* materialPath, int primitiveType, const int* const components, int maxVertices, int maxIndices, int numBuffers);
+FLUTTER_PLUGIN_EXPORT bool remove_dynamic_mesh(const void* const viewer, void* const mesh);
+FLUTTER_PLUGIN_EXPORT EntityId get_dynamic_mesh_entity(void* const mesh);
+FLUTTER_PLUGIN_EXPORT float* get_dynamic_mesh_attribute(void* const mesh, int slot, int attribute);
+FLUTTER_PLUGIN_EXPORT uint32_t* get_dynamic_mesh_indices(void* const mesh, int slot);
+FLUTTER_PLUGIN_EXPORT int get_dynamic_mesh_write_slot(void* const mesh);
+// neither copies nor blocks; returns the slot to write next
+FLUTTER_PLUGIN_EXPORT int publish_dynamic_mesh(void* const mesh, int numVertices, int numIndices);
 FLUTTER_PLUGIN_EXPORT EntityId load_glb(void *assetManager, const char *assetPath, bool unlit);
+FLUTTER_PLUGIN_EXPORT bool add_material_specialization(void *assetManager, const char *packagePath, uint32_t features);
 FLUTTER_PLUGIN_EXPORT EntityId load_gltf(void *assetManager, const char *assetPath, const char *relativePath);
 FLUTTER_PLUGIN_EXPORT bool set_camera(const void* const viewer, EntityId asset, const char *nodeName);
 FLUTTER_PLUGIN_EXPORT void set_view_frustum_culling(const void* const viewer, bool enabled);
@@ -125,14 +140,147 @@ FLUTTER_PLUGIN_EXPORT void set_bone_animation(
                             const char** const meshName,
                             int numMeshTargets,
                             float frameLengthInMs);
-FLUTTER_PLUGIN_EXPORT void play_animation(void* assetManager, EntityId asset, int index, bool loop, bool reverse, bool replaceActive, float crossfade);
-FLUTTER_PLUGIN_EXPORT void set_animation_frame(void* assetManager, EntityId asset, int animationIndex, int animationFrame);
+// as above, but each bone in [frameData] also carries scaleX, scaleY, scaleZ (i.e. 10 floats per bone per frame)
+FLUTTER_PLUGIN_EXPORT bool set_bone_animation_trs(
+                            void* assetManager,
+                            EntityId asset, 
+                            const float* const frameData,
+                            int numFrames, 
+                            int numBones,
+                            const char** const boneNames,
+                            const char** const meshName,
+                            int numMeshTargets,
+                            float frameLengthInMs);
+// Enables compression of the frame data passed to set_morph_animation/set_bone_animation/set_bone_animation_trs (see CompressedTracks.hpp).
+// Frames that can be interpolated from their neighbours to within [maxError] are dropped (pass 0 to keep every frame).
+FLUTTER_PLUGIN_EXPORT void set_animation_compression(void* assetManager, bool enabled, float maxError);
+// Compress frame data (in the same format as set_morph_animation/set_bone_animation_trs) into a blob for the set_*_compressed functions below.
+// Returns the size of the blob; it is only written to [out] if [capacity] is at least this size (so pass NULL first to query the size).
+FLUTTER_PLUGIN_EXPORT size_t compress_morph_animation(
+                            const float *const morphData,
+                            int numMorphTargets,
+                            int numFrames,
+                            float frameLengthInMs,
+                            float maxError,
+                            uint8_t* out,
+                            size_t capacity);
+FLUTTER_PLUGIN_EXPORT size_t compress_bone_animation(
+                            const float* const frameData,
+                            int numFrames,
+                            int numBones,
+                            bool includesScale,
+                            float frameLengthInMs,
+                            float maxError,
+                            uint8_t* out,
+                            size_t capacity);
+FLUTTER_PLUGIN_EXPORT bool set_morph_animation_compressed(
+                            void* assetManager,
+                            EntityId asset,
+                            const char *const entityName,
+                            const void* const data,
+                            size_t size,
+                            const int* const morphIndices,
+                            int numMorphTargets);
+FLUTTER_PLUGIN_EXPORT bool set_bone_animation_compressed(
+                            void* assetManager,
+                            EntityId asset,
+                            const void* const data,
+                            size_t size,
+                            int numBones,
+                            const char** const boneNames,
+                            const char** const meshName,
+                            int numMeshTargets);
+// Animates morph targets/bones with keyframed curves that are evaluated natively every frame (rather than dense per-frame data).
+// [interpolations] (0 = step, 1 = linear, 2 = cubic Hermite) and [keyCounts] hold one entry per curve;
+// [keys] holds every curve's keys in turn, as 4 floats per key (time in seconds, value, in tangent, out tangent).
+// For morph animations, curve i animates the morph target at morphIndices[i].
+// For bone animations, curve i animates channels[i] = bone * 10 + component,
+// where components are (translation x, y, z, rotation x, y, z, w, scale x, y, z) relative to the bone's rest transform.
+FLUTTER_PLUGIN_EXPORT bool set_morph_animation_curves(
+                            void* assetManager,
+                            EntityId asset,
+                            const char *const entityName,
+                            const int* const morphIndices,
+                            const int* const interpolations,
+                            const int* const keyCounts,
+                            const float* const keys,
+                            int numCurves);
+FLUTTER_PLUGIN_EXPORT bool set_bone_animation_curves(
+                            void* assetManager,
+                            EntityId asset,
+                            const char** const boneNames,
+                            int numBones,
+                            const char** const meshName,
+                            int numMeshTargets,
+                            const int* const channels,
+                            const int* const interpolations,
+                            const int* const keyCounts,
+                            const float* const keys,
+                            int numCurves);
+// Registers a source skeleton, so bone names are matched against each asset once (rather than every time an animation is set).
+// [restPose] is optional, and holds the local rest transform of each bone in the source rig (10 floats per bone, as per set_bone_animation_trs).
+// If given, clip frames are the source rig's local transforms and are retargeted relative to both rest poses; otherwise they are relative to the asset's rest pose.
+FLUTTER_PLUGIN_EXPORT int create_skeleton(void* assetManager, const char** const boneNames, int numBones, const float* const restPose);
+FLUTTER_PLUGIN_EXPORT bool remove_skeleton(void* assetManager, int skeleton);
+// [frameData] holds 10 floats per skeleton bone per frame (as per set_bone_animation_trs); the returned clip can be set on any asset by handle.
+FLUTTER_PLUGIN_EXPORT int create_bone_animation_clip(void* assetManager, int skeleton, const float* const frameData, int numFrames, float frameLengthInMs);
+FLUTTER_PLUGIN_EXPORT bool remove_bone_animation_clip(void* assetManager, int clip);
+FLUTTER_PLUGIN_EXPORT bool set_bone_animation_clip(void* assetManager, EntityId asset, int clip);
+FLUTTER_PLUGIN_EXPORT void play_animation(void* assetManager, EntityId asset, int index, bool loop, bool reverse, bool replaceActive, float crossfade, float startOffset);
+FLUTTER_PLUGIN_EXPORT bool seek_animation(void* assetManager, EntityId asset, int animationIndex, float timeInSecs);
+FLUTTER_PLUGIN_EXPORT bool set_animation_frame(void* assetManager, EntityId asset, int animationIndex, int animationFrame, float framesPerSecond);
 FLUTTER_PLUGIN_EXPORT void stop_animation(void* assetManager, EntityId asset, int index);
+FLUTTER_PLUGIN_EXPORT void set_animation_time_scale(void* assetManager, float timeScale);
+FLUTTER_PLUGIN_EXPORT bool set_asset_animation_time_scale(void* assetManager, EntityId asset, float timeScale);
+FLUTTER_PLUGIN_EXPORT void set_animations_paused(void* assetManager, bool paused);
+FLUTTER_PLUGIN_EXPORT bool set_asset_animations_paused(void* assetManager, EntityId asset, bool paused);
+FLUTTER_PLUGIN_EXPORT void set_fixed_animation_timestep(void* assetManager, float timestepInSecs);
+FLUTTER_PLUGIN_EXPORT void set_animation_lod(void* assetManager, bool enabled, float halfRateScreenSize, float quarterRateScreenSize);
+FLUTTER_PLUGIN_EXPORT void set_animation_baking(void* assetManager, bool enabled, float sampleRate);
+FLUTTER_PLUGIN_EXPORT int add_animation_layer(void* assetManager, EntityId asset, int index, float weight, bool additive, bool loop);
+FLUTTER_PLUGIN_EXPORT bool remove_animation_layer(void* assetManager, EntityId asset, int layer);
+FLUTTER_PLUGIN_EXPORT bool set_animation_layer_weight(void* assetManager, EntityId asset, int layer, float weight);
+FLUTTER_PLUGIN_EXPORT bool set_animation_layer_time(void* assetManager, EntityId asset, int layer, float timeInSecs);
+FLUTTER_PLUGIN_EXPORT bool set_animation_layer_speed(void* assetManager, EntityId asset, int layer, float speed);
+FLUTTER_PLUGIN_EXPORT bool set_animation_layer_mask(void* assetManager, EntityId asset, int layer, const char** const jointNames, const float* const weights, int count, bool includeDescendants);
+FLUTTER_PLUGIN_EXPORT void get_skin_update_stats(void* assetManager, uint64_t* updated, uint64_t* skipped, bool reset);
+FLUTTER_PLUGIN_EXPORT int32_t tween_property(void* assetManager, EntityId entity, int property, const float* const from, const float* const to, float durationInSecs, int easing);
+FLUTTER_PLUGIN_EXPORT int32_t tween_material_color(void* assetManager, EntityId asset, const char* meshName, int materialIndex, const float* const from, const float* const to, float durationInSecs, int easing);
+FLUTTER_PLUGIN_EXPORT bool cancel_tween(void* assetManager, int32_t tween);
+FLUTTER_PLUGIN_EXPORT void set_tween_callback(void* assetManager, void (*callback)(int32_t tween, bool finished));
+FLUTTER_PLUGIN_EXPORT void* create_live_pose_stream(void* assetManager, EntityId asset, const char* meshName, const char** const boneNames, int numBones);
+FLUTTER_PLUGIN_EXPORT bool remove_live_pose_stream(void* assetManager, EntityId asset);
+FLUTTER_PLUGIN_EXPORT void get_live_pose_stream_layout(void* const stream, int* numMorphWeights, int* numBones);
+FLUTTER_PLUGIN_EXPORT float* get_live_pose_stream_slot(void* const stream, int slot);
+FLUTTER_PLUGIN_EXPORT int get_live_pose_stream_write_slot(void* const stream);
+FLUTTER_PLUGIN_EXPORT int publish_live_pose(void* const stream);
+FLUTTER_PLUGIN_EXPORT EntityId get_joint_handle(void* assetManager, EntityId asset, const char* jointName);
+FLUTTER_PLUGIN_EXPORT int add_two_bone_ik_constraint(void* assetManager, EntityId asset, EntityId upperJoint, EntityId lowerJoint, EntityId endJoint, float weight);
+FLUTTER_PLUGIN_EXPORT int add_chain_ik_constraint(void* assetManager, EntityId asset, const EntityId* const joints, int numJoints, bool fabrik, int iterations, float weight);
+FLUTTER_PLUGIN_EXPORT int add_look_at_constraint(void* assetManager, EntityId asset, EntityId joint, float forwardX, float forwardY, float forwardZ, float maxAngle, float weight);
+FLUTTER_PLUGIN_EXPORT bool set_constraint_target(void* assetManager, EntityId asset, int constraint, float x, float y, float z);
+FLUTTER_PLUGIN_EXPORT bool set_constraint_target_entity(void* assetManager, EntityId asset, int constraint, EntityId target);
+FLUTTER_PLUGIN_EXPORT bool set_constraint_pole(void* assetManager, EntityId asset, int constraint, float x, float y, float z);
+FLUTTER_PLUGIN_EXPORT bool set_constraint_weight(void* assetManager, EntityId asset, int constraint, float weight);
+FLUTTER_PLUGIN_EXPORT bool remove_constraint(void* assetManager, EntityId asset, int constraint);
+// mode is 0 (bind pose), 1 (per animation) or 2 (per frame); see AnimatedBoundsMode
+FLUTTER_PLUGIN_EXPORT bool set_animated_bounds(void* assetManager, EntityId asset, int mode, float padding);
+FLUTTER_PLUGIN_EXPORT int add_animation_state_parameter(void* assetManager, EntityId asset, const char* name, float value);
+FLUTTER_PLUGIN_EXPORT int add_animation_state(void* assetManager, EntityId asset, const char* name, const int* const clipIndices, const float* const thresholds, int numClips, int blendParameter, float speed, bool loop);
+// fromState is -1 for any state; ops are 0 (greater), 1 (less), 2 (equal), 3 (not equal) or 4 (trigger); see TransitionConditionOp
+FLUTTER_PLUGIN_EXPORT int add_animation_state_transition(void* assetManager, EntityId asset, int fromState, int toState, float crossfadeInSecs, float exitTime, const int* const parameters, const int* const ops, const float* const values, int numConditions);
+FLUTTER_PLUGIN_EXPORT bool set_animation_state_parameter(void* assetManager, EntityId asset, int parameter, float value);
+FLUTTER_PLUGIN_EXPORT bool set_animation_state(void* assetManager, EntityId asset, int state, float crossfadeInSecs);
+FLUTTER_PLUGIN_EXPORT int get_animation_state(void* assetManager, EntityId asset);
+FLUTTER_PLUGIN_EXPORT bool remove_animation_state_machine(void* assetManager, EntityId asset);
 FLUTTER_PLUGIN_EXPORT int get_animation_count(void* assetManager, EntityId asset);
 FLUTTER_PLUGIN_EXPORT void get_animation_name(void* assetManager, EntityId asset, char *const outPtr, int index);
 FLUTTER_PLUGIN_EXPORT float get_animation_duration(void* assetManager, EntityId asset, int index);
 FLUTTER_PLUGIN_EXPORT void get_morph_target_name(void* assetManager, EntityId asset, const char *meshName, char *const outPtr, int index);
 FLUTTER_PLUGIN_EXPORT int get_morph_target_name_count(void* assetManager, EntityId asset, const char *meshName);
+// Writes the metadata of [asset] (see AssetMetadata) to [outPtr] as a null-terminated JSON object if [capacity] is large enough, and returns its
+// length (or -1 if the asset isn't loaded). Like the animation and morph target queries above, this can be called from any thread.
+FLUTTER_PLUGIN_EXPORT int get_asset_metadata(void* assetManager, EntityId asset, char* const outPtr, int capacity);
 FLUTTER_PLUGIN_EXPORT void remove_asset(const void* const viewer, EntityId asset);
 FLUTTER_PLUGIN_EXPORT void clear_assets(const void* const viewer);
 FLUTTER_PLUGIN_EXPORT bool set_material_color(void* assetManager, EntityId asset, const char* meshName, int materialIndex, const float r, const float g, const float b, const float a);
@@ -145,6 +293,7 @@ FLUTTER_PLUGIN_EXPORT void set_scale(void* assetManager, EntityId asset, float s
 FLUTTER_PLUGIN_EXPORT void move_camera_to_asset(const void* const viewer, EntityId asset);
 FLUTTER_PLUGIN_EXPORT void set_view_frustum_culling(const void* const viewer, bool enabled);
 FLUTTER_PLUGIN_EXPORT void set_camera_exposure(const void* const viewer, float aperture, float shutterSpeed, float sensitivity);
+FLUTTER_PLUGIN_EXPORT int32_t tween_camera_exposure(const void* const viewer, const float* const from, const float* const to, float durationInSecs, int easing);
 FLUTTER_PLUGIN_EXPORT void set_camera_position(const void* const viewer, float x, float y, float z);
 FLUTTER_PLUGIN_EXPORT void get_camera_position(const void* const viewer);
 FLUTTER_PLUGIN_EXPORT void set_camera_rotation(const void* const viewer, float rads, float x, float y, float z);
@@ -162,6 +311,11 @@ FLUTTER_PLUGIN_EXPORT void set_camera_manipulator_options(const void* const view
 
 FLUTTER_PLUGIN_EXPORT int hide_mesh(void* assetManager, EntityId asset, const char* meshName);
 FLUTTER_PLUGIN_EXPORT int reveal_mesh(void* assetManager, EntityId asset, const char* meshName);
+// Draws [count] copies of [meshName] with hardware instancing (see AssetManager::createInstancedMesh). [transforms] holds 16 floats (a column-major
+// matrix relative to the asset's root) per copy. Returns the entity parenting the copies, or 0 on error.
+FLUTTER_PLUGIN_EXPORT EntityId create_instanced_mesh(void* assetManager, EntityId asset, const char* meshName, int primitiveIndex, const float* const transforms, int count);
+FLUTTER_PLUGIN_EXPORT bool set_instance_transforms(void* assetManager, EntityId instancedMesh, const float* const transforms, int offset, int count);
+FLUTTER_PLUGIN_EXPORT bool remove_instanced_mesh(void* assetManager, EntityId instancedMesh);
 FLUTTER_PLUGIN_EXPORT void set_post_processing(void* const viewer, bool enabled);
 FLUTTER_PLUGIN_EXPORT void pick(void* const viewer, int x, int y, EntityId* entityId);
 FLUTTER_PLUGIN_EXPORT const char* get_name_for_entity(void* const assetManager, const EntityId entityId);
@@ -33,12 +33,17 @@ FLUTTER_PLUGIN_EXPORT void set_tone_mapping_ffi(void* const viewer, int toneMapp
 FLUTTER_PLUGIN_EXPORT void set_bloom_ffi(void* const viewer, float strength);
 FLUTTER_PLUGIN_EXPORT void load_skybox_ffi(void* const viewer, const char *skyboxPath);
 FLUTTER_PLUGIN_EXPORT void load_ibl_ffi(void* const viewer, const char *iblPath, float intensity);
+FLUTTER_PLUGIN_EXPORT void load_ibl_from_equirect_ffi(void* const viewer, const char *path, float intensity, const char *cacheDirectory);
+FLUTTER_PLUGIN_EXPORT void load_environment_ffi(void* const viewer, const char *skyboxPath, const char *iblPath, float intensity, float crossfadeInSecs);
 FLUTTER_PLUGIN_EXPORT void remove_skybox_ffi(void* const viewer);
 FLUTTER_PLUGIN_EXPORT void remove_ibl_ffi(void* const viewer);
 FLUTTER_PLUGIN_EXPORT EntityId add_light_ffi(void* const viewer, uint8_t type, float colour, float intensity, float posX, float posY, float posZ, float dirX, float dirY, float dirZ, bool shadows);
 FLUTTER_PLUGIN_EXPORT void remove_light_ffi(void* const viewer, EntityId entityId);
 FLUTTER_PLUGIN_EXPORT void clear_lights_ffi(void* const viewer);
+FLUTTER_PLUGIN_EXPORT void* create_dynamic_mesh_ffi(void* const viewer, const char* materialPath, int primitiveType, const int* const components, int maxVertices, int maxIndices, int numBuffers);
+FLUTTER_PLUGIN_EXPORT bool remove_dynamic_mesh_ffi(void* const viewer, void* const mesh);
 FLUTTER_PLUGIN_EXPORT EntityId load_glb_ffi(void* const assetManager, const char *assetPath, bool unlit);
+FLUTTER_PLUGIN_EXPORT bool add_material_specialization_ffi(void* const assetManager, const char *packagePath, uint32_t features);
 FLUTTER_PLUGIN_EXPORT EntityId load_gltf_ffi(void* const assetManager, const char *assetPath, const char *relativePath);
 FLUTTER_PLUGIN_EXPORT void remove_asset_ffi(void* const viewer, EntityId asset);
 FLUTTER_PLUGIN_EXPORT void clear_assets_ffi(void* const viewer);
@@ -77,8 +82,18 @@ FLUTTER_PLUGIN_EXPORT void set_bone_animation_ffi(
                                                   const char** const meshName,
                                                   int numMeshTargets,
                                                   float frameLengthInMs);
-FLUTTER_PLUGIN_EXPORT void play_animation_ffi(void* const assetManager, EntityId asset, int index, bool loop, bool reverse, bool replaceActive, float crossfade);
-FLUTTER_PLUGIN_EXPORT void set_animation_frame_ffi(void* const assetManager, EntityId asset, int animationIndex, int animationFrame);
+FLUTTER_PLUGIN_EXPORT bool set_bone_animation_trs_ffi(
+                                                  void* const assetManager,
+                                                  EntityId asset,
+                                                  const float* const frameData,
+                                                  int numFrames,
+                                                  int numBones,
+                                                  const char** const boneNames,
+                                                  const char** const meshName,
+                                                  int numMeshTargets,
+                                                  float frameLengthInMs);
+FLUTTER_PLUGIN_EXPORT void play_animation_ffi(void* const assetManager, EntityId asset, int index, bool loop, bool reverse, bool replaceActive, float crossfade, float startOffset);
+FLUTTER_PLUGIN_EXPORT void set_animation_frame_ffi(void* const assetManager, EntityId asset, int animationIndex, int animationFrame, float framesPerSecond);
 FLUTTER_PLUGIN_EXPORT void stop_animation_ffi(void* const assetManager, EntityId asset, int index);
 FLUTTER_PLUGIN_EXPORT int get_animation_count_ffi(void* const assetManager, EntityId asset);
 FLUTTER_PLUGIN_EXPORT void get_animation_name_ffi(void* const assetManager, EntityId asset, char *const outPtr, int index);
@@ -86,6 +101,9 @@ FLUTTER_PLUGIN_EXPORT void get_morph_target_name_ffi(void* const assetManager, E
 FLUTTER_PLUGIN_EXPORT int get_morph_target_name_count_ffi(void* const assetManager, EntityId asset, const char *meshName);
 FLUTTER_PLUGIN_EXPORT void set_post_processing_ffi(void* const viewer, bool enabled);
 FLUTTER_PLUGIN_EXPORT void pick_ffi(void* const viewer, int x, int y, EntityId* entityId);
+FLUTTER_PLUGIN_EXPORT EntityId create_instanced_mesh_ffi(void* const assetManager, EntityId asset, const char* meshName, int primitiveIndex, const float* const transforms, int count);
+FLUTTER_PLUGIN_EXPORT bool set_instance_transforms_ffi(void* const assetManager, EntityId instancedMesh, const float* const transforms, int offset, int count);
+FLUTTER_PLUGIN_EXPORT bool remove_instanced_mesh_ffi(void* const assetManager, EntityId instancedMesh);
 FLUTTER_PLUGIN_EXPORT void ios_dummy_ffi();
 
 #ifdef __cplusplus
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <filament/Engine.h>
+#include <filament/Texture.h>
+
+class IBLPrefilterContext;
+
+namespace polyvox {
+
+    //
+    // A decoded equirectangular environment map, resampled to 2:1 and stored as RGB half floats (3 uint16_t per texel).
+    //
+    struct DecodedEquirect {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint16_t> texels;
+    };
+
+    //
+    // Converts HDR/EXR equirectangular images into IBL textures.
+    //
+    // This is split in two so that nothing slow happens on the render thread:
+    // - decode() (worker thread) decodes and resamples the source image. This is the expensive part on the CPU, so the
+    //   result is cached on disk under a hash of the source bytes, making subsequent loads of the same image a single file read.
+    // - prefilter() (render thread) uploads the result and runs the GPU prefilters from libfilament-iblprefilter to produce
+    //   the specular reflections cubemap and the irradiance cubemap.
+    //
+    class IblPrefilter {
+        public:
+            IblPrefilter(filament::Engine* engine);
+            ~IblPrefilter();
+
+            static std::unique_ptr<DecodedEquirect> decode(
+                const void* const data,
+                size_t size,
+                const char* sourceName,
+                const char* cacheDirectory);
+
+            bool prefilter(const DecodedEquirect& equirect, filament::Texture** reflections, filament::Texture** irradiance);
+
+        private:
+            static std::unique_ptr<DecodedEquirect> readCache(const std::string& path);
+            static void writeCache(const std::string& path, const DecodedEquirect& equirect);
+
+            filament::Engine* _engine;
+            // created on first use, as this compiles several materials
+            IBLPrefilterContext* _context = nullptr;
+    };
+}
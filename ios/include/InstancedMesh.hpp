@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vector>
+
+#include <filament/Box.h>
+#include <filament/Engine.h>
+#include <filament/IndexBuffer.h>
+#include <filament/InstanceBuffer.h>
+#include <filament/MaterialInstance.h>
+#include <filament/RenderableManager.h>
+#include <filament/Scene.h>
+#include <filament/VertexBuffer.h>
+#include <math/mat4.h>
+#include <utils/Entity.h>
+
+struct cgltf_data;
+struct cgltf_mesh;
+struct cgltf_node;
+
+namespace polyvox {
+
+    //
+    // A glTF primitive uploaded again (with only the vertex attributes its material uses) so it can be drawn with hardware instancing.
+    //
+    struct InstancedPrimitive {
+        filament::VertexBuffer* mVertexBuffer = nullptr;
+        filament::IndexBuffer* mIndexBuffer = nullptr;
+        filament::RenderableManager::PrimitiveType mType = filament::RenderableManager::PrimitiveType::TRIANGLES;
+        // owned by the asset the primitive was taken from
+        filament::MaterialInstance* mMaterialInstance = nullptr;
+    };
+
+    //
+    // Many copies of a mesh drawn with hardware instancing, each with its own transform.
+    // Filament limits the instances of a renderable with an InstanceBuffer to Engine::getMaxAutomaticInstances, so the copies are
+    // split across as few renderables as that allows (i.e. one draw call per primitive per renderable, rather than per copy).
+    //
+    struct InstancedMesh {
+        // the asset whose materials are used (and so must be removed along with it)
+        int32_t mAsset = 0;
+        // the parent of every renderable; instance transforms are relative to this
+        utils::Entity mRoot;
+        std::vector<utils::Entity> mRenderables;
+        std::vector<filament::InstanceBuffer*> mInstanceBuffers;
+        std::vector<InstancedPrimitive> mPrimitives;
+        // the bounds of a single copy
+        filament::Box mBox;
+        bool mCastShadows = true;
+        bool mReceiveShadows = true;
+        size_t mInstancesPerRenderable = 1;
+        std::vector<filament::math::mat4f> mTransforms;
+    };
+
+    //
+    // Uploads primitive [primitiveIndex] of [mesh] (or every primitive if -1) into [out], using the materials of [source] (the renderable
+    // gltfio created for the mesh). Returns false (having created nothing) if a primitive can't be instanced.
+    //
+    bool createInstancedPrimitives(
+        InstancedMesh& out,
+        const cgltf_mesh* mesh,
+        int primitiveIndex,
+        filament::RenderableManager::Instance source,
+        filament::Engine& engine);
+
+    //
+    // Creates [count] instances of the primitives in [mesh] with [transforms] (relative to [mesh].mRoot, which must have a transform
+    // component), and adds them to [scene].
+    //
+    void createInstancedRenderables(
+        InstancedMesh& mesh,
+        const filament::math::mat4f* transforms,
+        size_t count,
+        filament::Engine& engine,
+        filament::Scene& scene);
+
+    //
+    // Replaces the transforms of instances [offset, offset + count) and updates the bounds of the renderables drawing them.
+    //
+    void setInstanceTransforms(
+        InstancedMesh& mesh,
+        const filament::math::mat4f* transforms,
+        size_t offset,
+        size_t count,
+        filament::Engine& engine);
+
+    void destroyInstancedMesh(InstancedMesh& mesh, filament::Engine& engine, filament::Scene& scene);
+
+    //
+    // Reads the instance transforms (relative to [node]) from the EXT_mesh_gpu_instancing extension of [node].
+    // Returns false if [node] doesn't use the extension (or it can't be read).
+    //
+    bool readMeshGpuInstancing(const cgltf_data* data, const cgltf_node* node, std::vector<filament::math::mat4f>& out);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <filament/TransformManager.h>
+#include <math/mat4.h>
+#include <math/quat.h>
+#include <math/vec3.h>
+
+namespace polyvox {
+
+    enum class JointConstraintType : int {
+        // [upper, lower, end]; solved analytically, optionally bending towards a pole
+        TWO_BONE_IK = 0,
+        // [root, ..., end] solved with cyclic coordinate descent
+        CCD_IK = 1,
+        // [root, ..., end] solved with forward and backward reaching inverse kinematics
+        FABRIK_IK = 2,
+        // [joint]; turns the joint's forward axis towards the target, by no more than the maximum angle
+        LOOK_AT = 3
+    };
+
+    //
+    // A constraint applied to a set of joints after animations have been sampled (see AssetManager::updateAnimations).
+    // Targets and poles are in world space.
+    //
+    struct JointConstraint {
+        int mId = -1;
+        JointConstraintType mType;
+        // 0 leaves the animated pose untouched, 1 applies the full solution
+        float mWeight = 1.0f;
+        std::vector<filament::TransformManager::Instance> mJoints;
+        filament::math::float3 mTarget;
+        // if valid, mTarget follows the world position of this instance every frame
+        filament::TransformManager::Instance mTargetInstance;
+        filament::math::float3 mPole;
+        bool mHasPole = false;
+        // LOOK_AT only: the axis (in the joint's local space) turned towards the target, and the largest rotation (in radians) applied
+        filament::math::float3 mForward = { 0.0f, 0.0f, 1.0f };
+        float mMaxAngle = 3.14159265f;
+        // CCD/FABRIK only
+        int mIterations = 10;
+        float mTolerance = 0.001f;
+
+        // the local transform of each joint before and after the last solve, so a joint the animations haven't rewritten since
+        // can be restored first (otherwise solutions would accumulate from frame to frame)
+        std::vector<filament::math::mat4f> mUnconstrained;
+        std::vector<filament::math::mat4f> mConstrained;
+        // reusable scratch buffers for chain solvers
+        std::vector<filament::math::float3> mPositions;
+        std::vector<float> mLengths;
+    };
+
+    //
+    // Solves [constraint] against the current pose in [tm], writing the local transform of each constrained joint.
+    // Joints are rotated in place (their local translations and scales are untouched), and the result is blended with the
+    // unconstrained pose by the constraint's weight.
+    //
+    void solveJointConstraint(filament::TransformManager& tm, JointConstraint& constraint);
+}
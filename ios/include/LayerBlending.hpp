@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <math/quat.h>
+
+#include "BoneTracks.hpp"
+
+namespace polyvox {
+
+    //
+    // Blends a layer's pose over an accumulated pose. Both are single SoA frames (see BoneTracks.hpp):
+    // [pose] holds every node in the asset, while [layer] only holds the nodes listed in [nodes] (indices into [pose]).
+    // [weights] holds the effective weight (layer weight multiplied by the joint mask) of each node in [layer].
+    //
+    // Override layers move the accumulated pose towards the layer pose by the weight (i.e. a weight of 1 replaces it).
+    // Additive layers apply the difference between the layer pose and [reference] (typically the first frame of the layer's clip),
+    // scaled by the weight, on top of the accumulated pose.
+    //
+
+    inline filament::math::quatf getBoneRotation(const float* const pose, size_t numNodes, size_t node) {
+        return filament::math::quatf(
+            pose[BoneTrack::RW * numNodes + node],
+            pose[BoneTrack::RX * numNodes + node],
+            pose[BoneTrack::RY * numNodes + node],
+            pose[BoneTrack::RZ * numNodes + node]);
+    }
+
+    inline void setBoneRotation(float* const pose, size_t numNodes, size_t node, const filament::math::quatf& q) {
+        pose[BoneTrack::RX * numNodes + node] = q.x;
+        pose[BoneTrack::RY * numNodes + node] = q.y;
+        pose[BoneTrack::RZ * numNodes + node] = q.z;
+        pose[BoneTrack::RW * numNodes + node] = q.w;
+    }
+
+    // normalized lerp along the shortest arc, as per interpolateBoneTracks
+    inline filament::math::quatf nlerpShortest(const filament::math::quatf& a, const filament::math::quatf& b, float t) {
+        const float sign = dot(a, b) < 0.0f ? -1.0f : 1.0f;
+        return normalize(a * (1.0f - t) + b * (t * sign));
+    }
+
+    inline void blendLayerOverride(float* const pose, size_t numPoseNodes,
+                                   const float* const layer, const uint32_t* const nodes, size_t numLayerNodes,
+                                   const float* const weights) {
+        for(size_t i = 0; i < numLayerNodes; i++) {
+            const float w = weights[i];
+            if(w <= 0.0f) {
+                continue;
+            }
+            const size_t node = nodes[i];
+            for(size_t plane : { BoneTrack::TX, BoneTrack::TY, BoneTrack::TZ, BoneTrack::SX, BoneTrack::SY, BoneTrack::SZ }) {
+                float& p = pose[plane * numPoseNodes + node];
+                p += (layer[plane * numLayerNodes + i] - p) * w;
+            }
+            setBoneRotation(pose, numPoseNodes, node, nlerpShortest(
+                getBoneRotation(pose, numPoseNodes, node),
+                getBoneRotation(layer, numLayerNodes, i), w));
+        }
+    }
+
+    inline void blendLayerAdditive(float* const pose, size_t numPoseNodes,
+                                   const float* const layer, const float* const reference, const uint32_t* const nodes, size_t numLayerNodes,
+                                   const float* const weights) {
+        using namespace filament::math;
+        for(size_t i = 0; i < numLayerNodes; i++) {
+            const float w = weights[i];
+            if(w <= 0.0f) {
+                continue;
+            }
+            const size_t node = nodes[i];
+            for(size_t plane : { BoneTrack::TX, BoneTrack::TY, BoneTrack::TZ }) {
+                pose[plane * numPoseNodes + node] += (layer[plane * numLayerNodes + i] - reference[plane * numLayerNodes + i]) * w;
+            }
+            for(size_t plane : { BoneTrack::SX, BoneTrack::SY, BoneTrack::SZ }) {
+                const float r = reference[plane * numLayerNodes + i];
+                if(r != 0.0f) {
+                    pose[plane * numPoseNodes + node] *= 1.0f + (layer[plane * numLayerNodes + i] / r - 1.0f) * w;
+                }
+            }
+            const quatf delta = inverse(getBoneRotation(reference, numLayerNodes, i)) * getBoneRotation(layer, numLayerNodes, i);
+            setBoneRotation(pose, numPoseNodes, node, normalize(
+                getBoneRotation(pose, numPoseNodes, node) * nlerpShortest(quatf(1.0f, 0.0f, 0.0f, 0.0f), delta, w)));
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace polyvox {
+
+    //
+    // A single-producer/single-consumer channel for streaming live poses (e.g. lip-sync weights or mocap joints) to an asset
+    // without copying, locking or allocating per update.
+    //
+    // The stream owns NUM_SLOTS pose slots. At any time the producer owns one slot (which it writes directly, e.g. through a typed-data view
+    // from Dart), the consumer (the render thread) owns another, and the remaining slot holds the most recently published pose.
+    // Publishing swaps the producer's slot with the published one, and acquiring swaps the consumer's slot with it if it is newer,
+    // each with a single atomic operation on a sequence counter packed with the slot index.
+    //
+    // Each slot holds [numMorphWeights] morph target weights followed by a single SoA bone pose for [numBones] bones (see BoneTracks.hpp).
+    // Slots are recycled rather than cleared, so the producer must write every value it cares about before each publish.
+    //
+    class LivePoseStream {
+        public:
+            static constexpr uint32_t NUM_SLOTS = 3;
+
+            LivePoseStream(uint32_t numMorphWeights, uint32_t numBones);
+
+            uint32_t getNumMorphWeights() const { return mNumMorphWeights; }
+            uint32_t getNumBones() const { return mNumBones; }
+            // the number of floats in each slot
+            size_t getSlotSize() const { return mSlotSize; }
+
+            float* getSlot(uint32_t slot) {
+                return mSlots.data() + slot * mSlotStride;
+            }
+
+            //
+            // Producer side (any single thread at a time).
+            //
+
+            // the slot the producer may write until it next calls publish
+            uint32_t getWriteSlot() const { return mWriteSlot; }
+            // publishes the write slot and returns the slot to write next
+            uint32_t publish();
+
+            //
+            // Consumer side (the render thread).
+            //
+
+            // takes ownership of the most recently published pose, returning false if nothing has been published since the last call
+            bool acquire();
+            // the pose most recently acquired (initially every weight is zero and every bone is at its identity transform)
+            const float* getReadSlot() const { return mSlots.data() + mReadSlot * mSlotStride; }
+            // true if at least one pose has been acquired
+            bool hasPose() const { return mLastSequence > 0; }
+
+        private:
+            static uint64_t pack(uint64_t sequence, uint32_t slot) { return (sequence << 8) | slot; }
+
+            const uint32_t mNumMorphWeights;
+            const uint32_t mNumBones;
+            const size_t mSlotSize;
+            // each slot starts on its own cache line
+            const size_t mSlotStride;
+            std::vector<float> mSlots;
+
+            // the published slot and its sequence number (incremented by each publish)
+            alignas(64) std::atomic<uint64_t> mPublished;
+
+            // owned by the producer
+            alignas(64) uint32_t mWriteSlot = 0;
+            uint64_t mSequence = 0;
+
+            // owned by the consumer
+            alignas(64) uint32_t mReadSlot = 1;
+            uint64_t mLastSequence = 0;
+    };
+}
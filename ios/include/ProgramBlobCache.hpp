@@ -0,0 +1,67 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+#include <backend/Platform.h>
+
+namespace polyvox {
+
+    //
+    // A persistent, size-bounded, directory-backed store for compiled shader program binaries.
+    // This is attached to a filament::backend::Platform via setBlobFunc, so the OpenGL backend
+    // can skip recompiling programs that have already been compiled on a previous launch.
+    //
+    // Keys supplied by the backend already encode the material and variant; we additionally
+    // namespace all entries under a hash of the driver identity (the GL vendor, renderer and version strings,
+    // the material version and an optional caller-provided driver tag). The GL strings can only be read with a
+    // context current, so the namespace is opened on the first blob callback (which the backend makes on its
+    // driver thread). Namespaces that don't match the current driver identity are deleted at that point,
+    // so a GPU or driver update invalidates the entire cache.
+    //
+    // Only used with the OpenGL backend (i.e. not on iOS/macOS).
+    //
+    class ProgramBlobCache {
+        public:
+            ProgramBlobCache(const char* directory, size_t maxSizeInBytes, const char* driverTag);
+
+            //
+            // Sets the insert/retrieve callbacks on [platform]. This cache must outlive the platform.
+            // No-op if the platform already has blob callbacks.
+            //
+            void attach(filament::backend::Platform* platform);
+
+            void insert(const void* key, size_t keySize, const void* value, size_t valueSize);
+            size_t retrieve(const void* key, size_t keySize, void* value, size_t valueSize);
+
+            bool isValid() const noexcept { return _valid; }
+
+        private:
+            // called with _mutex held on the driver thread; returns false if the namespace couldn't be opened
+            bool open();
+
+            struct Entry {
+                size_t size = 0;
+                uint64_t lastUse = 0;
+            };
+
+            std::string pathForHash(uint64_t hash) const;
+            void evict();
+
+            std::mutex _mutex;
+            std::string _root;
+            std::string _driverTag;
+            bool _opened = false;
+            bool _ready = false;
+            // the namespace directory under _root
+            std::string _directory;
+            size_t _maxSizeInBytes;
+            size_t _currentSizeInBytes = 0;
+            uint64_t _useCounter = 0;
+            bool _valid = false;
+            std::unordered_map<uint64_t, Entry> _entries;
+    };
+}
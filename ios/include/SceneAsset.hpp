@@ -1,6 +1,14 @@
 #pragma once
 
 #include "Log.hpp"
+#include "AnimationClipCache.hpp"
+#include "CompressedTracks.hpp"
+#include "AnimationCurves.hpp"
+#include "LivePoseStream.hpp"
+#include "JointConstraints.hpp"
+#include "SkeletonRetargeting.hpp"
+#include "AnimatedBounds.hpp"
+#include "AnimationStateMachine.hpp"
 
 #include <filament/Engine.h>
 #include <filament/RenderableManager.h>
@@ -19,6 +27,9 @@
 #include <gltfio/ResourceLoader.h>
 #include <utils/NameComponentManager.h>
 
+#include <memory>
+#include <string>
+
 extern "C" {
     #include "FlutterFilamentApi.h"
 }
@@ -29,19 +40,40 @@ namespace polyvox {
     using namespace utils;
     using namespace std;
 
-    typedef std::chrono::time_point<std::chrono::high_resolution_clock> time_point_t;   
-
     enum AnimationType {
         MORPH, BONE, GLTF
     };
 
     struct AnimationStatus {
-        time_point_t mStart = time_point_t::max();
+        // playback position in seconds, advanced by the (scaled) frame delta in AssetManager::updateAnimations
+        float mTime = 0.0f;
         bool mLoop = false;
         bool mReverse = false;
         float mDuration = 0;  
         AnimationType type;
         int gltfIndex = -1;
+        // index into SceneAsset::mMorphAnimationBuffers (MORPH animations only)
+        int morphBufferIndex = -1;
+        // the frames to sample (and the fraction between them) this frame, for MORPH/BONE animations
+        int mFrame = 0;
+        int mNextFrame = 0;
+        float mAlpha = 0.0f;
+        // the value of mTime when this animation was last applied, so unchanged poses can be skipped
+        float mLastAppliedTime = -1.0f;
+        // true if this glTF animation was created by seeking rather than played; its time only changes when seeked again and it never completes
+        bool mHeld = false;
+        // the time requested by the most recent seek (if >= 0), applied instead of advancing mTime the next time animations are updated
+        float mSeekTime = -1.0f;
+        // true if this glTF animation should be baked (on the render thread) the next time animations are updated
+        bool mBake = false;
+        // set if this glTF animation plays from a pre-sampled table rather than via the Animator (see AnimationClipCache)
+        shared_ptr<const BakedClip> mBakedClip;
+        // the TransformManager instance for each node in mBakedClip->nodes
+        vector<TransformManager::Instance> mBakedInstances;
+        // reusable scratch buffers for the two decoded frames, the interpolated pose and the resulting local transforms
+        vector<float> mBakedFrames;
+        vector<float> mBakedPose;
+        vector<math::mat4f> mBakedTransforms;
     };
 
     // 
@@ -49,28 +81,130 @@ namespace polyvox {
     //
     struct MorphAnimationBuffer {
         utils::Entity mMeshTarget;
+        // resolved once when the buffer is set, rather than every frame
+        RenderableManager::Instance mRenderableInstance;
         int mNumFrames = -1;
         float mFrameLengthInMs = 0;
+        // either the raw weights ([frame][target]), compressed tracks or curves (in which case mFrameData is empty)
         vector<float> mFrameData;
+        shared_ptr<const CompressedMorphTracks> mCompressed;
+        // one curve per entry in mMorphIndices
+        shared_ptr<const AnimationCurves> mCurves;
+        vector<uint32_t> mCurveCursors;
+        // reusable scratch buffer for the weights decompressed from mCompressed or evaluated from mCurves
+        vector<float> mDecompressed;
         vector<int> mMorphIndices;
+        // the weights of morph targets [mMinMorphIndex, mMinMorphIndex + mWeights.size()) are sampled into mWeights, but only the animated
+        // targets are written: one call per run of consecutive indices in mMorphIndices (each an offset into mWeights and a count), so
+        // targets in between keep any weights set directly.
+        int mMinMorphIndex = 0;
+        vector<std::pair<int, int>> mWeightRuns;
+        // reusable scratch buffer for the interpolated weights
+        vector<float> mWeights;
     };
 
     // 
     // Use this to construct a dynamic (i.e. non-glTF embedded) bone animation.
     // Only a single animation is supported at any time (i.e you can't blend animations).
-    // Multiple bones are supported but these must be skinned to a single mesh target.
+    // Bones may belong to any skin in the asset.
     //
     struct BoneAnimationBuffer {
         vector<utils::Entity> mMeshTargets;
-        vector<uint8_t> mBones;
-        vector<math::mat4f> mBaseTransforms;
-        // vector<math::float3> mBaseTranslations; // these are the base transforms for the bones we will animate; the translations/rotations in mFrameData will be relative to this.
-        // vector<math::quatf> mBaseRotations; // these are the base transforms for the bones we will animate; the translations/rotations in mFrameData will be relative to this.
-        // vector<math::float3> mBaseScales; // these are the base transforms for the bones we will animate; the translations/rotations in mFrameData will be relative to this.
-        size_t skinIndex = 0;
+        // the joint for each bone and the transform each bone's TRS is applied relative to; shared by every buffer set with the same
+        // skeleton on the same asset (see RetargetCache)
+        shared_ptr<const RetargetMap> mRetargetMap;
         int mNumFrames = -1;
         float mFrameLengthInMs = 0;
-        vector<float> mFrameData;
+        // SoA frame data (see BoneTracks.hpp), compressed tracks or curves (in which case mFrameData is null)
+        shared_ptr<const vector<float>> mFrameData;
+        shared_ptr<const CompressedBoneTracks> mCompressed;
+        // each curve writes a single component of a single bone in the SoA pose
+        shared_ptr<const AnimationCurves> mCurves;
+        vector<uint32_t> mCurveCursors;
+        // reusable scratch buffer for the two keys decompressed from mCompressed
+        vector<float> mDecompressed;
+        // reusable scratch buffer for the interpolated pose (a single SoA frame)
+        vector<float> mPose;
+        // the sampled local transform for each joint, written in parallel and committed to the TransformManager on the render thread
+        vector<math::mat4f> mTransforms;
+    };
+
+    //
+    // Bone animation data registered once against a Skeleton, which can then be set on any asset with matching joints by handle.
+    //
+    struct BoneAnimationClip {
+        int mSkeleton = -1;
+        int mNumFrames = 0;
+        float mFrameLengthInMs = 0;
+        // exactly one is set
+        shared_ptr<const vector<float>> mFrameData;
+        shared_ptr<const CompressedBoneTracks> mCompressed;
+    };
+
+    //
+    // A glTF animation blended with any others playing in the same AnimationLayerStack.
+    // Layers play from baked clips (see AnimationClipCache), so the pose of each can be sampled without touching the TransformManager.
+    //
+    struct AnimationLayer {
+        // stable handle returned by AssetManager::addAnimationLayer
+        int mId = -1;
+        int mClipIndex = -1;
+        float mWeight = 1.0f;
+        float mTime = 0.0f;
+        float mSpeed = 1.0f;
+        bool mLoop = true;
+        bool mAdditive = false;
+        // true until the clip has been baked on the render thread
+        bool mBake = true;
+        float mLastAppliedTime = -1.0f;
+        shared_ptr<const BakedClip> mClip;
+        // per node in the asset (i.e. FilamentAsset::getEntities()); empty if every node is included at full weight
+        vector<float> mMask;
+        int mFrame = 0;
+        int mNextFrame = 0;
+        float mAlpha = 0.0f;
+        // reusable scratch buffers: two decoded frames, the interpolated pose and the effective weight of each node in mClip
+        vector<float> mFrames;
+        vector<float> mPose;
+        vector<float> mWeights;
+        // the first frame of the clip, which additive layers are applied relative to
+        vector<float> mReference;
+    };
+
+    struct AnimationLayerStack {
+        // blended in order, so later layers override (or add to) earlier ones
+        vector<AnimationLayer> mLayers;
+        int mNextLayerId = 0;
+        // set when a layer is added, removed or changed, so the blend is re-evaluated even if no layer time has changed
+        bool mDirty = false;
+        // the local transform of every node in the asset when it was loaded (decomposed into mRestPose when the first layer is baked);
+        // layers are blended over this unless a glTF or bone animation is playing, in which case they're blended over its pose
+        vector<math::mat4f> mRestTransforms;
+        vector<TransformManager::Instance> mInstances;
+        vector<float> mRestPose;
+        // reusable scratch buffer for the blended pose of every node
+        vector<float> mPose;
+        // the nodes written by the last blend (and so must be restored to their rest transform once no layer affects them)
+        vector<uint8_t> mTouched;
+        size_t mNumTouched = 0;
+
+        bool isActive() const {
+            return !mLayers.empty() || mNumTouched > 0;
+        }
+    };
+
+    //
+    // Applies the poses published to a LivePoseStream to a single mesh (morph weights) and/or a set of joints.
+    //
+    struct LivePoseTarget {
+        shared_ptr<LivePoseStream> mStream;
+        // invalid if the stream has no morph weights
+        RenderableManager::Instance mMorphInstance;
+        vector<TransformManager::Instance> mJointInstances;
+        // the local transform of each joint when the stream was created; like bone animations, the streamed TRS is applied relative to this
+        vector<math::mat4f> mBaseTransforms;
+        // reusable scratch buffer
+        vector<math::mat4f> mTransforms;
     };
 
     struct SceneAsset {
@@ -78,6 +212,26 @@ namespace polyvox {
         FilamentAsset* mAsset = nullptr;
         Animator* mAnimator = nullptr;
 
+        // the path this asset was loaded from; assets sharing a path share baked animations
+        std::string mUri;
+        // the directory the resources of a .gltf were loaded from (empty for a .glb)
+        std::string mResourcePath;
+
+        // true if this asset was loaded via the unlit material provider (and so must be destroyed by the unlit asset loader).
+        bool mUnlit = false;
+
+        // multiplied with the global time scale to advance this asset's animations
+        float mTimeScale = 1.0f;
+        bool mPaused = false;
+        // true if any animation has a pending seek, which is applied even while this asset (or every animation) is paused
+        bool mSeekPending = false;
+
+        // true if every renderable in this asset has been removed from the scene via AssetManager::hide
+        bool mHidden = false;
+
+        // set each frame by the animation LOD policy; if false, animation time still advances but nothing is sampled or applied
+        bool mEvaluateAnimations = true;
+
         // vector containing AnimationStatus structs for the morph, bone and/or glTF animations.
         vector<AnimationStatus> mAnimations;
         
@@ -87,9 +241,26 @@ namespace polyvox {
         float fadeDuration = 0.0f;
         float fadeOutAnimationStart = 0.0f;
 
-        MorphAnimationBuffer mMorphAnimationBuffer;
+        // one buffer per mesh target
+        vector<MorphAnimationBuffer> mMorphAnimationBuffers;
         BoneAnimationBuffer mBoneAnimationBuffer;
 
+        AnimationLayerStack mLayerStack;
+
+        // plays its states via the layer stack; null until a state or parameter is added
+        shared_ptr<AnimationStateMachine> mStateMachine;
+
+        LivePoseTarget mLivePose;
+
+        // the bounding boxes of skinned renderables, updated after every other animation step
+        AnimatedBounds mBounds;
+
+        // solved in order after animations, layers and live poses have been applied
+        vector<JointConstraint> mConstraints;
+        int mNextConstraintId = 0;
+        // set when a constraint is added or changed, so it is solved on the next frame even if nothing is animating
+        bool mConstraintsDirty = false;
+
         // a slot to preload textures
         filament::Texture* mTexture = nullptr;
 
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <filament/TransformManager.h>
+#include <gltfio/FilamentInstance.h>
+#include <math/mat4.h>
+#include <utils/Entity.h>
+#include <utils/NameComponentManager.h>
+
+namespace polyvox {
+
+    //
+    // The bones of a source skeleton (e.g. the rig a set of animations was authored or captured on), registered once and referred to by handle.
+    //
+    struct Skeleton {
+        std::vector<std::string> mBoneNames;
+        // the local rest transform of each bone in the source rig; empty if animation data is already relative to the target's rest pose
+        std::vector<filament::math::mat4f> mRestTransforms;
+    };
+
+    //
+    // Maps the bones of a Skeleton onto the joints of a single asset.
+    //
+    struct RetargetMap {
+        // one per source bone; invalid where the asset has no joint of that name, in which case the bone is ignored
+        std::vector<filament::TransformManager::Instance> mJointInstances;
+        // the local transform of each joint when the map was built, restored when an animation using this map is replaced
+        std::vector<filament::math::mat4f> mRestTransforms;
+        // pre-multiplied with each sampled bone transform: the target rest transform, times the inverse of the source rest transform
+        // if the skeleton has one (so a source pose equal to its rest pose puts the joint at the target's rest pose)
+        std::vector<filament::math::mat4f> mCorrections;
+        size_t mNumMapped = 0;
+    };
+
+    //
+    // Owns registered skeletons and the RetargetMaps built for them, so joint names are matched once per (skeleton, asset) pair
+    // rather than every time an animation is set.
+    //
+    class RetargetCache {
+        public:
+            //
+            // Registers a skeleton and returns its handle. [restPose] (if not null) holds each bone's local rest transform as
+            // 10 floats (translation x, y, z, rotation x, y, z, w, scale x, y, z).
+            //
+            int addSkeleton(const char** const boneNames, int numBones, const float* const restPose);
+
+            //
+            // Releases [skeleton] and every map built for it. Animations already using one of those maps keep it alive until they are replaced.
+            //
+            bool removeSkeleton(int skeleton);
+
+            const Skeleton* getSkeleton(int skeleton) const;
+
+            //
+            // Returns the map from [skeleton] to the joints of [instance] (identified by [key]), building it on first use.
+            // The rest transforms are captured from the joints' current local transforms when the map is built.
+            //
+            std::shared_ptr<const RetargetMap> getOrBuild(
+                int skeleton,
+                int32_t key,
+                filament::gltfio::FilamentInstance* instance,
+                const utils::NameComponentManager& ncm,
+                filament::TransformManager& transformManager);
+
+            //
+            // Releases every map built for the asset identified by [key].
+            //
+            void removeTarget(int32_t key);
+
+            //
+            // Builds an uncached map from [skeleton] to the joints of [instance]. Returns null (after logging the first missing bone)
+            // if [requireAll] is true and any bone has no matching joint.
+            //
+            static std::shared_ptr<RetargetMap> build(
+                const Skeleton& skeleton,
+                filament::gltfio::FilamentInstance* instance,
+                const utils::NameComponentManager& ncm,
+                filament::TransformManager& transformManager,
+                bool requireAll);
+
+            //
+            // Finds the joint named by each of [names] in any skin of [instance] with a single pass over the joints, writing a null entity
+            // for any name with no match. Where a name is shared by several joints, the first (in skin order) is used.
+            //
+            static void findJoints(
+                filament::gltfio::FilamentInstance* instance,
+                const utils::NameComponentManager& ncm,
+                const char* const* names,
+                size_t numNames,
+                utils::Entity* out);
+
+        private:
+            int _nextSkeletonId = 0;
+            std::map<int, Skeleton> _skeletons;
+            std::map<std::pair<int, int32_t>, std::shared_ptr<const RetargetMap>> _maps;
+    };
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include <filament/MaterialInstance.h>
+#include <math/vec4.h>
+
+typedef int32_t EntityId;
+
+namespace polyvox {
+
+    enum class TweenProperty : int {
+        // an asset's position (x, y, z)
+        POSITION = 0,
+        // an asset's rotation, as a quaternion (x, y, z, w); interpolated along the shortest arc
+        ROTATION = 1,
+        // an asset's (uniform) scale
+        SCALE = 2,
+        // the baseColorFactor (r, g, b, a, in sRGB) of a single material instance
+        BASE_COLOR_FACTOR = 3,
+        // a light's intensity
+        LIGHT_INTENSITY = 4,
+        // a camera's exposure (aperture, shutter speed, sensitivity)
+        CAMERA_EXPOSURE = 5
+    };
+
+    enum class Easing : int {
+        LINEAR = 0,
+        EASE_IN_QUAD = 1,
+        EASE_OUT_QUAD = 2,
+        EASE_IN_OUT_QUAD = 3,
+        EASE_IN_CUBIC = 4,
+        EASE_OUT_CUBIC = 5,
+        EASE_IN_OUT_CUBIC = 6,
+        EASE_IN_OUT_SINE = 7
+    };
+
+    //
+    // Called when a tween ends, with [finished] false if it was cancelled (or its target was removed) first: on the render thread,
+    // or on the thread that cancelled (or replaced) the tween. No AssetManager lock is held, so it may start or cancel tweens itself.
+    //
+    typedef void (*TweenCallback)(int32_t tweenId, bool finished);
+
+    struct Tween {
+        int32_t mId;
+        TweenProperty mProperty;
+        Easing mEasing;
+        // the asset, light or camera entity being tweened
+        EntityId mEntity;
+        // BASE_COLOR_FACTOR only (owned by the asset mEntity, so only used while that asset exists)
+        filament::MaterialInstance* mMaterialInstance = nullptr;
+        // unused components are ignored
+        filament::math::float4 mFrom;
+        filament::math::float4 mTo;
+        float mDuration;
+        float mElapsed = 0.0f;
+    };
+
+    inline float applyEasing(Easing easing, float t) {
+        switch(easing) {
+            case Easing::LINEAR:
+                return t;
+            case Easing::EASE_IN_QUAD:
+                return t * t;
+            case Easing::EASE_OUT_QUAD:
+                return t * (2.0f - t);
+            case Easing::EASE_IN_OUT_QUAD:
+                return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+            case Easing::EASE_IN_CUBIC:
+                return t * t * t;
+            case Easing::EASE_OUT_CUBIC: {
+                const float u = t - 1.0f;
+                return u * u * u + 1.0f;
+            }
+            case Easing::EASE_IN_OUT_CUBIC: {
+                if(t < 0.5f) {
+                    return 4.0f * t * t * t;
+                }
+                const float u = 2.0f * t - 2.0f;
+                return 0.5f * u * u * u + 1.0f;
+            }
+            case Easing::EASE_IN_OUT_SINE:
+                return 0.5f - 0.5f * std::cos(t * 3.14159265f);
+        }
+        return t;
+    }
+}
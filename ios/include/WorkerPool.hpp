@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace polyvox {
+
+    //
+    // A fixed set of worker threads for splitting a per-frame loop across cores (see AssetManager::sampleAnimations).
+    //
+    // Unlike flutter_filament::ThreadPool, workers block on a condition variable until there's work (so an idle pool costs nothing),
+    // and running a loop allocates nothing: the calling thread publishes the loop body, every thread (the caller included) claims
+    // indices from a shared atomic counter until none are left, and the caller then waits for each worker to check back in.
+    //
+    class WorkerPool {
+        public:
+            explicit WorkerPool(size_t numWorkers);
+            ~WorkerPool();
+
+            WorkerPool(const WorkerPool&) = delete;
+            WorkerPool& operator=(const WorkerPool&) = delete;
+
+            size_t getNumWorkers() const { return mWorkers.size(); }
+
+            //
+            // Calls [body](i) for every i in [0, count) across the workers and the calling thread, returning once every call has.
+            // Only one thread may run a loop at a time.
+            //
+            template<typename Body>
+            void run(size_t count, Body& body) {
+                run(count, [](void* context, size_t index) { (*static_cast<Body*>(context))(index); }, &body);
+            }
+
+        private:
+            typedef void (*Job)(void* context, size_t index);
+
+            void run(size_t count, Job job, void* context);
+            void work();
+            void claim();
+
+            std::vector<std::thread> mWorkers;
+            std::mutex mMutex;
+            std::condition_variable mWake;
+            std::condition_variable mDone;
+            // the loop being run, guarded by mMutex; mGeneration is incremented each time a new loop is published
+            Job mJob = nullptr;
+            void* mContext = nullptr;
+            size_t mCount = 0;
+            uint64_t mGeneration = 0;
+            // the workers that haven't yet finished the current loop
+            size_t mNumBusy = 0;
+            bool mStop = false;
+
+            alignas(64) std::atomic<size_t> mNext { 0 };
+    };
+}
@@ -0,0 +1,259 @@
+#ifndef SPECIALIZED_MATERIAL_PROVIDER
+#define SPECIALIZED_MATERIAL_PROVIDER
+
+#include <cstdint>
+#include <vector>
+
+#include <filament/Engine.h>
+#include <filament/Material.h>
+#include <filament/MaterialInstance.h>
+#include <filament/Texture.h>
+#include <filament/TextureSampler.h>
+#include <gltfio/MaterialProvider.h>
+#include <math/mat3.h>
+
+#include <tsl/robin_map.h>
+
+#include "Log.hpp"
+
+namespace polyvox {
+
+  using namespace filament;
+  using namespace filament::gltfio;
+
+  //
+  // Bits describing the shader features of a glTF material (i.e. the parts of a MaterialKey that affect
+  // which shader is needed, ignoring UV set indices which are passed as material parameters).
+  //
+  namespace MaterialFeature {
+  enum : uint32_t {
+    DOUBLE_SIDED = 1 << 0,
+    UNLIT = 1 << 1,
+    VERTEX_COLORS = 1 << 2,
+    BASE_COLOR_TEXTURE = 1 << 3,
+    NORMAL_TEXTURE = 1 << 4,
+    OCCLUSION_TEXTURE = 1 << 5,
+    EMISSIVE_TEXTURE = 1 << 6,
+    SPECULAR_GLOSSINESS = 1 << 7,
+    METALLIC_ROUGHNESS_TEXTURE = 1 << 8,
+    CLEAR_COAT = 1 << 9,
+    CLEAR_COAT_TEXTURES = 1 << 10,
+    TRANSMISSION = 1 << 11,
+    TRANSMISSION_TEXTURE = 1 << 12,
+    SHEEN = 1 << 13,
+    SHEEN_TEXTURES = 1 << 14,
+    VOLUME = 1 << 15,
+    VOLUME_TEXTURE = 1 << 16,
+    IOR = 1 << 17,
+    TEXTURE_TRANSFORMS = 1 << 18,
+    // bits 24-25 hold the AlphaMode (OPAQUE = 0, MASK = 1, BLEND = 2)
+    ALPHA_MODE_SHIFT = 24
+  };
+  }
+
+  //
+  // A MaterialProvider that serves pre-built, specialized material packages for specific feature combinations
+  // (e.g. "opaque, base color texture only"), falling back to the ubershader provider for anything else.
+  //
+  // Packages must be compiled from the gltfio material template (see materials/) so they expose the same
+  // parameters as the ubershader. Each package is only built into a Material the first time an asset needs it,
+  // and the Material is shared by every asset loaded afterwards.
+  //
+  class SpecializedMaterialProvider : public MaterialProvider {
+
+      struct Specialization {
+        std::vector<uint8_t> package;
+        Material* material = nullptr;
+      };
+
+      Engine* const _engine;
+      MaterialProvider* const _fallback;
+      tsl::robin_map<uint32_t, Specialization> _specializations;
+      std::vector<const Material*> _materials;
+      Texture* _dummyTexture = nullptr;
+
+      Material* findOrBuild(uint32_t features) {
+        auto pos = _specializations.find(features);
+        if(pos == _specializations.end()) {
+          return nullptr;
+        }
+        auto& specialization = pos.value();
+        if(!specialization.material) {
+          specialization.material = Material::Builder()
+            .package(specialization.package.data(), specialization.package.size())
+            .build(*_engine);
+          if(!specialization.material) {
+            Log("Failed to build specialized material for features %x, falling back to ubershader", features);
+            _specializations.erase(pos);
+            return nullptr;
+          }
+          // the package is no longer needed once the material has been built
+          std::vector<uint8_t>().swap(specialization.package);
+          _materials.push_back(specialization.material);
+        }
+        return specialization.material;
+      }
+
+      Texture* getDummyTexture() {
+        if(!_dummyTexture) {
+          static const uint8_t texels[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+          _dummyTexture = Texture::Builder()
+            .width(1).height(1)
+            .format(Texture::InternalFormat::RGBA8)
+            .build(*_engine);
+          Texture::PixelBufferDescriptor pbd(texels, sizeof(texels), Texture::Format::RGBA, Texture::Type::UBYTE);
+          _dummyTexture->setImage(*_engine, 0, std::move(pbd));
+        }
+        return _dummyTexture;
+      }
+
+      void setIndex(MaterialInstance* instance, const char* name, int index) {
+        if(instance->getMaterial()->hasParameter(name)) {
+          instance->setParameter(name, index);
+        }
+      }
+
+      void setIdentity(MaterialInstance* instance, const char* name) {
+        if(instance->getMaterial()->hasParameter(name)) {
+          instance->setParameter(name, math::mat3f());
+        }
+      }
+
+      void setDummySampler(MaterialInstance* instance, const char* name) {
+        if(instance->getMaterial()->hasParameter(name)) {
+          instance->setParameter(name, getDummyTexture(), TextureSampler());
+        }
+      }
+
+      public:
+        SpecializedMaterialProvider(Engine* engine, MaterialProvider* fallback) : _engine(engine), _fallback(fallback) {}
+
+        //
+        // Registers a specialized material package for the given MaterialFeature bitmask. The package is copied.
+        // Registering the same feature bitmask twice replaces the package, unless it has already been built.
+        //
+        bool addSpecialization(uint32_t features, const void* const data, size_t size) {
+          auto& specialization = _specializations[features];
+          if(specialization.material) {
+            Log("Specialization for features %x is already in use and cannot be replaced", features);
+            return false;
+          }
+          specialization.package.assign((const uint8_t*)data, (const uint8_t*)data + size);
+          return true;
+        }
+
+        static uint32_t getFeatures(const MaterialKey& config) {
+          uint32_t features = 0;
+          if(config.doubleSided) features |= MaterialFeature::DOUBLE_SIDED;
+          if(config.unlit) features |= MaterialFeature::UNLIT;
+          if(config.hasVertexColors) features |= MaterialFeature::VERTEX_COLORS;
+          if(config.hasBaseColorTexture) features |= MaterialFeature::BASE_COLOR_TEXTURE;
+          if(config.hasNormalTexture) features |= MaterialFeature::NORMAL_TEXTURE;
+          if(config.hasOcclusionTexture) features |= MaterialFeature::OCCLUSION_TEXTURE;
+          if(config.hasEmissiveTexture) features |= MaterialFeature::EMISSIVE_TEXTURE;
+          if(config.useSpecularGlossiness) features |= MaterialFeature::SPECULAR_GLOSSINESS;
+          if(config.hasMetallicRoughnessTexture) features |= MaterialFeature::METALLIC_ROUGHNESS_TEXTURE;
+          if(config.hasClearCoat) features |= MaterialFeature::CLEAR_COAT;
+          if(config.hasClearCoatTexture || config.hasClearCoatRoughnessTexture || config.hasClearCoatNormalTexture) features |= MaterialFeature::CLEAR_COAT_TEXTURES;
+          if(config.hasTransmission) features |= MaterialFeature::TRANSMISSION;
+          if(config.hasTransmissionTexture) features |= MaterialFeature::TRANSMISSION_TEXTURE;
+          if(config.hasSheen) features |= MaterialFeature::SHEEN;
+          if(config.hasSheenColorTexture || config.hasSheenRoughnessTexture) features |= MaterialFeature::SHEEN_TEXTURES;
+          if(config.hasVolume) features |= MaterialFeature::VOLUME;
+          if(config.hasVolumeThicknessTexture) features |= MaterialFeature::VOLUME_TEXTURE;
+          if(config.hasIOR) features |= MaterialFeature::IOR;
+          if(config.hasTextureTransforms) features |= MaterialFeature::TEXTURE_TRANSFORMS;
+          features |= (uint32_t(config.alphaMode) & 0x3) << MaterialFeature::ALPHA_MODE_SHIFT;
+          return features;
+        }
+
+        filament::MaterialInstance* createMaterialInstance(MaterialKey* config, UvMap* uvmap,
+                const char* label = "material", const char* extras = nullptr) {
+          if(_specializations.empty()) {
+            return _fallback->createMaterialInstance(config, uvmap, label, extras);
+          }
+
+          MaterialKey constrained = *config;
+          UvMap constrainedUvmap = *uvmap;
+          constrainMaterial(&constrained, &constrainedUvmap);
+
+          auto material = findOrBuild(getFeatures(constrained));
+          if(!material) {
+            return _fallback->createMaterialInstance(config, uvmap, label, extras);
+          }
+          *config = constrained;
+          *uvmap = constrainedUvmap;
+
+          auto getUvIndex = [uvmap](uint8_t srcIndex, bool hasTexture) -> int {
+            return hasTexture ? int(uvmap->at(srcIndex)) - 1 : -1;
+          };
+
+          auto instance = material->createInstance(label);
+          instance->setDoubleSided(config->doubleSided);
+          instance->setCullingMode(config->doubleSided ? MaterialInstance::CullingMode::NONE : MaterialInstance::CullingMode::BACK);
+
+          setIndex(instance, "baseColorIndex", getUvIndex(config->baseColorUV, config->hasBaseColorTexture));
+          setIndex(instance, "normalIndex", getUvIndex(config->normalUV, config->hasNormalTexture));
+          setIndex(instance, "metallicRoughnessIndex", getUvIndex(config->metallicRoughnessUV, config->hasMetallicRoughnessTexture));
+          setIndex(instance, "aoIndex", getUvIndex(config->aoUV, config->hasOcclusionTexture));
+          setIndex(instance, "emissiveIndex", getUvIndex(config->emissiveUV, config->hasEmissiveTexture));
+          setIndex(instance, "clearCoatIndex", getUvIndex(config->clearCoatUV, config->hasClearCoatTexture));
+          setIndex(instance, "clearCoatRoughnessIndex", getUvIndex(config->clearCoatRoughnessUV, config->hasClearCoatRoughnessTexture));
+          setIndex(instance, "clearCoatNormalIndex", getUvIndex(config->clearCoatNormalUV, config->hasClearCoatNormalTexture));
+
+          for(auto name : { "baseColorUvMatrix", "normalUvMatrix", "metallicRoughnessUvMatrix", "occlusionUvMatrix", "emissiveUvMatrix",
+                            "clearCoatUvMatrix", "clearCoatRoughnessUvMatrix", "clearCoatNormalUvMatrix" }) {
+            setIdentity(instance, name);
+          }
+
+          // samplers must always be bound, even when the corresponding texture is absent
+          for(auto name : { "baseColorMap", "normalMap", "metallicRoughnessMap", "occlusionMap", "emissiveMap",
+                            "clearCoatMap", "clearCoatRoughnessMap", "clearCoatNormalMap" }) {
+            setDummySampler(instance, name);
+          }
+          return instance;
+        }
+
+        Material* getMaterial(MaterialKey* config, UvMap* uvmap, const char* label = "material") {
+          MaterialKey constrained = *config;
+          UvMap constrainedUvmap = *uvmap;
+          constrainMaterial(&constrained, &constrainedUvmap);
+          auto material = findOrBuild(getFeatures(constrained));
+          if(!material) {
+            return _fallback->getMaterial(config, uvmap, label);
+          }
+          *config = constrained;
+          *uvmap = constrainedUvmap;
+          return material;
+        }
+
+        //
+        // Only returns the specialized materials that have been built; ubershader materials are owned by the fallback provider.
+        //
+        const filament::Material* const* getMaterials() const noexcept {
+          return _materials.data();
+        }
+
+        size_t getMaterialsCount() const noexcept {
+          return _materials.size();
+        }
+
+        void destroyMaterials() {
+          for(auto material : _materials) {
+            _engine->destroy(material);
+          }
+          _materials.clear();
+          _specializations.clear();
+          if(_dummyTexture) {
+            _engine->destroy(_dummyTexture);
+            _dummyTexture = nullptr;
+          }
+        }
+
+        bool needsDummyData(filament::VertexAttribute attrib) const noexcept {
+          return _fallback->needsDummyData(attrib);
+        }
+  };
+}
+
+#endif
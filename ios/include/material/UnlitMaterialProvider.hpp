@@ -0,0 +1,78 @@
+#ifndef UNLIT_MATERIAL_PROVIDER
+#define UNLIT_MATERIAL_PROVIDER
+
+#include <filament/Material.h>
+#include <filament/MaterialInstance.h>
+#include <gltfio/MaterialProvider.h>
+
+namespace polyvox {
+
+  using namespace filament;
+  using namespace filament::gltfio;
+
+  //
+  // Forces every material in an asset down the unlit path of an existing (ubershader) provider.
+  // Materials are shared with (and owned by) the wrapped provider, so this never compiles or destroys anything itself.
+  //
+  // Unlit materials only sample the base color, so the only dummy attribute we need is COLOR (which the
+  // ubershader multiplies into the base color). Skipping UV/tangent dummies saves vertex memory and
+  // avoids generating tangent frames for primitives without normals.
+  //
+  class UnlitMaterialProvider : public MaterialProvider {
+
+      MaterialProvider* const _delegate;
+
+      static void makeUnlit(MaterialKey* config) {
+        config->unlit = true;
+        config->hasNormalTexture = false;
+        config->hasOcclusionTexture = false;
+        config->hasEmissiveTexture = false;
+        config->hasMetallicRoughnessTexture = false;
+        config->useSpecularGlossiness = false;
+        config->hasClearCoat = false;
+        config->hasClearCoatTexture = false;
+        config->hasClearCoatRoughnessTexture = false;
+        config->hasClearCoatNormalTexture = false;
+        config->hasTransmission = false;
+        config->hasTransmissionTexture = false;
+        config->hasSheen = false;
+        config->hasSheenColorTexture = false;
+        config->hasSheenRoughnessTexture = false;
+        config->hasVolume = false;
+        config->hasVolumeThicknessTexture = false;
+        config->hasIOR = false;
+      }
+
+      public:
+        UnlitMaterialProvider(MaterialProvider* delegate) : _delegate(delegate) {}
+
+        filament::MaterialInstance* createMaterialInstance(MaterialKey* config, UvMap* uvmap,
+                const char* label = "material", const char* extras = nullptr) {
+          makeUnlit(config);
+          return _delegate->createMaterialInstance(config, uvmap, label, extras);
+        }
+
+        Material* getMaterial(MaterialKey* config, UvMap* uvmap, const char* label = "material") {
+          makeUnlit(config);
+          return _delegate->getMaterial(config, uvmap, label);
+        }
+
+        const filament::Material* const* getMaterials() const noexcept {
+          return _delegate->getMaterials();
+        }
+
+        size_t getMaterialsCount() const noexcept {
+          return _delegate->getMaterialsCount();
+        }
+
+        void destroyMaterials() {
+          // owned by the delegate
+        }
+
+        bool needsDummyData(filament::VertexAttribute attrib) const noexcept {
+          return attrib == filament::VertexAttribute::COLOR;
+        }
+  };
+}
+
+#endif
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <filament/MaterialEnums.h>
+#include <math/mat4.h>
+#include <utils/Entity.h>
+
+#include "AnimatedBounds.hpp"
+
+namespace polyvox {
+
+using namespace filament;
+using namespace filament::math;
+using namespace filament::gltfio;
+
+bool initAnimatedBounds(AnimatedBounds& bounds, FilamentAsset* asset, RenderableManager& rm, TransformManager& tm) {
+    bounds.mRenderables.clear();
+    bounds.mRenderableTransforms.clear();
+    bounds.mBindBoxes.clear();
+    bounds.mPadding.clear();
+    bounds.mJoints.clear();
+    bounds.mClips.clear();
+
+    FilamentInstance* instance = asset->getInstance();
+    if(instance->getSkinCount() == 0) {
+        return false;
+    }
+
+    // the bind-pose position of each joint, in the space of the mesh it skins
+    std::vector<float3> bindPositions;
+    for(size_t skin = 0; skin < instance->getSkinCount(); skin++) {
+        const utils::Entity* joints = instance->getJointsAt(skin);
+        const mat4f* inverseBindMatrices = instance->getInverseBindMatricesAt(skin);
+        for(size_t i = 0; i < instance->getJointCountAt(skin); i++) {
+            const auto joint = tm.getInstance(joints[i]);
+            if(!joint) {
+                continue;
+            }
+            bindPositions.push_back(inverse(inverseBindMatrices[i])[3].xyz);
+            if(std::find(bounds.mJoints.begin(), bounds.mJoints.end(), joint) == bounds.mJoints.end()) {
+                bounds.mJoints.push_back(joint);
+            }
+        }
+    }
+    if(bounds.mJoints.empty()) {
+        return false;
+    }
+    float3 jointMin(std::numeric_limits<float>::max());
+    float3 jointMax(std::numeric_limits<float>::lowest());
+    for(const auto& position : bindPositions) {
+        jointMin = min(jointMin, position);
+        jointMax = max(jointMax, position);
+    }
+
+    const utils::Entity* renderables = asset->getRenderableEntities();
+    for(size_t i = 0; i < asset->getRenderableEntityCount(); i++) {
+        const auto renderable = rm.getInstance(renderables[i]);
+        if(!renderable || rm.getPrimitiveCount(renderable) == 0 ||
+           !rm.getEnabledAttributesAt(renderable, 0)[VertexAttribute::BONE_INDICES]) {
+            continue;
+        }
+        const Box& box = rm.getAxisAlignedBoundingBox(renderable);
+        // limbs can point in any direction once animated, so the padding is the furthest the mesh extends past its joints along any axis
+        const float3 below = jointMin - box.getMin();
+        const float3 above = box.getMax() - jointMax;
+        const float padding = std::max({ 0.0f, below.x, below.y, below.z, above.x, above.y, above.z });
+        bounds.mRenderables.push_back(renderable);
+        bounds.mRenderableTransforms.push_back(tm.getInstance(renderables[i]));
+        bounds.mBindBoxes.push_back(box);
+        bounds.mPadding.push_back(padding);
+    }
+    return !bounds.mRenderables.empty();
+}
+
+void computeJointBounds(AnimatedBounds& bounds, TransformManager& tm, std::vector<Box>& boxes, bool accumulate) {
+    auto& positions = bounds.mJointPositions;
+    positions.resize(bounds.mJoints.size());
+    for(size_t i = 0; i < bounds.mJoints.size(); i++) {
+        positions[i] = tm.getWorldTransform(bounds.mJoints[i])[3].xyz;
+    }
+
+    const size_t numRenderables = bounds.mRenderables.size();
+    boxes.resize(numRenderables);
+    for(size_t r = 0; r < numRenderables; r++) {
+        const mat4f toRenderable = bounds.mRenderableTransforms[r] ? inverse(tm.getWorldTransform(bounds.mRenderableTransforms[r])) : mat4f();
+        float3 lo(std::numeric_limits<float>::max());
+        float3 hi(std::numeric_limits<float>::lowest());
+        for(const auto& position : positions) {
+            const float3 p = (toRenderable * float4(position, 1.0f)).xyz;
+            lo = min(lo, p);
+            hi = max(hi, p);
+        }
+        lo -= bounds.mPadding[r];
+        hi += bounds.mPadding[r];
+        if(accumulate) {
+            boxes[r].unionSelf(Box().set(lo, hi));
+        } else {
+            boxes[r].set(lo, hi);
+        }
+    }
+}
+
+std::vector<Box> bakeClipBounds(
+    AnimatedBounds& bounds,
+    int clipIndex,
+    FilamentAsset* asset,
+    Animator* animator,
+    TransformManager& tm,
+    float sampleRate) {
+
+    std::vector<Box> boxes;
+    if(clipIndex < 0 || clipIndex >= (int)animator->getAnimationCount() || sampleRate <= 0) {
+        return boxes;
+    }
+
+    const utils::Entity* entities = asset->getEntities();
+    const size_t numEntities = asset->getEntityCount();
+    std::vector<TransformManager::Instance> instances(numEntities);
+    std::vector<mat4f> restTransforms(numEntities);
+    for(size_t i = 0; i < numEntities; i++) {
+        instances[i] = tm.getInstance(entities[i]);
+        if(instances[i]) {
+            restTransforms[i] = tm.getTransform(instances[i]);
+        }
+    }
+
+    // world transforms are needed for every sample, so unlike baking clips this can't be done in a local transform transaction
+    const float duration = animator->getAnimationDuration(clipIndex);
+    const uint32_t numSamples = static_cast<uint32_t>(std::ceil(duration * sampleRate)) + 1;
+    for(uint32_t sample = 0; sample < numSamples; sample++) {
+        animator->applyAnimation(clipIndex, std::min(sample / sampleRate, duration));
+        computeJointBounds(bounds, tm, boxes, sample > 0);
+    }
+
+    tm.openLocalTransformTransaction();
+    for(size_t i = 0; i < numEntities; i++) {
+        if(instances[i]) {
+            tm.setTransform(instances[i], restTransforms[i]);
+        }
+    }
+    tm.commitLocalTransformTransaction();
+    return boxes;
+}
+
+}
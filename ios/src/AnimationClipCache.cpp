@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cmath>
+
+#include <gltfio/math.h>
+#include <math/half.h>
+#include <math/mat4.h>
+#include <math/quat.h>
+#include <math/vec3.h>
+
+#include "AnimationClipCache.hpp"
+#include "BoneTracks.hpp"
+#include "Log.hpp"
+
+namespace polyvox {
+
+using namespace filament;
+using namespace filament::gltfio;
+using namespace filament::math;
+using utils::Entity;
+
+// translations and scales are stored in this order in BakedClip::translationsAndScales
+static constexpr size_t kTranslationScalePlanes[] = { BoneTrack::TX, BoneTrack::TY, BoneTrack::TZ, BoneTrack::SX, BoneTrack::SY, BoneTrack::SZ };
+static constexpr size_t kRotationPlanes[] = { BoneTrack::RX, BoneTrack::RY, BoneTrack::RZ, BoneTrack::RW };
+
+// 10 minutes at 30fps; anything longer is almost certainly a mistake
+static constexpr uint32_t kMaxBakedFrames = 18000;
+
+static int16_t toSnorm16(float value) {
+    return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+void BakedClip::decodeFrame(uint32_t frame, float* out) const {
+    const size_t numNodes = nodes.size();
+    const int16_t* r = rotations.data() + frame * 4 * numNodes;
+    for(size_t plane : kRotationPlanes) {
+        float* o = out + plane * numNodes;
+        for(size_t i = 0; i < numNodes; i++) {
+            o[i] = r[i] * (1.0f / 32767.0f);
+        }
+        r += numNodes;
+    }
+    const uint16_t* ts = translationsAndScales.data() + frame * 6 * numNodes;
+    for(size_t plane : kTranslationScalePlanes) {
+        float* o = out + plane * numNodes;
+        for(size_t i = 0; i < numNodes; i++) {
+            o[i] = float(makeHalf(ts[i]));
+        }
+        ts += numNodes;
+    }
+}
+
+std::shared_ptr<const BakedClip> AnimationClipCache::getOrBake(
+    const std::string& key,
+    int clipIndex,
+    FilamentAsset* asset,
+    Animator* animator,
+    TransformManager& transformManager,
+    float sampleRate) {
+
+    auto& clip = _clips[{ key, clipIndex }];
+    if(!clip || clip->sampleRate != sampleRate) {
+        clip = bake(clipIndex, asset, animator, transformManager, sampleRate);
+        if(!clip) {
+            _clips.erase({ key, clipIndex });
+            return nullptr;
+        }
+        Log("Baked animation %d for %s (%d frames, %d nodes, %zu bytes)", clipIndex, key.c_str(), clip->numFrames, (int)clip->nodes.size(), clip->getSizeInBytes());
+    }
+    return clip;
+}
+
+void AnimationClipCache::remove(const std::string& key) {
+    for(auto it = _clips.begin(); it != _clips.end();) {
+        if(it->first.first == key) {
+            it = _clips.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+std::shared_ptr<BakedClip> AnimationClipCache::bake(
+    int clipIndex,
+    FilamentAsset* asset,
+    Animator* animator,
+    TransformManager& transformManager,
+    float sampleRate) {
+
+    if(clipIndex < 0 || (size_t)clipIndex >= animator->getAnimationCount() || sampleRate <= 0) {
+        return nullptr;
+    }
+
+    const float duration = animator->getAnimationDuration(clipIndex);
+    const uint32_t numFrames = static_cast<uint32_t>(std::ceil(duration * sampleRate)) + 1;
+    if(numFrames > kMaxBakedFrames) {
+        Log("Animation %d is too long to bake (%d frames at %f fps)", clipIndex, numFrames, sampleRate);
+        return nullptr;
+    }
+
+    const Entity* entities = asset->getEntities();
+    const size_t numEntities = asset->getEntityCount();
+
+    std::vector<TransformManager::Instance> instances(numEntities);
+    std::vector<mat4f> restTransforms(numEntities);
+    for(size_t i = 0; i < numEntities; i++) {
+        instances[i] = transformManager.getInstance(entities[i]);
+        if(instances[i]) {
+            restTransforms[i] = transformManager.getTransform(instances[i]);
+        }
+    }
+
+    // sample every node at every frame, noting which nodes the animation moves
+    std::vector<mat4f> samples(numFrames * numEntities);
+    std::vector<bool> animated(numEntities, false);
+
+    // world transforms aren't needed while baking
+    transformManager.openLocalTransformTransaction();
+    for(uint32_t frame = 0; frame < numFrames; frame++) {
+        animator->applyAnimation(clipIndex, std::min(frame / sampleRate, duration));
+        for(size_t i = 0; i < numEntities; i++) {
+            if(!instances[i]) {
+                continue;
+            }
+            auto& sample = samples[frame * numEntities + i];
+            sample = transformManager.getTransform(instances[i]);
+            if(!animated[i] && sample != restTransforms[i]) {
+                animated[i] = true;
+            }
+        }
+    }
+    for(size_t i = 0; i < numEntities; i++) {
+        if(instances[i]) {
+            transformManager.setTransform(instances[i], restTransforms[i]);
+        }
+    }
+    transformManager.commitLocalTransformTransaction();
+
+    auto clip = std::make_shared<BakedClip>();
+    clip->sampleRate = sampleRate;
+    clip->duration = duration;
+    clip->numFrames = numFrames;
+    for(size_t i = 0; i < numEntities; i++) {
+        if(animated[i]) {
+            clip->nodes.push_back(i);
+        }
+    }
+
+    const size_t numNodes = clip->nodes.size();
+    if(numNodes == 0) {
+        Log("Animation %d doesn't move any nodes, nothing to bake", clipIndex);
+        return nullptr;
+    }
+    clip->rotations.resize(numFrames * 4 * numNodes);
+    clip->translationsAndScales.resize(numFrames * 6 * numNodes);
+
+    for(uint32_t frame = 0; frame < numFrames; frame++) {
+        int16_t* r = clip->rotations.data() + frame * 4 * numNodes;
+        uint16_t* ts = clip->translationsAndScales.data() + frame * 6 * numNodes;
+        for(size_t n = 0; n < numNodes; n++) {
+            float3 translation, scale;
+            quatf rotation;
+            decomposeMatrix(samples[frame * numEntities + clip->nodes[n]], &translation, &rotation, &scale);
+            rotation = normalize(rotation);
+            r[0 * numNodes + n] = toSnorm16(rotation.x);
+            r[1 * numNodes + n] = toSnorm16(rotation.y);
+            r[2 * numNodes + n] = toSnorm16(rotation.z);
+            r[3 * numNodes + n] = toSnorm16(rotation.w);
+            ts[0 * numNodes + n] = getBits(half(translation.x));
+            ts[1 * numNodes + n] = getBits(half(translation.y));
+            ts[2 * numNodes + n] = getBits(half(translation.z));
+            ts[3 * numNodes + n] = getBits(half(scale.x));
+            ts[4 * numNodes + n] = getBits(half(scale.y));
+            ts[5 * numNodes + n] = getBits(half(scale.z));
+        }
+    }
+    return clip;
+}
+
+}
@@ -0,0 +1,113 @@
+#include <algorithm>
+
+#include "AnimationCurves.hpp"
+#include "Log.hpp"
+
+namespace polyvox {
+
+static constexpr int kMaxCursorSteps = 4;
+
+float AnimationCurve::evaluate(float time, uint32_t& cursor) const {
+    const uint32_t numKeys = keys.size();
+    if(time <= keys.front().time) {
+        cursor = 0;
+        return keys.front().value;
+    }
+    if(time >= keys.back().time) {
+        cursor = numKeys - 1;
+        return keys.back().value;
+    }
+    // consecutive evaluations (including scrubbing back and forth) are usually within a key or two of the last,
+    // so step from the cached key in either direction and only fall back to a binary search for larger jumps
+    if(cursor >= numKeys - 1) {
+        cursor = numKeys - 2;
+    }
+    int steps = 0;
+    while(keys[cursor].time > time && steps < kMaxCursorSteps) {
+        cursor--;
+        steps++;
+    }
+    while(keys[cursor + 1].time <= time && steps < kMaxCursorSteps) {
+        cursor++;
+        steps++;
+    }
+    if(keys[cursor].time > time || keys[cursor + 1].time <= time) {
+        auto next = std::upper_bound(keys.begin(), keys.end(), time, [](float t, const CurveKey& key) { return t < key.time; });
+        cursor = static_cast<uint32_t>(next - keys.begin()) - 1;
+    }
+
+    const CurveKey& from = keys[cursor];
+    const CurveKey& to = keys[cursor + 1];
+    switch(interpolation) {
+        case CurveInterpolation::STEP:
+            return from.value;
+        case CurveInterpolation::LINEAR: {
+            const float s = (time - from.time) / (to.time - from.time);
+            return from.value + (to.value - from.value) * s;
+        }
+        case CurveInterpolation::CUBIC: {
+            const float dt = to.time - from.time;
+            const float s = (time - from.time) / dt;
+            const float s2 = s * s;
+            const float s3 = s2 * s;
+            return (2 * s3 - 3 * s2 + 1) * from.value
+                + (s3 - 2 * s2 + s) * dt * from.outTangent
+                + (-2 * s3 + 3 * s2) * to.value
+                + (s3 - s2) * dt * to.inTangent;
+        }
+    }
+    return from.value;
+}
+
+std::shared_ptr<AnimationCurves> AnimationCurves::create(
+    const int* const targets,
+    const int* const interpolations,
+    const int* const keyCounts,
+    const float* const keys,
+    int numCurves,
+    int numTargets) {
+
+    if(numCurves <= 0) {
+        Log("ERROR: an animation must contain at least one curve.");
+        return nullptr;
+    }
+    auto result = std::make_shared<AnimationCurves>();
+    result->curves.resize(numCurves);
+    const float* key = keys;
+    for(int i = 0; i < numCurves; i++) {
+        auto& curve = result->curves[i];
+        if(targets[i] < 0 || targets[i] >= numTargets) {
+            Log("ERROR: curve %d targets %d, which is out of range.", i, targets[i]);
+            return nullptr;
+        }
+        if(interpolations[i] < (int)CurveInterpolation::STEP || interpolations[i] > (int)CurveInterpolation::CUBIC) {
+            Log("ERROR: curve %d has unknown interpolation %d.", i, interpolations[i]);
+            return nullptr;
+        }
+        if(keyCounts[i] <= 0) {
+            Log("ERROR: curve %d must contain at least one key.", i);
+            return nullptr;
+        }
+        curve.target = targets[i];
+        curve.interpolation = (CurveInterpolation)interpolations[i];
+        curve.keys.resize(keyCounts[i]);
+        for(int k = 0; k < keyCounts[i]; k++, key += 4) {
+            curve.keys[k] = { key[0], key[1], key[2], key[3] };
+            // keys sharing a time are allowed (for discontinuities); evaluate never interpolates between them
+            if(k > 0 && curve.keys[k].time < curve.keys[k - 1].time) {
+                Log("ERROR: the keys in curve %d must be sorted by time.", i);
+                return nullptr;
+            }
+        }
+        result->duration = std::max(result->duration, curve.keys.back().time);
+    }
+    return result;
+}
+
+void AnimationCurves::evaluate(float time, uint32_t* cursors, float* out) const {
+    for(size_t i = 0; i < curves.size(); i++) {
+        out[curves[i].target] = curves[i].evaluate(time, cursors[i]);
+    }
+}
+
+}
@@ -0,0 +1,68 @@
+#include <algorithm>
+
+#include "AnimationStateMachine.hpp"
+
+namespace polyvox {
+
+void getMotionWeights(const AnimationState& state, const std::vector<float>& parameters, float* out) {
+    const size_t numMotions = state.mClipIndices.size();
+    std::fill(out, out + numMotions, 0.0f);
+    if(numMotions == 1 || state.mBlendParameter < 0) {
+        out[0] = 1.0f;
+        return;
+    }
+    const float value = parameters[state.mBlendParameter];
+    const auto& thresholds = state.mThresholds;
+    if(value <= thresholds.front()) {
+        out[0] = 1.0f;
+        return;
+    }
+    if(value >= thresholds.back()) {
+        out[numMotions - 1] = 1.0f;
+        return;
+    }
+    // blend the two animations either side of the value
+    const size_t upper = std::upper_bound(thresholds.begin(), thresholds.end(), value) - thresholds.begin();
+    const size_t lower = upper - 1;
+    const float range = thresholds[upper] - thresholds[lower];
+    const float alpha = range > 0.0f ? (value - thresholds[lower]) / range : 1.0f;
+    out[lower] = 1.0f - alpha;
+    out[upper] = alpha;
+}
+
+static bool holds(const TransitionCondition& condition, const std::vector<float>& parameters) {
+    const float value = parameters[condition.mParameter];
+    switch(condition.mOp) {
+        case TransitionConditionOp::GREATER:
+            return value > condition.mValue;
+        case TransitionConditionOp::LESS:
+            return value < condition.mValue;
+        case TransitionConditionOp::EQUAL:
+            return value == condition.mValue;
+        case TransitionConditionOp::NOT_EQUAL:
+            return value != condition.mValue;
+        case TransitionConditionOp::TRIGGER:
+            return value != 0.0f;
+    }
+    return false;
+}
+
+int findTransition(const AnimationStateMachine& machine) {
+    const int current = machine.mCurrent.mState;
+    for(size_t i = 0; i < machine.mTransitions.size(); i++) {
+        const auto& transition = machine.mTransitions[i];
+        if(transition.mFrom == -1 ? transition.mTo == current : transition.mFrom != current) {
+            continue;
+        }
+        if(transition.mExitTime >= 0.0f && machine.mCurrent.mNormalizedTime < transition.mExitTime) {
+            continue;
+        }
+        if(std::all_of(transition.mConditions.begin(), transition.mConditions.end(),
+                       [&](const TransitionCondition& condition) { return holds(condition, machine.mParameters); })) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+}
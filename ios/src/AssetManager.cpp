@@ -1,9 +1,13 @@
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <sstream>
 #include <thread>
 #include <vector> 
 
 #include <filament/Engine.h>
+#include <filament/Frustum.h>
+#include <filament/LightManager.h>
 #include <filament/TransformManager.h>
 #include <filament/Texture.h>
 #include <filament/RenderableManager.h>
@@ -19,10 +23,14 @@
 
 #include "StreamBufferAdapter.hpp"
 #include "SceneAsset.hpp"
+#include "BoneTracks.hpp"
+#include "LayerBlending.hpp"
 #include "Log.hpp"
 #include "AssetManager.hpp"
+#include "cgltf.h"
 
 #include "material/FileMaterialProvider.hpp"
+#include "material/UnlitMaterialProvider.hpp"
 #include "gltfio/materials/uberarchive.h"
 
 extern "C" {
@@ -69,7 +77,14 @@ _scene(scene) {
 
     EntityManager &em = EntityManager::get();
             
-    _assetLoader = AssetLoader::create({_engine, _ubershaderProvider, _ncm, &em });
+    // specialized materials (if any are registered) take precedence over the ubershader
+    _specializedMaterialProvider = new SpecializedMaterialProvider(_engine, _ubershaderProvider);
+
+    _assetLoader = AssetLoader::create({_engine, _specializedMaterialProvider, _ncm, &em });
+
+    // shares the same material caches, but forces the unlit variants and skips most dummy attributes
+    _unlitMaterialProvider = new UnlitMaterialProvider(_specializedMaterialProvider);
+    _unlitAssetLoader = AssetLoader::create({_engine, _unlitMaterialProvider, _ncm, &em });
     _gltfResourceLoader->addTextureProvider("image/ktx2", _ktxDecoder);
     _gltfResourceLoader->addTextureProvider("image/png", _stbDecoder);
     _gltfResourceLoader->addTextureProvider("image/jpeg", _stbDecoder);
@@ -79,7 +94,12 @@ AssetManager::~AssetManager() {
     _gltfResourceLoader->asyncCancelLoad();
     _ubershaderProvider->destroyMaterials();
     destroyAll();
+    _specializedMaterialProvider->destroyMaterials();
     AssetLoader::destroy(&_assetLoader);
+    AssetLoader::destroy(&_unlitAssetLoader);
+    delete _unlitMaterialProvider;
+    delete _specializedMaterialProvider;
+    delete _animationWorkers;
     
 }
 
@@ -128,16 +148,22 @@ EntityId AssetManager::loadGltf(const char *uri,
     inst->getAnimator()->updateBoneMatrices();
     inst->recomputeBoundingBoxes();
     
-    asset->releaseSourceData();
-    
     SceneAsset sceneAsset(asset);
+    sceneAsset.mUri = uri;
+    sceneAsset.mResourcePath = relativeResourcePath;
+    captureRestPose(sceneAsset);
     
     utils::Entity e = EntityManager::get().create();
     
     EntityId eid = Entity::smuggle(e);
+
+    addGpuInstancedNodes(sceneAsset, eid);
+    
+    asset->releaseSourceData();
     
     _entityIdLookup.emplace(eid, _assets.size());
     _assets.push_back(sceneAsset);
+    publishMetadata(std::atomic_load(&_metadata)->with(eid, buildAssetMetadata(asset, *_ncm)));
 
     for(auto& rb : resourceBuffers) {
         _resourceLoaderWrapper->free(rb);
@@ -155,7 +181,9 @@ EntityId AssetManager::loadGlb(const char *uri, bool unlit) {
 
     Log("Loaded GLB of size %d at URI %s", rbuf.size, uri);
 
-    FilamentAsset *asset = _assetLoader->createAsset(
+    AssetLoader* loader = unlit ? _unlitAssetLoader : _assetLoader;
+
+    FilamentAsset *asset = loader->createAsset(
                                                      (const uint8_t *)rbuf.data, rbuf.size);
     
     if (!asset) {
@@ -184,21 +212,42 @@ EntityId AssetManager::loadGlb(const char *uri, bool unlit) {
     
     inst->recomputeBoundingBoxes();
     
-    asset->releaseSourceData();
-    
-    _resourceLoaderWrapper->free(rbuf);
-    
     SceneAsset sceneAsset(asset);
+    sceneAsset.mUnlit = unlit;
+    sceneAsset.mUri = uri;
+    captureRestPose(sceneAsset);
     
     utils::Entity e = EntityManager::get().create();
     EntityId eid = Entity::smuggle(e);
+
+    addGpuInstancedNodes(sceneAsset, eid);
+    
+    asset->releaseSourceData();
+    
+    _resourceLoaderWrapper->free(rbuf);
     
     _entityIdLookup.emplace(eid, _assets.size());
     _assets.push_back(sceneAsset);
+    publishMetadata(std::atomic_load(&_metadata)->with(eid, buildAssetMetadata(asset, *_ncm)));
     
     return eid;
 }
 
+bool AssetManager::addMaterialSpecialization(const char* packageUri, uint32_t features) {
+    ResourceBuffer rbuf = _resourceLoaderWrapper->load(packageUri);
+    if(!rbuf.data || rbuf.size == 0) {
+        Log("Failed to load material package at %s", packageUri);
+        return false;
+    }
+    // the package is copied and only built into a Material when an asset first needs it
+    bool added = _specializedMaterialProvider->addSpecialization(features, rbuf.data, rbuf.size);
+    _resourceLoaderWrapper->free(rbuf);
+    if(added) {
+        Log("Added material specialization %s for features %x", packageUri, features);
+    }
+    return added;
+}
+
 bool AssetManager::hide(EntityId entityId, const char* meshName) {
     
     auto asset = getAssetByEntityId(entityId);
@@ -213,6 +262,7 @@ bool AssetManager::hide(EntityId entityId, const char* meshName) {
         return false;
     }
     _scene->remove(entity);
+    updateHidden(entityId);
     return true;
 }
 
@@ -232,18 +282,61 @@ bool AssetManager::reveal(EntityId entityId, const char* meshName) {
         return false;
     }
     _scene->addEntity(entity);
+    updateHidden(entityId);
     return true;
 }
 
+void AssetManager::updateHidden(EntityId entityId) {
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        return;
+    }
+    auto& asset = _assets[pos->second];
+    const utils::Entity* renderables = asset.mAsset->getRenderableEntities();
+    bool hidden = true;
+    for(size_t i = 0; i < asset.mAsset->getRenderableEntityCount(); i++) {
+        if(_scene->hasEntity(renderables[i])) {
+            hidden = false;
+            break;
+        }
+    }
+    std::lock_guard lock(_animationMutex);
+    asset.mHidden = hidden;
+}
+
 void AssetManager::destroyAll() {
+    // live pose streams are created (and their assets looked up) from other threads
+    std::lock_guard lock(_animationMutex);
+    for (auto it = _instancedMeshes.begin(); it != _instancedMeshes.end(); ++it) {
+        destroyInstancedMesh(it.value(), *_engine, *_scene);
+    }
+    _instancedMeshes.clear();
     for (auto& asset : _assets) {
         _scene->removeEntities(asset.mAsset->getEntities(),
                                 asset.mAsset->getEntityCount());
         _scene->removeEntities(asset.mAsset->getLightEntities(),
                                 asset.mAsset->getLightEntityCount());
-        _assetLoader->destroyAsset(asset.mAsset);
+        getLoaderForAsset(asset)->destroyAsset(asset.mAsset);
     }
+    // the retarget maps hold the transform instances of the assets destroyed above
+    for (auto it = _entityIdLookup.begin(); it != _entityIdLookup.end(); ++it) {
+        _retargetCache.removeTarget(it->first);
+    }
+    // as in remove(), baked animations are only kept while an asset loaded from the same source is
+    _clipCache.clear();
+    _clipBounds.clear();
     _assets.clear();
+    _entityIdLookup.clear();
+    publishMetadata(std::make_shared<AssetMetadataTable>());
+}
+
+void AssetManager::publishMetadata(shared_ptr<const AssetMetadataTable> table) {
+    // assets are only loaded and removed on the render thread, so there's only ever one writer
+    std::atomic_store(&_metadata, std::move(table));
+}
+
+shared_ptr<const AssetMetadata> AssetManager::getMetadata(EntityId entityId) {
+    return std::atomic_load(&_metadata)->find(entityId);
 }
 
 FilamentAsset* AssetManager::getAssetByEntityId(EntityId entityId) {
@@ -255,214 +348,2112 @@ FilamentAsset* AssetManager::getAssetByEntityId(EntityId entityId) {
 }
 
 
-void AssetManager::updateAnimations() { 
+//
+// Converts [elapsedInSecs] to a pair of frame indices and the fraction [alpha] between them, for a buffer of [numFrames] frames.
+// Both indices are always within [0, numFrames).
+//
+static void getFramePosition(float elapsedInSecs, float frameLengthInMs, int numFrames, bool loop, bool reverse, int& frame, int& nextFrame, float& alpha) {
+    float position = elapsedInSecs * 1000.0f / frameLengthInMs;
+    if(loop) {
+        if(reverse) {
+            position = numFrames - position;
+        }
+        position = fmod(position, float(numFrames));
+        if(position < 0) {
+            position += numFrames;
+        }
+    } else {
+        if(reverse) {
+            position = (numFrames - 1) - position;
+        }
+        position = std::clamp(position, 0.0f, float(numFrames - 1));
+    }
+    frame = std::min(static_cast<int>(position), numFrames - 1);
+    alpha = position - frame;
+    nextFrame = frame + 1;
+    if(nextFrame >= numFrames) {
+        nextFrame = loop ? 0 : numFrames - 1;
+    }
+}
+
+//
+// Animations are updated in three passes:
+// 1) (serial) advance each animation's clock, drop completed animations and work out which frames to sample;
+// 2) (parallel) interpolate morph weights/bone transforms into each asset's scratch buffers. This only touches data owned by the asset, so assets can be sampled on any thread;
+// 3) (serial) commit the results to the RenderableManager/TransformManager, which aren't thread-safe. glTF animations are applied here too, since the gltfio Animator writes directly to the TransformManager.
+// Assets skipped by the LOD policy (or whose animations haven't moved since they were last applied) only take part in the first pass.
+//
+void AssetManager::updateAnimations(float deltaInSecs, const Camera* camera) {
     
-    std::lock_guard lock(_animationMutex);
+    std::unique_lock lock(_animationMutex);
     RenderableManager &rm = _engine->getRenderableManager();
+
+    // in fixed-timestep mode every frame advances by exactly the same amount, regardless of how long it actually took
+    // (e.g. for rendering deterministically/offline)
+    float delta = (_fixedAnimationTimestep > 0 ? _fixedAnimationTimestep : deltaInSecs) * _animationTimeScale;
     
-    for (auto& asset : _assets) {
+    _animationFrameCount++;
+
+    for (size_t assetIndex = 0; assetIndex < _assets.size(); assetIndex++) {
+
+        auto& asset = _assets[assetIndex];
+
+        asset.mEvaluateAnimations = false;
+
+        // paused assets are only evaluated to apply seeks (e.g. when scrubbing a timeline)
+        const bool paused = _animationsPaused || asset.mPaused;
+        if((paused && !asset.mSeekPending) || (asset.mAnimations.empty() && !asset.mLayerStack.isActive())) {
+            continue;
+        }
+        asset.mSeekPending = false;
 
+        float assetDelta = paused ? 0.0f : delta * asset.mTimeScale;
+
+        // previously skins were recomputed once per active animation; count all of these as skipped, then deduct the single update (if any) made below
+        if(asset.mAsset->getInstance()->getSkinCount() > 0) {
+            _skinUpdatesSkipped += asset.mAnimations.size();
+        }
         
+        bool changed = false;
         std::vector<int> completed;
         int index = 0;
         for(auto& anim : asset.mAnimations) {
 
-            auto now = high_resolution_clock::now();
-            
-            auto elapsed = float(std::chrono::duration_cast<std::chrono::milliseconds>(now - anim.mStart).count()) / 1000.0f;
+            // any number of seeks since the last update only result in a single evaluation, at the most recent time
+            if(anim.mSeekTime >= 0.0f) {
+                anim.mTime = anim.mSeekTime;
+                anim.mSeekTime = -1.0f;
+            } else if(!anim.mHeld) {
+                anim.mTime += assetDelta;
+            }
+
+            if(anim.mLoop && anim.mDuration > 0 && anim.mTime >= anim.mDuration) {
+                anim.mTime = fmod(anim.mTime, anim.mDuration);
+            }
+
+            auto elapsed = anim.mTime;
             
-            if(anim.mLoop || elapsed < anim.mDuration) {
-                
+            if(anim.mHeld || anim.mLoop || elapsed < anim.mDuration) {
+                changed |= elapsed != anim.mLastAppliedTime;
                 switch(anim.type) {
-                    case AnimationType::GLTF: {
-                        asset.mAnimator->applyAnimation(anim.gltfIndex, elapsed);
-                        if(asset.fadeGltfAnimationIndex != -1 && elapsed < asset.fadeDuration) {
-                            // cross-fade
-                            auto fadeFromTime = asset.fadeOutAnimationStart + elapsed;
-                            auto alpha = elapsed / asset.fadeDuration;
-                            asset.mAnimator->applyCrossFade(asset.fadeGltfAnimationIndex, fadeFromTime, alpha);
+                    case AnimationType::GLTF:
+                        if(anim.mBake) {
+                            bakeAnimation(asset, anim);
+                        }
+                        if(anim.mBakedClip) {
+                            // mTime has already been wrapped above (or clamped by seekAnimation), so this never needs to loop
+                            auto& clip = *anim.mBakedClip;
+                            getFramePosition(elapsed, 1000.0f / clip.sampleRate, clip.numFrames, false, false, anim.mFrame, anim.mNextFrame, anim.mAlpha);
                         }
                         break;
-                    }
                     case AnimationType::MORPH: {
-                        int lengthInFrames = static_cast<int>(
-                                                              anim.mDuration * 1000.0f /
-                                                              asset.mMorphAnimationBuffer.mFrameLengthInMs
-                                                              );
-                        int frameNumber = static_cast<int>(elapsed * 1000.0f / asset.mMorphAnimationBuffer.mFrameLengthInMs) % lengthInFrames;
-                        // offset from the end if reverse
-                        if(anim.mReverse) {
-                            frameNumber = lengthInFrames - frameNumber;
-                        }
-                        auto baseOffset = frameNumber * asset.mMorphAnimationBuffer.mMorphIndices.size();
-                        for(int i = 0; i < asset.mMorphAnimationBuffer.mMorphIndices.size(); i++) {
-                            auto morphIndex = asset.mMorphAnimationBuffer.mMorphIndices[i];
-                            // set the weights appropriately
-                            rm.setMorphWeights(
-                                               rm.getInstance(asset.mMorphAnimationBuffer.mMeshTarget),
-                                               asset.mMorphAnimationBuffer.mFrameData.data() + baseOffset + i,
-                                               1,
-                                               morphIndex
-                                               );
-                        }
+                        auto& buffer = asset.mMorphAnimationBuffers[anim.morphBufferIndex];
+                        getFramePosition(elapsed, buffer.mFrameLengthInMs, buffer.mNumFrames, anim.mLoop, anim.mReverse, anim.mFrame, anim.mNextFrame, anim.mAlpha);
                         break;
                     }
                     case AnimationType::BONE: {
-                        int lengthInFrames = static_cast<int>(
-                                                              anim.mDuration * 1000.0f /
-                                                              asset.mBoneAnimationBuffer.mFrameLengthInMs
-                                                              );
-                        int frameNumber = static_cast<int>(elapsed * 1000.0f / asset.mBoneAnimationBuffer.mFrameLengthInMs) % lengthInFrames;
-                        
-                        // offset from the end if reverse
-                        if(anim.mReverse) {
-                            frameNumber = lengthInFrames - frameNumber;
-                        }
-                        setBoneTransform(
-                                         asset,
-                                         frameNumber
-                                         );
+                        auto& buffer = asset.mBoneAnimationBuffer;
+                        getFramePosition(elapsed, buffer.mFrameLengthInMs, buffer.mNumFrames, anim.mLoop, anim.mReverse, anim.mFrame, anim.mNextFrame, anim.mAlpha);
                         break;
                     }
                 }
-                if(anim.mLoop && elapsed >= anim.mDuration) {
-                    anim.mStart = now;
-                }
-                // animation has completed
+            // animation has completed
             } else {
                 completed.push_back(index);
-                asset.fadeGltfAnimationIndex = -1;
+                if(anim.type == AnimationType::GLTF) {
+                    asset.fadeGltfAnimationIndex = -1;
+                }
             }
-            asset.mAnimator->updateBoneMatrices();
             index++;
         }
 
         for(int i = completed.size() - 1; i >= 0; i--) {
-            asset.mAnimations.erase(asset.mAnimations.begin() + i);
+            asset.mAnimations.erase(asset.mAnimations.begin() + completed[i]);
+        }
+
+        // the state machine (if any) sets the time and weight of its layers before they're advanced below
+        if(asset.mStateMachine) {
+            updateStateMachine(asset, assetDelta);
+        }
+
+        // blend layers never complete; non-looping layers simply hold their last frame
+        auto& stack = asset.mLayerStack;
+        for(auto& layer : stack.mLayers) {
+            if(layer.mBake) {
+                bakeLayer(asset, layer);
+            }
+            if(!layer.mClip) {
+                continue;
+            }
+            auto& clip = *layer.mClip;
+            layer.mTime += assetDelta * layer.mSpeed;
+            if(layer.mLoop && clip.duration > 0) {
+                layer.mTime = fmod(layer.mTime, clip.duration);
+                if(layer.mTime < 0) {
+                    layer.mTime += clip.duration;
+                }
+            } else {
+                layer.mTime = std::clamp(layer.mTime, 0.0f, clip.duration);
+            }
+            changed |= layer.mTime != layer.mLastAppliedTime;
+            getFramePosition(layer.mTime, 1000.0f / clip.sampleRate, clip.numFrames, false, false, layer.mFrame, layer.mNextFrame, layer.mAlpha);
+        }
+        changed |= stack.mDirty;
+
+        asset.mEvaluateAnimations = changed && (!camera || shouldEvaluateAnimations(asset, assetIndex, *camera));
+    }
+
+    // erasing completed animations may move AnimationStatus entries, so pointers are only taken once that's done
+    _animationSampleJobs.clear();
+    for (auto& asset : _assets) {
+        if(!asset.mEvaluateAnimations) {
+            continue;
+        }
+        for(auto& anim : asset.mAnimations) {
+            if(anim.type != AnimationType::GLTF || anim.mBakedClip) {
+                _animationSampleJobs.push_back({ &asset, &anim });
+            }
+        }
+        if(asset.mLayerStack.isActive()) {
+            _animationSampleJobs.push_back({ &asset, nullptr });
+        }
+    }
+
+    sampleAnimations();
+
+    for (auto& asset : _assets) {
+
+        // live poses are applied as soon as they are published, regardless of pausing or LOD
+        auto& live = asset.mLivePose;
+        const bool livePosePublished = live.mStream && live.mStream->acquire();
+
+        // constraints that follow an entity are re-solved every frame that animations are evaluated, as the entity may have moved
+        bool constraintsDirty = asset.mConstraintsDirty;
+        if(asset.mEvaluateAnimations && !constraintsDirty) {
+            for(const auto& constraint : asset.mConstraints) {
+                if(constraint.mTargetInstance) {
+                    constraintsDirty = true;
+                    break;
+                }
+            }
+        }
+
+        if(!asset.mEvaluateAnimations && !livePosePublished && !constraintsDirty && !asset.mBounds.mDirty) {
+            continue;
+        }
+
+        // only glTF and bone animations move joints, and the skins are recomputed at most once (after every animation has been applied)
+        bool posed = false;
+
+        if(asset.mEvaluateAnimations) {
+            // layers are blended over the pose committed by the glTF and bone animations below, so any nodes the last blend wrote
+            // are first returned to their rest transforms (the animations then overwrite whichever of them they drive)
+            auto& stack = asset.mLayerStack;
+            const bool layersOverAnimations = std::any_of(asset.mAnimations.begin(), asset.mAnimations.end(),
+                                                          [](const AnimationStatus& anim) { return anim.type != AnimationType::MORPH; });
+            if(layersOverAnimations && stack.mNumTouched > 0) {
+                restoreLayerNodes(asset);
+            }
+
+            for(auto& anim : asset.mAnimations) {
+                anim.mLastAppliedTime = anim.mTime;
+                switch(anim.type) {
+                    case AnimationType::GLTF: {
+                        auto elapsed = anim.mTime;
+                        if(anim.mBakedClip) {
+                            setBakedTransforms(anim);
+                        } else {
+                            asset.mAnimator->applyAnimation(anim.gltfIndex, elapsed);
+                        }
+                        posed = true;
+                        if(asset.fadeGltfAnimationIndex != -1) {
+                            if(elapsed < asset.fadeDuration) {
+                                // cross-fade
+                                auto fadeFromTime = asset.fadeOutAnimationStart + elapsed;
+                                auto alpha = elapsed / asset.fadeDuration;
+                                asset.mAnimator->applyCrossFade(asset.fadeGltfAnimationIndex, fadeFromTime, alpha);
+                            } else {
+                                // otherwise a looping animation would fade in again each time it wraps
+                                asset.fadeGltfAnimationIndex = -1;
+                            }
+                        }
+                        break;
+                    }
+                    case AnimationType::MORPH: {
+                        auto& buffer = asset.mMorphAnimationBuffers[anim.morphBufferIndex];
+                        for(const auto& [offset, count] : buffer.mWeightRuns) {
+                            rm.setMorphWeights(buffer.mRenderableInstance, buffer.mWeights.data() + offset, count, buffer.mMinMorphIndex + offset);
+                        }
+                        break;
+                    }
+                    case AnimationType::BONE: {
+                        setBoneTransform(asset);
+                        posed = true;
+                        break;
+                    }
+                }
+            }
+
+            for(auto& layer : stack.mLayers) {
+                layer.mLastAppliedTime = layer.mTime;
+            }
+            stack.mDirty = false;
+            if(stack.isActive()) {
+                posed |= blendLayers(asset, layersOverAnimations);
+            }
+        }
+
+        // applied last (and re-applied whenever animations have been) so streamed weights and joints take precedence
+        if(live.mStream && live.mStream->hasPose()) {
+            posed |= applyLivePose(asset);
         }
+
+        // solved against the final pose; if nothing has moved the joints since the last solve, each constraint first restores its
+        // unconstrained pose (see solveJointConstraint)
+        if(!asset.mConstraints.empty() && (posed || constraintsDirty)) {
+            auto& tm = _engine->getTransformManager();
+            for(auto& constraint : asset.mConstraints) {
+                solveJointConstraint(tm, constraint);
+            }
+            posed = true;
+        }
+        // a removed constraint may have restored joints, which the skin must reflect
+        posed |= asset.mConstraintsDirty;
+        asset.mConstraintsDirty = false;
+
+        if(posed && asset.mAsset->getInstance()->getSkinCount() > 0) {
+            asset.mAnimator->updateBoneMatrices();
+            _skinUpdates++;
+            // only assets with animations were counted as skipped above
+            if(asset.mEvaluateAnimations && !asset.mAnimations.empty()) {
+                _skinUpdatesSkipped--;
+            }
+        }
+
+        if(asset.mBounds.mMode != AnimatedBoundsMode::BIND_POSE) {
+            updateAnimatedBounds(asset, posed);
+        }
+    }
+
+    updateTweens(_animationsPaused ? 0.0f : delta);
+
+    // the callback may call back into AssetManager (e.g. to start the next tween), so it's only invoked once the lock is released
+    if(_endedTweens.empty()) {
+        return;
+    }
+    _notifiedTweens.swap(_endedTweens);
+    lock.unlock();
+    for(const auto& [tweenId, finished] : _notifiedTweens) {
+        notifyTweenEnded(tweenId, finished);
     }
+    _notifiedTweens.clear();
 }
 
-void AssetManager::setBoneTransform(SceneAsset& asset, int frameNumber) {
-    
-    RenderableManager& rm = _engine->getRenderableManager();
-    
-    const auto& filamentInstance = asset.mAsset->getInstance();
-    
-    TransformManager &transformManager = _engine->getTransformManager();
-    
-    int skinIndex = 0;
-    
-    for(int i = 0; i < asset.mBoneAnimationBuffer.mBones.size(); i++) {
-        auto mBoneIndex = asset.mBoneAnimationBuffer.mBones[i];
-        auto frameDataOffset = (frameNumber * asset.mBoneAnimationBuffer.mBones.size() * 7) + (i * 7);
-        
-        utils::Entity joint = filamentInstance->getJointsAt(skinIndex)[mBoneIndex];
-        if(joint.isNull()) {
-            Log("ERROR : joint not found");
+void AssetManager::notifyTweenEnded(int32_t tweenId, bool finished) {
+    std::lock_guard lock(_tweenCallbackMutex);
+    if(_tweenCallback) {
+        _tweenCallback(tweenId, finished);
+    }
+}
+
+void AssetManager::updateTweens(float deltaInSecs) {
+    if(_tweens.empty()) {
+        return;
+    }
+    // tweens are kept in a flat array and removed in a single pass, so thousands can be advanced without any per-tween allocation
+    size_t numRemaining = 0;
+    for(size_t i = 0; i < _tweens.size(); i++) {
+        auto& tween = _tweens[i];
+        tween.mElapsed += deltaInSecs;
+        const bool finished = tween.mElapsed >= tween.mDuration;
+        const float t = finished ? 1.0f : applyEasing(tween.mEasing, tween.mElapsed / tween.mDuration);
+        const bool applied = applyTween(tween, t);
+        if(!applied || finished) {
+            _endedTweens.emplace_back(tween.mId, applied);
             continue;
         }
-        
-        vector<float>& fd = asset.mBoneAnimationBuffer.mFrameData;
-        
-        math::mat4f localTransform(math::quatf {
-            fd[frameDataOffset+3],
-            fd[frameDataOffset+4],
-            fd[frameDataOffset+5],
-            fd[frameDataOffset+6],
+        if(numRemaining != i) {
+            _tweens[numRemaining] = tween;
+        }
+        numRemaining++;
+    }
+    _tweens.resize(numRemaining);
+}
+
+// returns false if the target no longer exists
+bool AssetManager::applyTween(const Tween& tween, float t) {
+    const math::float4 value = tween.mFrom + (tween.mTo - tween.mFrom) * t;
+    switch(tween.mProperty) {
+        case TweenProperty::POSITION:
+        case TweenProperty::ROTATION:
+        case TweenProperty::SCALE:
+        case TweenProperty::BASE_COLOR_FACTOR: {
+            const auto& pos = _entityIdLookup.find(tween.mEntity);
+            if(pos == _entityIdLookup.end()) {
+                return false;
+            }
+            auto& asset = _assets[pos->second];
+            if(tween.mProperty == TweenProperty::BASE_COLOR_FACTOR) {
+                tween.mMaterialInstance->setParameter("baseColorFactor", RgbaType::sRGB, value);
+                return true;
+            }
+            if(tween.mProperty == TweenProperty::POSITION) {
+                asset.mPosition = math::mat4f::translation(value.xyz);
+            } else if(tween.mProperty == TweenProperty::ROTATION) {
+                const math::quatf from(tween.mFrom.w, tween.mFrom.x, tween.mFrom.y, tween.mFrom.z);
+                const math::quatf to(tween.mTo.w, tween.mTo.x, tween.mTo.y, tween.mTo.z);
+                asset.mRotation = math::mat4f(slerp(from, to, t));
+            } else {
+                asset.mScale = value.x;
+            }
+            updateTransform(asset);
+            return true;
+        }
+        case TweenProperty::LIGHT_INTENSITY: {
+            auto& lm = _engine->getLightManager();
+            auto instance = lm.getInstance(Entity::import(tween.mEntity));
+            if(!instance.isValid()) {
+                return false;
+            }
+            lm.setIntensity(instance, value.x);
+            return true;
+        }
+        case TweenProperty::CAMERA_EXPOSURE: {
+            auto* camera = _engine->getCameraComponent(Entity::import(tween.mEntity));
+            if(!camera) {
+                return false;
+            }
+            camera->setExposure(value.x, value.y, value.z);
+            return true;
+        }
+    }
+    return false;
+}
+
+int32_t AssetManager::addTween(Tween&& tween) {
+    int32_t replaced = -1;
+    {
+        std::lock_guard lock(_animationMutex);
+        tween.mId = _nextTweenId++;
+        tween.mDuration = std::max(tween.mDuration, 0.0f);
+        // a new tween takes over from any earlier tween of the same property on the same target
+        auto existing = std::find_if(_tweens.begin(), _tweens.end(), [&](const Tween& other) {
+            return other.mEntity == tween.mEntity && other.mProperty == tween.mProperty && other.mMaterialInstance == tween.mMaterialInstance;
         });
-        
-        auto jointInstance = transformManager.getInstance(joint);
-        
-        auto xform = asset.mBoneAnimationBuffer.mBaseTransforms[i];
-        
-        transformManager.setTransform(jointInstance, xform * localTransform);
-        
+        if(existing != _tweens.end()) {
+            replaced = existing->mId;
+            *existing = tween;
+        } else {
+            _tweens.push_back(tween);
+        }
+    }
+    if(replaced >= 0) {
+        notifyTweenEnded(replaced, false);
     }
+    return tween.mId;
 }
 
-void AssetManager::remove(EntityId entityId) {
+int32_t AssetManager::tween(EntityId entity, TweenProperty property, const float* const from, const float* const to, float durationInSecs, Easing easing) {
+    int numComponents;
+    switch(property) {
+        case TweenProperty::POSITION:
+        case TweenProperty::CAMERA_EXPOSURE:
+            numComponents = 3;
+            break;
+        case TweenProperty::ROTATION:
+            numComponents = 4;
+            break;
+        case TweenProperty::SCALE:
+        case TweenProperty::LIGHT_INTENSITY:
+            numComponents = 1;
+            break;
+        case TweenProperty::BASE_COLOR_FACTOR:
+            Log("ERROR: use tweenMaterialColor to tween baseColorFactor.");
+            return -1;
+        default:
+            Log("ERROR: unknown tween property %d.", (int)property);
+            return -1;
+    }
+    if(easing < Easing::LINEAR || easing > Easing::EASE_IN_OUT_SINE) {
+        Log("ERROR: unknown easing %d.", (int)easing);
+        return -1;
+    }
+
+    switch(property) {
+        case TweenProperty::LIGHT_INTENSITY:
+            if(!_engine->getLightManager().getInstance(Entity::import(entity)).isValid()) {
+                Log("ERROR: entity %d is not a light.", entity);
+                return -1;
+            }
+            break;
+        case TweenProperty::CAMERA_EXPOSURE:
+            if(!_engine->getCameraComponent(Entity::import(entity))) {
+                Log("ERROR: entity %d is not a camera.", entity);
+                return -1;
+            }
+            break;
+        default: {
+            std::lock_guard lock(_animationMutex);
+            if(_entityIdLookup.find(entity) == _entityIdLookup.end()) {
+                Log("ERROR: asset not found for entity.");
+                return -1;
+            }
+        }
+    }
+
+    Tween tween;
+    tween.mProperty = property;
+    tween.mEasing = easing;
+    tween.mEntity = entity;
+    tween.mDuration = durationInSecs;
+    for(int i = 0; i < numComponents; i++) {
+        tween.mFrom[i] = from[i];
+        tween.mTo[i] = to[i];
+    }
+    if(property == TweenProperty::ROTATION) {
+        tween.mFrom = normalize(tween.mFrom);
+        tween.mTo = normalize(tween.mTo);
+        // along the shortest arc
+        if(dot(tween.mFrom, tween.mTo) < 0.0f) {
+            tween.mTo = -tween.mTo;
+        }
+    }
+    return addTween(std::move(tween));
+}
+
+int32_t AssetManager::tweenMaterialColor(EntityId entity, const char* meshName, int materialIndex, const float* const from, const float* const to, float durationInSecs, Easing easing) {
+    if(easing < Easing::LINEAR || easing > Easing::EASE_IN_OUT_SINE) {
+        Log("ERROR: unknown easing %d.", (int)easing);
+        return -1;
+    }
+    MaterialInstance* mi = nullptr;
+    {
+        std::lock_guard lock(_animationMutex);
+        const auto& pos = _entityIdLookup.find(entity);
+        if(pos == _entityIdLookup.end()) {
+            Log("ERROR: asset not found for entity.");
+            return -1;
+        }
+        auto& rm = _engine->getRenderableManager();
+        auto renderable = rm.getInstance(findEntityByName(_assets[pos->second], meshName));
+        if(!renderable.isValid()) {
+            Log("ERROR: failed to find renderable %s.", meshName);
+            return -1;
+        }
+        if(materialIndex < 0 || materialIndex >= (int)rm.getPrimitiveCount(renderable)) {
+            Log("ERROR: material index must be less than number of material instances");
+            return -1;
+        }
+        mi = rm.getMaterialInstanceAt(renderable, materialIndex);
+    }
+
+    Tween tween;
+    tween.mProperty = TweenProperty::BASE_COLOR_FACTOR;
+    tween.mEasing = easing;
+    tween.mEntity = entity;
+    tween.mMaterialInstance = mi;
+    tween.mDuration = durationInSecs;
+    tween.mFrom = math::float4(from[0], from[1], from[2], from[3]);
+    tween.mTo = math::float4(to[0], to[1], to[2], to[3]);
+    return addTween(std::move(tween));
+}
+
+bool AssetManager::cancelTween(int32_t tweenId) {
+    {
+        std::lock_guard lock(_animationMutex);
+        auto it = std::find_if(_tweens.begin(), _tweens.end(), [=](const Tween& tween) { return tween.mId == tweenId; });
+        if(it == _tweens.end()) {
+            // it may simply have finished already
+            return false;
+        }
+        _tweens.erase(it);
+    }
+    notifyTweenEnded(tweenId, false);
+    return true;
+}
+
+void AssetManager::setTweenCallback(TweenCallback callback) {
+    // waits for any callback in progress, so the previous callback is never invoked once this returns
+    std::lock_guard lock(_tweenCallbackMutex);
+    _tweenCallback = callback;
+}
+
+bool AssetManager::applyLivePose(SceneAsset& asset) {
+    auto& live = asset.mLivePose;
+    const float* const slot = live.mStream->getReadSlot();
+    const size_t numMorphWeights = live.mStream->getNumMorphWeights();
+    if(numMorphWeights > 0) {
+        _engine->getRenderableManager().setMorphWeights(live.mMorphInstance, slot, numMorphWeights);
+    }
+    const size_t numBones = live.mJointInstances.size();
+    if(numBones == 0) {
+        return false;
+    }
+    const float* const pose = slot + numMorphWeights;
+    TransformManager &transformManager = _engine->getTransformManager();
+    transformManager.openLocalTransformTransaction();
+    for(size_t i = 0; i < numBones; i++) {
+        transformManager.setTransform(live.mJointInstances[i], live.mBaseTransforms[i] * composeBoneTransform(pose, numBones, i));
+    }
+    transformManager.commitLocalTransformTransaction();
+    return true;
+}
+
+LivePoseStream* AssetManager::createLivePoseStream(
+                                                    EntityId entityId,
+                                                    const char* const meshName,
+                                                    const char** const boneNames,
+                                                    int numBones) {
+    std::lock_guard lock(_animationMutex);
+
     const auto& pos = _entityIdLookup.find(entityId);
     if(pos == _entityIdLookup.end()) {
-        Log("Couldn't find asset under specified entity id.");
-        return;
+        Log("ERROR: asset not found for entity.");
+        return nullptr;
+    }
+    auto& asset = _assets[pos->second];
+    if(asset.mLivePose.mStream) {
+        Log("ERROR: a live pose stream already exists for this asset; remove it first.");
+        return nullptr;
     }
-    SceneAsset& sceneAsset = _assets[pos->second];
 
-    _assets.erase(std::remove_if(_assets.begin(), _assets.end(),
-                                           [=](SceneAsset& asset) { return asset.mAsset == sceneAsset.mAsset; }),
-                            _assets.end());
-    
-    _scene->removeEntities(sceneAsset.mAsset->getEntities(),
-                           sceneAsset.mAsset->getEntityCount());
-    
-    _scene->removeEntities(sceneAsset.mAsset->getLightEntities(),
-                           sceneAsset.mAsset->getLightEntityCount());
-    
-    _assetLoader->destroyAsset(sceneAsset.mAsset);
-    
-    if(sceneAsset.mTexture) {
-        _engine->destroy(sceneAsset.mTexture);
+    LivePoseTarget target;
+    uint32_t numMorphWeights = 0;
+    if(meshName) {
+        auto entity = findEntityByName(asset, meshName);
+        auto& rm = _engine->getRenderableManager();
+        target.mMorphInstance = entity ? rm.getInstance(entity) : RenderableManager::Instance();
+        if(!target.mMorphInstance.isValid()) {
+            Log("ERROR: failed to find renderable %s for live pose stream.", meshName);
+            return nullptr;
+        }
+        numMorphWeights = rm.getMorphTargetCount(target.mMorphInstance);
+    }
+
+    TransformManager &transformManager = _engine->getTransformManager();
+    vector<utils::Entity> joints(std::max(numBones, 0));
+    RetargetCache::findJoints(asset.mAsset->getInstance(), *_ncm, boneNames, joints.size(), joints.data());
+    for(int i = 0; i < numBones; i++) {
+        if(joints[i].isNull()) {
+            Log("ERROR: failed to find bone %s for live pose stream.", boneNames[i]);
+            return nullptr;
+        }
+        auto jointInstance = transformManager.getInstance(joints[i]);
+        target.mJointInstances.push_back(jointInstance);
+        target.mBaseTransforms.push_back(transformManager.getTransform(jointInstance));
+    }
+
+    if(numMorphWeights == 0 && target.mJointInstances.empty()) {
+        Log("ERROR: a live pose stream must drive at least one morph target or bone.");
+        return nullptr;
+    }
+
+    target.mStream = std::make_shared<LivePoseStream>(numMorphWeights, target.mJointInstances.size());
+    asset.mLivePose = std::move(target);
+    return asset.mLivePose.mStream.get();
+}
+
+bool AssetManager::removeLivePoseStream(EntityId entityId) {
+    std::lock_guard lock(_animationMutex);
+
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return false;
+    }
+    auto& asset = _assets[pos->second];
+    auto& live = asset.mLivePose;
+    if(!live.mStream) {
+        Log("ERROR: no live pose stream exists for this asset.");
+        return false;
+    }
+    // leave the joints where the stream found them
+    TransformManager &transformManager = _engine->getTransformManager();
+    for(size_t i = 0; i < live.mJointInstances.size(); i++) {
+        transformManager.setTransform(live.mJointInstances[i], live.mBaseTransforms[i]);
+    }
+    if(!live.mJointInstances.empty() && asset.mAsset->getInstance()->getSkinCount() > 0) {
+        asset.mAnimator->updateBoneMatrices();
+    }
+    asset.mLivePose = LivePoseTarget();
+    return true;
+}
+
+EntityId AssetManager::getJointHandle(EntityId entityId, const char* jointName) {
+    std::lock_guard lock(_animationMutex);
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return 0;
+    }
+    auto joint = findEntityByName(_assets[pos->second], jointName);
+    if(joint.isNull()) {
+        Log("ERROR: failed to find joint %s.", jointName);
+        return 0;
+    }
+    return Entity::smuggle(joint);
+}
+
+bool AssetManager::setAnimatedBounds(EntityId entityId, AnimatedBoundsMode mode, float padding) {
+    std::lock_guard lock(_animationMutex);
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return false;
+    }
+    auto& asset = _assets[pos->second];
+    auto& bounds = asset.mBounds;
+    auto& rm = _engine->getRenderableManager();
+
+    if(bounds.mMode == AnimatedBoundsMode::BIND_POSE) {
+        // the renderables still have the boxes they were loaded with
+        if(mode != AnimatedBoundsMode::BIND_POSE && !initAnimatedBounds(bounds, asset.mAsset, rm, _engine->getTransformManager())) {
+            Log("ERROR: asset has no skinned renderables.");
+            return false;
+        }
+    } else if(mode == AnimatedBoundsMode::BIND_POSE) {
+        for(size_t i = 0; i < bounds.mRenderables.size(); i++) {
+            rm.setAxisAlignedBoundingBox(bounds.mRenderables[i], bounds.mBindBoxes[i]);
+        }
+    }
+    bounds.mMode = mode;
+    bounds.mExtraPadding = std::max(padding, 0.0f);
+    bounds.mClips.clear();
+    bounds.mDirty = mode != AnimatedBoundsMode::BIND_POSE;
+    return true;
+}
+
+void AssetManager::setAnimatedBoxes(SceneAsset& asset, const vector<Box>& boxes) {
+    auto& bounds = asset.mBounds;
+    auto& rm = _engine->getRenderableManager();
+    const math::float3 padding(bounds.mExtraPadding);
+    for(size_t i = 0; i < bounds.mRenderables.size(); i++) {
+        rm.setAxisAlignedBoundingBox(bounds.mRenderables[i], Box().set(boxes[i].getMin() - padding, boxes[i].getMax() + padding));
+    }
+}
+
+void AssetManager::updateAnimatedBounds(SceneAsset& asset, bool posed) {
+    auto& bounds = asset.mBounds;
+    auto& tm = _engine->getTransformManager();
+    const bool dirty = bounds.mDirty;
+    bounds.mDirty = false;
+
+    if(bounds.mMode == AnimatedBoundsMode::PER_FRAME) {
+        if(posed || dirty) {
+            computeJointBounds(bounds, tm, _boundsScratch, false);
+            setAnimatedBoxes(asset, _boundsScratch);
+        }
+        return;
+    }
+
+    // PER_CLIP: the boxes only change when the set of glTF animations playing (or layered) does
+    vector<int> clips;
+    for(const auto& anim : asset.mAnimations) {
+        if(anim.type == AnimationType::GLTF) {
+            clips.push_back(anim.gltfIndex);
+        }
+    }
+    for(const auto& layer : asset.mLayerStack.mLayers) {
+        clips.push_back(layer.mClipIndex);
+    }
+    std::sort(clips.begin(), clips.end());
+    clips.erase(std::unique(clips.begin(), clips.end()), clips.end());
+    if(!dirty && clips == bounds.mClips) {
+        return;
+    }
+
+    _boundsScratch = bounds.mBindBoxes;
+    for(const int clip : clips) {
+        // sampled at 30fps; the padding covers what the joints miss between samples
+        vector<Box> uncached;
+        const vector<Box>* clipBounds = &uncached;
+        if(asset.mUri.empty()) {
+            // without a path to key them on, the bounds can't be shared with other assets
+            uncached = bakeClipBounds(bounds, clip, asset.mAsset, asset.mAnimator, tm, 30.0f);
+        } else {
+            auto key = std::make_pair(asset.mUri, clip);
+            auto cached = _clipBounds.find(key);
+            if(cached == _clipBounds.end()) {
+                cached = _clipBounds.emplace(key, bakeClipBounds(bounds, clip, asset.mAsset, asset.mAnimator, tm, 30.0f)).first;
+            }
+            clipBounds = &cached->second;
+        }
+        for(size_t i = 0; i < clipBounds->size() && i < _boundsScratch.size(); i++) {
+            _boundsScratch[i].unionSelf((*clipBounds)[i]);
+        }
+    }
+    setAnimatedBoxes(asset, _boundsScratch);
+    bounds.mClips = std::move(clips);
+}
+
+int AssetManager::addConstraint(EntityId entityId, JointConstraint&& constraint) {
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return -1;
+    }
+    auto& asset = _assets[pos->second];
+    for(const auto joint : constraint.mJoints) {
+        if(!joint.isValid()) {
+            Log("ERROR: invalid joint handle for constraint.");
+            return -1;
+        }
+    }
+    constraint.mId = asset.mNextConstraintId++;
+    asset.mConstraints.push_back(std::move(constraint));
+    asset.mConstraintsDirty = true;
+    return asset.mConstraints.back().mId;
+}
+
+JointConstraint* AssetManager::getConstraint(EntityId entityId, int constraintId) {
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return nullptr;
+    }
+    auto& asset = _assets[pos->second];
+    for(auto& constraint : asset.mConstraints) {
+        if(constraint.mId == constraintId) {
+            asset.mConstraintsDirty = true;
+            return &constraint;
+        }
+    }
+    Log("ERROR: constraint %d not found.", constraintId);
+    return nullptr;
+}
+
+int AssetManager::addTwoBoneIkConstraint(EntityId entityId, EntityId upperJoint, EntityId lowerJoint, EntityId endJoint, float weight) {
+    std::lock_guard lock(_animationMutex);
+    auto& tm = _engine->getTransformManager();
+    JointConstraint constraint;
+    constraint.mType = JointConstraintType::TWO_BONE_IK;
+    constraint.mWeight = std::clamp(weight, 0.0f, 1.0f);
+    for(const auto joint : { upperJoint, lowerJoint, endJoint }) {
+        constraint.mJoints.push_back(tm.getInstance(Entity::import(joint)));
+    }
+    // start with the end joint where it is, so nothing moves until a target is set
+    if(constraint.mJoints[2].isValid()) {
+        constraint.mTarget = tm.getWorldTransform(constraint.mJoints[2])[3].xyz;
+    }
+    return addConstraint(entityId, std::move(constraint));
+}
+
+int AssetManager::addChainIkConstraint(EntityId entityId, const EntityId* const joints, int numJoints, bool fabrik, int iterations, float weight) {
+    std::lock_guard lock(_animationMutex);
+    if(numJoints < 2) {
+        Log("ERROR: an IK chain needs at least two joints.");
+        return -1;
+    }
+    auto& tm = _engine->getTransformManager();
+    JointConstraint constraint;
+    constraint.mType = fabrik ? JointConstraintType::FABRIK_IK : JointConstraintType::CCD_IK;
+    constraint.mWeight = std::clamp(weight, 0.0f, 1.0f);
+    constraint.mIterations = std::max(iterations, 1);
+    for(int i = 0; i < numJoints; i++) {
+        constraint.mJoints.push_back(tm.getInstance(Entity::import(joints[i])));
+    }
+    if(constraint.mJoints.back().isValid()) {
+        constraint.mTarget = tm.getWorldTransform(constraint.mJoints.back())[3].xyz;
+    }
+    return addConstraint(entityId, std::move(constraint));
+}
+
+int AssetManager::addLookAtConstraint(EntityId entityId, EntityId joint, float forwardX, float forwardY, float forwardZ, float maxAngle, float weight) {
+    std::lock_guard lock(_animationMutex);
+    const math::float3 forward(forwardX, forwardY, forwardZ);
+    if(length(forward) == 0.0f) {
+        Log("ERROR: the forward axis of a look-at constraint must not be zero.");
+        return -1;
+    }
+    auto& tm = _engine->getTransformManager();
+    JointConstraint constraint;
+    constraint.mType = JointConstraintType::LOOK_AT;
+    constraint.mWeight = std::clamp(weight, 0.0f, 1.0f);
+    constraint.mForward = normalize(forward);
+    constraint.mMaxAngle = std::max(maxAngle, 0.0f);
+    constraint.mJoints.push_back(tm.getInstance(Entity::import(joint)));
+    if(constraint.mJoints[0].isValid()) {
+        const auto world = tm.getWorldTransform(constraint.mJoints[0]);
+        constraint.mTarget = world[3].xyz + (world * math::float4(constraint.mForward, 0.0f)).xyz;
+    }
+    return addConstraint(entityId, std::move(constraint));
+}
+
+bool AssetManager::setConstraintTarget(EntityId entityId, int constraintId, float x, float y, float z) {
+    std::lock_guard lock(_animationMutex);
+    auto* constraint = getConstraint(entityId, constraintId);
+    if(!constraint) {
+        return false;
+    }
+    constraint->mTarget = { x, y, z };
+    constraint->mTargetInstance = TransformManager::Instance();
+    return true;
+}
+
+bool AssetManager::setConstraintTargetEntity(EntityId entityId, int constraintId, EntityId target) {
+    std::lock_guard lock(_animationMutex);
+    auto* constraint = getConstraint(entityId, constraintId);
+    if(!constraint) {
+        return false;
+    }
+    auto instance = _engine->getTransformManager().getInstance(Entity::import(target));
+    if(!instance.isValid()) {
+        Log("ERROR: constraint target has no transform.");
+        return false;
+    }
+    constraint->mTargetInstance = instance;
+    return true;
+}
+
+bool AssetManager::setConstraintPole(EntityId entityId, int constraintId, float x, float y, float z) {
+    std::lock_guard lock(_animationMutex);
+    auto* constraint = getConstraint(entityId, constraintId);
+    if(!constraint) {
+        return false;
+    }
+    if(constraint->mType != JointConstraintType::TWO_BONE_IK) {
+        Log("ERROR: only two-bone IK constraints have a pole.");
+        return false;
+    }
+    constraint->mPole = { x, y, z };
+    constraint->mHasPole = true;
+    return true;
+}
+
+bool AssetManager::setConstraintWeight(EntityId entityId, int constraintId, float weight) {
+    std::lock_guard lock(_animationMutex);
+    auto* constraint = getConstraint(entityId, constraintId);
+    if(!constraint) {
+        return false;
+    }
+    constraint->mWeight = std::clamp(weight, 0.0f, 1.0f);
+    return true;
+}
+
+bool AssetManager::removeConstraint(EntityId entityId, int constraintId) {
+    std::lock_guard lock(_animationMutex);
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return false;
+    }
+    auto& asset = _assets[pos->second];
+    auto it = std::find_if(asset.mConstraints.begin(), asset.mConstraints.end(), [=](const JointConstraint& constraint) { return constraint.mId == constraintId; });
+    if(it == asset.mConstraints.end()) {
+        Log("ERROR: constraint %d not found.", constraintId);
+        return false;
+    }
+    // return any joint still holding the solution to its unconstrained pose
+    auto& tm = _engine->getTransformManager();
+    for(size_t i = 0; i < it->mConstrained.size(); i++) {
+        const auto current = tm.getTransform(it->mJoints[i]);
+        if(memcmp(&current, &it->mConstrained[i], sizeof(math::mat4f)) == 0) {
+            tm.setTransform(it->mJoints[i], it->mUnconstrained[i]);
+        }
+    }
+    asset.mConstraints.erase(it);
+    // the remaining constraints are re-solved (and the skin updated) on the next frame
+    asset.mConstraintsDirty = true;
+    return true;
+}
+
+void AssetManager::getSkinUpdateStats(uint64_t* updated, uint64_t* skipped, bool reset) {
+    std::lock_guard lock(_animationMutex);
+    *updated = _skinUpdates;
+    *skipped = _skinUpdatesSkipped;
+    if(reset) {
+        _skinUpdates = 0;
+        _skinUpdatesSkipped = 0;
+    }
+}
+
+//
+// Returns false if the asset's animations can be skipped this frame, i.e. it is hidden, outside the camera frustum,
+// or small enough on screen to be updated at a reduced rate (and this isn't one of the frames it's updated on).
+//
+bool AssetManager::shouldEvaluateAnimations(const SceneAsset& asset, size_t assetIndex, const Camera& camera) {
+    if(!_animationLodEnabled) {
+        return true;
+    }
+    if(asset.mHidden) {
+        return false;
+    }
+
+    auto& tm = _engine->getTransformManager();
+    const math::mat4f world = tm.getWorldTransform(tm.getInstance(asset.mAsset->getRoot()));
+    const Aabb box = asset.mAsset->getBoundingBox();
+    const math::float3 center = (world * math::float4(box.center(), 1.0f)).xyz;
+    const float scale = std::max({ length(world[0].xyz), length(world[1].xyz), length(world[2].xyz) });
+    const float radius = length(box.extent()) * scale;
+
+    if(!camera.getFrustum().intersects(math::float4(center, radius))) {
+        return false;
+    }
+
+    // the fraction of the viewport height covered by the bounding sphere
+    const math::mat4 projection = camera.getCullingProjectionMatrix();
+    float screenSize;
+    if(projection[3][3] != 0.0) {
+        // orthographic
+        screenSize = radius * float(projection[1][1]);
+    } else {
+        const float distance = length(center - math::float3(camera.getPosition()));
+        if(distance <= radius) {
+            return true;
+        }
+        screenSize = radius * float(projection[1][1]) / distance;
+    }
+
+    uint32_t rate = 1;
+    if(screenSize < _quarterRateScreenSize) {
+        rate = 4;
+    } else if(screenSize < _halfRateScreenSize) {
+        rate = 2;
+    }
+    // offset by the asset index so reduced-rate assets don't all update on the same frame
+    return (_animationFrameCount + assetIndex) % rate == 0;
+}
+
+void AssetManager::setAnimationLod(bool enabled, float halfRateScreenSize, float quarterRateScreenSize) {
+    std::lock_guard lock(_animationMutex);
+    _animationLodEnabled = enabled;
+    _halfRateScreenSize = halfRateScreenSize;
+    _quarterRateScreenSize = quarterRateScreenSize;
+}
+
+// curves are evaluated at the playback time directly, rather than via frame positions
+static float getCurveTime(const AnimationStatus& anim) {
+    return anim.mReverse ? anim.mDuration - anim.mTime : anim.mTime;
+}
+
+void AssetManager::sampleAnimation(SceneAsset& asset, AnimationStatus& anim) {
+    switch(anim.type) {
+        case AnimationType::MORPH: {
+            auto& buffer = asset.mMorphAnimationBuffers[anim.morphBufferIndex];
+            const size_t numMorphTargets = buffer.mMorphIndices.size();
+            float* const weights = buffer.mWeights.data();
+            const int* const morphIndices = buffer.mMorphIndices.data();
+            const int minMorphIndex = buffer.mMinMorphIndex;
+            if(buffer.mCompressed || buffer.mCurves) {
+                if(buffer.mCurves) {
+                    buffer.mCurves->evaluate(getCurveTime(anim), buffer.mCurveCursors.data(), buffer.mDecompressed.data());
+                } else {
+                    buffer.mCompressed->sample(anim.mFrame, anim.mNextFrame, anim.mAlpha, buffer.mDecompressed.data());
+                }
+                for(size_t i = 0; i < numMorphTargets; i++) {
+                    weights[morphIndices[i] - minMorphIndex] = buffer.mDecompressed[i];
+                }
+                break;
+            }
+            const float* const from = buffer.mFrameData.data() + anim.mFrame * numMorphTargets;
+            const float* const to = buffer.mFrameData.data() + anim.mNextFrame * numMorphTargets;
+            const float alpha = anim.mAlpha;
+            for(size_t i = 0; i < numMorphTargets; i++) {
+                weights[morphIndices[i] - minMorphIndex] = from[i] + (to[i] - from[i]) * alpha;
+            }
+            break;
+        }
+        case AnimationType::BONE: {
+            auto& buffer = asset.mBoneAnimationBuffer;
+            const auto& retargetMap = *buffer.mRetargetMap;
+            const size_t numBones = retargetMap.mJointInstances.size();
+            const size_t frameSize = numBones * BoneTrack::COMPONENT_COUNT;
+            if(buffer.mCurves) {
+                // channels without a curve are held at the bind pose (i.e. relative to the map's corrections)
+                float* const pose = buffer.mPose.data();
+                std::fill(pose, pose + frameSize, 0.0f);
+                std::fill(pose + BoneTrack::RW * numBones, pose + (BoneTrack::RW + 1) * numBones, 1.0f);
+                std::fill(pose + BoneTrack::SX * numBones, pose + frameSize, 1.0f);
+                buffer.mCurves->evaluate(getCurveTime(anim), buffer.mCurveCursors.data(), pose);
+                normalizeBoneRotations(pose, numBones);
+            } else if(buffer.mCompressed) {
+                buffer.mCompressed->sample(anim.mFrame, anim.mNextFrame, anim.mAlpha, buffer.mDecompressed.data(), buffer.mPose.data());
+            } else {
+                interpolateBoneTracks(
+                                      buffer.mFrameData->data() + anim.mFrame * frameSize,
+                                      buffer.mFrameData->data() + anim.mNextFrame * frameSize,
+                                      anim.mAlpha,
+                                      numBones,
+                                      buffer.mPose.data()
+                                      );
+            }
+            for(size_t i = 0; i < numBones; i++) {
+                buffer.mTransforms[i] = retargetMap.mCorrections[i] * composeBoneTransform(buffer.mPose.data(), numBones, i);
+            }
+            break;
+        }
+        case AnimationType::GLTF: {
+            // only baked animations are sampled here; the rest are applied directly by the Animator
+            auto& clip = *anim.mBakedClip;
+            const size_t numNodes = clip.nodes.size();
+            const size_t frameSize = numNodes * BoneTrack::COMPONENT_COUNT;
+            float* const from = anim.mBakedFrames.data();
+            float* const to = from + frameSize;
+            clip.decodeFrame(anim.mFrame, from);
+            clip.decodeFrame(anim.mNextFrame, to);
+            interpolateBoneTracks(from, to, anim.mAlpha, numNodes, anim.mBakedPose.data());
+            for(size_t i = 0; i < numNodes; i++) {
+                anim.mBakedTransforms[i] = composeBoneTransform(anim.mBakedPose.data(), numNodes, i);
+            }
+            break;
+        }
+    }
+}
+
+void AssetManager::bakeAnimation(SceneAsset& asset, AnimationStatus& anim) {
+    anim.mBake = false;
+    if(asset.mUri.empty()) {
+        // baked clips are shared between assets loaded from the same path
+        Log("Animation baking is only supported for assets loaded from a path, sampling animation %d every frame", anim.gltfIndex);
+        return;
+    }
+    auto& tm = _engine->getTransformManager();
+    anim.mBakedClip = _clipCache.getOrBake(asset.mUri, anim.gltfIndex, asset.mAsset, asset.mAnimator, tm, _animationBakingRate);
+    if(!anim.mBakedClip) {
+        Log("Failed to bake animation %d, falling back to sampling it every frame", anim.gltfIndex);
+        return;
+    }
+    const auto& clip = *anim.mBakedClip;
+    const size_t numNodes = clip.nodes.size();
+    const Entity* entities = asset.mAsset->getEntities();
+    anim.mBakedInstances.resize(numNodes);
+    for(size_t i = 0; i < numNodes; i++) {
+        anim.mBakedInstances[i] = tm.getInstance(entities[clip.nodes[i]]);
+    }
+    anim.mBakedFrames.resize(2 * numNodes * BoneTrack::COMPONENT_COUNT);
+    anim.mBakedPose.resize(numNodes * BoneTrack::COMPONENT_COUNT);
+    anim.mBakedTransforms.resize(numNodes);
+}
+
+void AssetManager::setBakedTransforms(const AnimationStatus& anim) {
+    TransformManager &transformManager = _engine->getTransformManager();
+    transformManager.openLocalTransformTransaction();
+    for(size_t i = 0; i < anim.mBakedInstances.size(); i++) {
+        transformManager.setTransform(anim.mBakedInstances[i], anim.mBakedTransforms[i]);
+    }
+    transformManager.commitLocalTransformTransaction();
+}
+
+void AssetManager::setAnimationBaking(bool enabled, float sampleRate) {
+    if(enabled && sampleRate <= 0) {
+        Log("ERROR: animation baking sample rate must be greater than zero.");
+        return;
+    }
+    std::lock_guard lock(_animationMutex);
+    _animationBakingEnabled = enabled;
+    _animationBakingRate = sampleRate;
+}
+
+void AssetManager::runSampleJob(const AnimationSampleJob& job) {
+    if(job.animation) {
+        sampleAnimation(*job.asset, *job.animation);
+    } else {
+        sampleLayers(*job.asset);
+    }
+}
+
+// only samples each layer's clip (which can run on any thread); the layers are blended on the render thread by blendLayers,
+// once the pose they're blended over has been committed
+void AssetManager::sampleLayers(SceneAsset& asset) {
+    for(auto& layer : asset.mLayerStack.mLayers) {
+        if(!layer.mClip || layer.mWeight <= 0) {
+            continue;
+        }
+        auto& clip = *layer.mClip;
+        const size_t numLayerNodes = clip.nodes.size();
+        const size_t frameSize = numLayerNodes * BoneTrack::COMPONENT_COUNT;
+        float* const from = layer.mFrames.data();
+        float* const to = from + frameSize;
+        clip.decodeFrame(layer.mFrame, from);
+        clip.decodeFrame(layer.mNextFrame, to);
+        interpolateBoneTracks(from, to, layer.mAlpha, numLayerNodes, layer.mPose.data());
+        for(size_t i = 0; i < numLayerNodes; i++) {
+            layer.mWeights[i] = layer.mWeight * (layer.mMask.empty() ? 1.0f : layer.mMask[clip.nodes[i]]);
+        }
+    }
+}
+
+static void setNodePose(float* const pose, size_t numNodes, size_t node, const math::mat4f& transform) {
+    math::float3 translation, scale;
+    math::quatf rotation;
+    decomposeMatrix(transform, &translation, &rotation, &scale);
+    pose[BoneTrack::TX * numNodes + node] = translation.x;
+    pose[BoneTrack::TY * numNodes + node] = translation.y;
+    pose[BoneTrack::TZ * numNodes + node] = translation.z;
+    setBoneRotation(pose, numNodes, node, normalize(rotation));
+    pose[BoneTrack::SX * numNodes + node] = scale.x;
+    pose[BoneTrack::SY * numNodes + node] = scale.y;
+    pose[BoneTrack::SZ * numNodes + node] = scale.z;
+}
+
+void AssetManager::captureRestPose(SceneAsset& asset) {
+    auto& tm = _engine->getTransformManager();
+    auto& stack = asset.mLayerStack;
+    const size_t numNodes = asset.mAsset->getEntityCount();
+    const Entity* entities = asset.mAsset->getEntities();
+    stack.mInstances.resize(numNodes);
+    stack.mRestTransforms.resize(numNodes);
+    for(size_t i = 0; i < numNodes; i++) {
+        stack.mInstances[i] = tm.getInstance(entities[i]);
+        stack.mRestTransforms[i] = stack.mInstances[i] ? tm.getTransform(stack.mInstances[i]) : math::mat4f();
+    }
+}
+
+void AssetManager::restoreLayerNodes(SceneAsset& asset) {
+    auto& stack = asset.mLayerStack;
+    TransformManager &transformManager = _engine->getTransformManager();
+    transformManager.openLocalTransformTransaction();
+    for(size_t node = 0; node < stack.mTouched.size(); node++) {
+        if(stack.mTouched[node] & 1) {
+            transformManager.setTransform(stack.mInstances[node], stack.mRestTransforms[node]);
+        }
+    }
+    transformManager.commitLocalTransformTransaction();
+}
+
+bool AssetManager::blendLayers(SceneAsset& asset, bool overAnimations) {
+    auto& stack = asset.mLayerStack;
+    if(stack.mRestPose.empty()) {
+        // no layer has been baked yet
+        return false;
+    }
+    const size_t numNodes = stack.mRestTransforms.size();
+    float* const pose = stack.mPose.data();
+    TransformManager &transformManager = _engine->getTransformManager();
+
+    // bit 0 of mTouched is set for nodes touched by the previous blend, bit 1 for nodes touched by this one
+    for(auto& layer : stack.mLayers) {
+        if(!layer.mClip || layer.mWeight <= 0) {
+            continue;
+        }
+        const auto& nodes = layer.mClip->nodes;
+        for(size_t i = 0; i < nodes.size(); i++) {
+            if(layer.mWeights[i] > 0) {
+                stack.mTouched[nodes[i]] |= 2;
+            }
+        }
+    }
+
+    // the blend starts from the pose committed by the animations (if any), otherwise from the rest pose
+    if(overAnimations) {
+        for(size_t node = 0; node < numNodes; node++) {
+            if(stack.mTouched[node] & 2) {
+                setNodePose(pose, numNodes, node, transformManager.getTransform(stack.mInstances[node]));
+            }
+        }
+    } else {
+        std::copy(stack.mRestPose.begin(), stack.mRestPose.end(), pose);
+    }
+
+    for(auto& layer : stack.mLayers) {
+        if(!layer.mClip || layer.mWeight <= 0) {
+            continue;
+        }
+        auto& clip = *layer.mClip;
+        if(layer.mAdditive) {
+            blendLayerAdditive(pose, numNodes, layer.mPose.data(), layer.mReference.data(), clip.nodes.data(), clip.nodes.size(), layer.mWeights.data());
+        } else {
+            blendLayerOverride(pose, numNodes, layer.mPose.data(), clip.nodes.data(), clip.nodes.size(), layer.mWeights.data());
+        }
+    }
+
+    bool written = false;
+    stack.mNumTouched = 0;
+    transformManager.openLocalTransformTransaction();
+    for(uint32_t node = 0; node < numNodes; node++) {
+        if(stack.mTouched[node] & 2) {
+            transformManager.setTransform(stack.mInstances[node], composeBoneTransform(pose, numNodes, node));
+            stack.mNumTouched++;
+            written = true;
+        } else if((stack.mTouched[node] & 1) && !overAnimations) {
+            // no longer affected by any layer (when blended over animations, this was done by restoreLayerNodes)
+            transformManager.setTransform(stack.mInstances[node], stack.mRestTransforms[node]);
+            written = true;
+        }
+        stack.mTouched[node] >>= 1;
+    }
+    transformManager.commitLocalTransformTransaction();
+    return written;
+}
+
+void AssetManager::bakeLayer(SceneAsset& asset, AnimationLayer& layer) {
+    layer.mBake = false;
+    if(asset.mUri.empty()) {
+        Log("ERROR: animation layers are only supported for assets loaded from a path.");
+        return;
+    }
+    auto& tm = _engine->getTransformManager();
+    auto& stack = asset.mLayerStack;
+
+    if(stack.mRestPose.empty()) {
+        // decomposed from the transforms captured when the asset was loaded
+        const size_t numNodes = stack.mRestTransforms.size();
+        stack.mRestPose.resize(numNodes * BoneTrack::COMPONENT_COUNT);
+        for(size_t i = 0; i < numNodes; i++) {
+            setNodePose(stack.mRestPose.data(), numNodes, i, stack.mRestTransforms[i]);
+        }
+        stack.mPose.resize(stack.mRestPose.size());
+        stack.mTouched.assign(numNodes, 0);
+    }
+
+    layer.mClip = _clipCache.getOrBake(asset.mUri, layer.mClipIndex, asset.mAsset, asset.mAnimator, tm, _animationBakingRate);
+    if(!layer.mClip) {
+        Log("ERROR: failed to bake animation %d for layer %d", layer.mClipIndex, layer.mId);
+        return;
+    }
+    const size_t numLayerNodes = layer.mClip->nodes.size();
+    layer.mFrames.resize(2 * numLayerNodes * BoneTrack::COMPONENT_COUNT);
+    layer.mPose.resize(numLayerNodes * BoneTrack::COMPONENT_COUNT);
+    layer.mWeights.resize(numLayerNodes);
+    layer.mReference.resize(numLayerNodes * BoneTrack::COMPONENT_COUNT);
+    layer.mClip->decodeFrame(0, layer.mReference.data());
+    stack.mDirty = true;
+}
+
+AnimationLayer* AssetManager::getAnimationLayer(EntityId entityId, int layerId) {
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return nullptr;
+    }
+    auto& stack = _assets[pos->second].mLayerStack;
+    for(auto& layer : stack.mLayers) {
+        if(layer.mId == layerId) {
+            return &layer;
+        }
+    }
+    Log("ERROR: animation layer %d not found.", layerId);
+    return nullptr;
+}
+
+int AssetManager::addAnimationLayer(EntityId entityId, int clipIndex, float weight, bool additive, bool loop) {
+    std::lock_guard lock(_animationMutex);
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return -1;
+    }
+    auto& asset = _assets[pos->second];
+    if(clipIndex < 0 || clipIndex >= (int)asset.mAnimator->getAnimationCount()) {
+        Log("ERROR: glTF animation index %d is out of range.", clipIndex);
+        return -1;
+    }
+    auto& stack = asset.mLayerStack;
+    AnimationLayer layer;
+    layer.mId = stack.mNextLayerId++;
+    layer.mClipIndex = clipIndex;
+    layer.mWeight = std::clamp(weight, 0.0f, 1.0f);
+    layer.mAdditive = additive;
+    layer.mLoop = loop;
+    stack.mLayers.push_back(layer);
+    stack.mDirty = true;
+    return layer.mId;
+}
+
+bool AssetManager::removeAnimationLayer(EntityId entityId, int layerId) {
+    std::lock_guard lock(_animationMutex);
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return false;
+    }
+    auto& asset = _assets[pos->second];
+    auto& stack = asset.mLayerStack;
+    auto it = std::find_if(stack.mLayers.begin(), stack.mLayers.end(), [=](const AnimationLayer& layer) { return layer.mId == layerId; });
+    if(it == stack.mLayers.end()) {
+        Log("ERROR: animation layer %d not found.", layerId);
+        return false;
+    }
+    if(asset.mStateMachine && it < stack.mLayers.begin() + asset.mStateMachine->getNumLayers()) {
+        Log("ERROR: animation layer %d is owned by the animation state machine.", layerId);
+        return false;
+    }
+    // nodes this layer affected are restored the next time the layers are blended
+    stack.mLayers.erase(it);
+    stack.mDirty = true;
+    return true;
+}
+
+bool AssetManager::setAnimationLayerWeight(EntityId entityId, int layerId, float weight) {
+    std::lock_guard lock(_animationMutex);
+    auto* layer = getAnimationLayer(entityId, layerId);
+    if(!layer) {
+        return false;
+    }
+    layer->mWeight = std::clamp(weight, 0.0f, 1.0f);
+    _assets[_entityIdLookup[entityId]].mLayerStack.mDirty = true;
+    return true;
+}
+
+bool AssetManager::setAnimationLayerTime(EntityId entityId, int layerId, float timeInSecs) {
+    std::lock_guard lock(_animationMutex);
+    auto* layer = getAnimationLayer(entityId, layerId);
+    if(!layer) {
+        return false;
+    }
+    layer->mTime = timeInSecs;
+    return true;
+}
+
+bool AssetManager::setAnimationLayerSpeed(EntityId entityId, int layerId, float speed) {
+    std::lock_guard lock(_animationMutex);
+    auto* layer = getAnimationLayer(entityId, layerId);
+    if(!layer) {
+        return false;
+    }
+    layer->mSpeed = speed;
+    return true;
+}
+
+bool AssetManager::setAnimationLayerMask(EntityId entityId, int layerId, const char** const jointNames, const float* const weights, int count, bool includeDescendants) {
+    std::lock_guard lock(_animationMutex);
+    auto* layer = getAnimationLayer(entityId, layerId);
+    if(!layer) {
+        return false;
+    }
+    auto& asset = _assets[_entityIdLookup[entityId]];
+    asset.mLayerStack.mDirty = true;
+    if(count <= 0) {
+        layer->mMask.clear();
+        return true;
+    }
+
+    std::unordered_map<std::string, float> maskWeights;
+    for(int i = 0; i < count; i++) {
+        maskWeights[jointNames[i]] = std::clamp(weights[i], 0.0f, 1.0f);
+    }
+
+    // each node takes the weight of the nearest listed node among itself and (if includeDescendants) its ancestors; anything else is excluded
+    auto& tm = _engine->getTransformManager();
+    const size_t numNodes = asset.mAsset->getEntityCount();
+    const Entity* entities = asset.mAsset->getEntities();
+    layer->mMask.assign(numNodes, 0.0f);
+    size_t numMatched = 0;
+    for(size_t i = 0; i < numNodes; i++) {
+        Entity entity = entities[i];
+        while(!entity.isNull()) {
+            auto nameInstance = _ncm->getInstance(entity);
+            const char* name = nameInstance.isValid() ? _ncm->getName(nameInstance) : nullptr;
+            auto match = name ? maskWeights.find(name) : maskWeights.end();
+            if(match != maskWeights.end()) {
+                layer->mMask[i] = match->second;
+                numMatched += entity == entities[i];
+                break;
+            }
+            if(!includeDescendants) {
+                break;
+            }
+            auto instance = tm.getInstance(entity);
+            entity = instance ? tm.getParent(instance) : Entity();
+        }
+    }
+    if(numMatched < maskWeights.size()) {
+        Log("Warning: %d of the joints in the mask for layer %d could not be found.", (int)(maskWeights.size() - numMatched), layerId);
+    }
+    return true;
+}
+
+AnimationStateMachine* AssetManager::getStateMachine(EntityId entityId, bool create) {
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return nullptr;
+    }
+    auto& asset = _assets[pos->second];
+    if(!asset.mStateMachine) {
+        if(!create) {
+            Log("ERROR: asset has no animation state machine.");
+            return nullptr;
+        }
+        asset.mStateMachine = std::make_shared<AnimationStateMachine>();
+    }
+    return asset.mStateMachine.get();
+}
+
+int AssetManager::addAnimationStateParameter(EntityId entityId, const char* name, float value) {
+    std::lock_guard lock(_animationMutex);
+    auto* machine = getStateMachine(entityId, true);
+    if(!machine) {
+        return -1;
+    }
+    machine->mParameterNames.push_back(name ? name : "");
+    machine->mParameters.push_back(value);
+    return (int)machine->mParameters.size() - 1;
+}
+
+int AssetManager::addAnimationState(EntityId entityId, const char* name, const int* const clipIndices, const float* const thresholds, int numClips, int blendParameter, float speed, bool loop) {
+    std::lock_guard lock(_animationMutex);
+    if(numClips <= 0) {
+        Log("ERROR: an animation state must play at least one animation.");
+        return -1;
+    }
+    auto* machine = getStateMachine(entityId, true);
+    if(!machine) {
+        return -1;
+    }
+    if(numClips > 1) {
+        if(blendParameter < 0 || blendParameter >= (int)machine->mParameters.size()) {
+            Log("ERROR: blend parameter %d not found.", blendParameter);
+            return -1;
+        }
+        if(!thresholds || !std::is_sorted(thresholds, thresholds + numClips)) {
+            Log("ERROR: the thresholds of a blended state must be ascending.");
+            return -1;
+        }
+    }
+    auto* animator = _assets[_entityIdLookup[entityId]].mAnimator;
+    AnimationState state;
+    state.mName = name ? name : "";
+    for(int i = 0; i < numClips; i++) {
+        if(clipIndices[i] < 0 || clipIndices[i] >= (int)animator->getAnimationCount()) {
+            Log("ERROR: glTF animation index %d is out of range.", clipIndices[i]);
+            return -1;
+        }
+        state.mClipIndices.push_back(clipIndices[i]);
+        state.mThresholds.push_back(numClips > 1 ? thresholds[i] : 0.0f);
+        state.mDurations.push_back(animator->getAnimationDuration(clipIndices[i]));
+    }
+    state.mBlendParameter = numClips > 1 ? blendParameter : -1;
+    state.mSpeed = speed;
+    state.mLoop = loop;
+    machine->mStates.push_back(std::move(state));
+    return (int)machine->mStates.size() - 1;
+}
+
+int AssetManager::addAnimationStateTransition(EntityId entityId, int fromState, int toState, float crossfadeInSecs, float exitTime, const int* const parameters, const int* const ops, const float* const values, int numConditions) {
+    std::lock_guard lock(_animationMutex);
+    auto* machine = getStateMachine(entityId, false);
+    if(!machine) {
+        return -1;
+    }
+    const int numStates = (int)machine->mStates.size();
+    if(fromState < -1 || fromState >= numStates || toState < 0 || toState >= numStates) {
+        Log("ERROR: transition from state %d to state %d is out of range.", fromState, toState);
+        return -1;
+    }
+    StateTransition transition;
+    transition.mFrom = fromState;
+    transition.mTo = toState;
+    transition.mDuration = std::max(crossfadeInSecs, 0.0f);
+    transition.mExitTime = exitTime;
+    for(int i = 0; i < numConditions; i++) {
+        if(parameters[i] < 0 || parameters[i] >= (int)machine->mParameters.size()) {
+            Log("ERROR: transition parameter %d not found.", parameters[i]);
+            return -1;
+        }
+        if(ops[i] < (int)TransitionConditionOp::GREATER || ops[i] > (int)TransitionConditionOp::TRIGGER) {
+            Log("ERROR: unknown transition condition %d.", ops[i]);
+            return -1;
+        }
+        transition.mConditions.push_back({ parameters[i], (TransitionConditionOp)ops[i], values ? values[i] : 0.0f });
+    }
+    machine->mTransitions.push_back(std::move(transition));
+    return (int)machine->mTransitions.size() - 1;
+}
+
+bool AssetManager::setAnimationStateParameter(EntityId entityId, int parameter, float value) {
+    std::lock_guard lock(_animationMutex);
+    auto* machine = getStateMachine(entityId, false);
+    if(!machine) {
+        return false;
+    }
+    if(parameter < 0 || parameter >= (int)machine->mParameters.size()) {
+        Log("ERROR: animation state parameter %d not found.", parameter);
+        return false;
+    }
+    // transitions and blend weights pick this up on the next frame
+    machine->mParameters[parameter] = value;
+    return true;
+}
+
+bool AssetManager::setAnimationState(EntityId entityId, int state, float crossfadeInSecs) {
+    std::lock_guard lock(_animationMutex);
+    auto* machine = getStateMachine(entityId, false);
+    if(!machine) {
+        return false;
+    }
+    if(state < 0 || state >= (int)machine->mStates.size()) {
+        Log("ERROR: animation state %d not found.", state);
+        return false;
+    }
+    enterAnimationState(_assets[_entityIdLookup[entityId]], state, crossfadeInSecs);
+    return true;
+}
+
+int AssetManager::getAnimationState(EntityId entityId) {
+    std::lock_guard lock(_animationMutex);
+    auto* machine = getStateMachine(entityId, false);
+    return machine ? machine->mCurrent.mState : -1;
+}
+
+bool AssetManager::removeAnimationStateMachine(EntityId entityId) {
+    std::lock_guard lock(_animationMutex);
+    if(!getStateMachine(entityId, false)) {
+        return false;
+    }
+    auto& asset = _assets[_entityIdLookup[entityId]];
+    auto& layers = asset.mLayerStack.mLayers;
+    layers.erase(layers.begin(), layers.begin() + asset.mStateMachine->getNumLayers());
+    asset.mLayerStack.mDirty = true;
+    asset.mStateMachine.reset();
+    return true;
+}
+
+void AssetManager::enterAnimationState(SceneAsset& asset, int stateIndex, float crossfadeInSecs) {
+    auto& machine = *asset.mStateMachine;
+    auto& stack = asset.mLayerStack;
+    auto& layers = stack.mLayers;
+    if(crossfadeInSecs > 0 && machine.mCurrent.mState >= 0) {
+        // a state still being faded out is dropped, and the current state fades out from full weight
+        layers.erase(layers.begin(), layers.begin() + machine.mPrevious.mNumLayers);
+        machine.mPrevious = machine.mCurrent;
+        machine.mFadeElapsed = 0.0f;
+        machine.mFadeDuration = crossfadeInSecs;
+    } else {
+        layers.erase(layers.begin(), layers.begin() + machine.getNumLayers());
+        machine.mPrevious = ActiveAnimationState();
+    }
+
+    // layer times and weights are driven by the state machine each frame
+    const auto& state = machine.mStates[stateIndex];
+    std::vector<AnimationLayer> entering(state.mClipIndices.size());
+    for(size_t i = 0; i < entering.size(); i++) {
+        entering[i].mId = stack.mNextLayerId++;
+        entering[i].mClipIndex = state.mClipIndices[i];
+        entering[i].mWeight = 0.0f;
+        entering[i].mSpeed = 0.0f;
+        entering[i].mLoop = state.mLoop;
+    }
+    layers.insert(layers.begin() + machine.mPrevious.mNumLayers, entering.begin(), entering.end());
+    machine.mCurrent.mState = stateIndex;
+    machine.mCurrent.mNormalizedTime = 0.0f;
+    machine.mCurrent.mNumLayers = entering.size();
+    stack.mDirty = true;
+}
+
+void AssetManager::updateStateMachine(SceneAsset& asset, float deltaInSecs) {
+    auto& machine = *asset.mStateMachine;
+    if(machine.mCurrent.mState < 0) {
+        return;
+    }
+    const int transitionIndex = findTransition(machine);
+    if(transitionIndex >= 0) {
+        const auto& transition = machine.mTransitions[transitionIndex];
+        for(const auto& condition : transition.mConditions) {
+            if(condition.mOp == TransitionConditionOp::TRIGGER) {
+                machine.mParameters[condition.mParameter] = 0.0f;
+            }
+        }
+        enterAnimationState(asset, transition.mTo, transition.mDuration);
+    }
+
+    float fade = 1.0f;
+    if(machine.mPrevious.mState >= 0) {
+        machine.mFadeElapsed += deltaInSecs;
+        if(machine.mFadeElapsed >= machine.mFadeDuration) {
+            auto& layers = asset.mLayerStack.mLayers;
+            layers.erase(layers.begin(), layers.begin() + machine.mPrevious.mNumLayers);
+            machine.mPrevious = ActiveAnimationState();
+            asset.mLayerStack.mDirty = true;
+        } else {
+            fade = machine.mFadeElapsed / machine.mFadeDuration;
+        }
+    }
+
+    size_t layerIndex = 0;
+    float totalWeight = 0.0f;
+    advanceAnimationState(asset, machine.mPrevious, 1.0f - fade, deltaInSecs, layerIndex, totalWeight);
+    advanceAnimationState(asset, machine.mCurrent, fade, deltaInSecs, layerIndex, totalWeight);
+}
+
+void AssetManager::advanceAnimationState(SceneAsset& asset, ActiveAnimationState& active, float stateWeight, float deltaInSecs, size_t& layerIndex, float& totalWeight) {
+    if(active.mState < 0) {
+        return;
+    }
+    auto& machine = *asset.mStateMachine;
+    auto& stack = asset.mLayerStack;
+    const auto& state = machine.mStates[active.mState];
+    const size_t numMotions = state.mClipIndices.size();
+    machine.mMotionWeights.resize(numMotions);
+    getMotionWeights(state, machine.mParameters, machine.mMotionWeights.data());
+
+    // every animation advances at the same normalized rate (set by the weighted average of their durations) so blended animations stay in step
+    float duration = 0.0f;
+    for(size_t i = 0; i < numMotions; i++) {
+        duration += machine.mMotionWeights[i] * state.mDurations[i];
+    }
+    if(duration > 0) {
+        active.mNormalizedTime += deltaInSecs * state.mSpeed / duration;
+    }
+    if(state.mLoop) {
+        active.mNormalizedTime -= std::floor(active.mNormalizedTime);
+    } else {
+        active.mNormalizedTime = std::clamp(active.mNormalizedTime, 0.0f, 1.0f);
+    }
+
+    for(size_t i = 0; i < numMotions; i++) {
+        auto& layer = stack.mLayers[layerIndex++];
+        layer.mTime = active.mNormalizedTime * state.mDurations[i];
+        // override layers blend in order, each interpolating from the result so far, so weighting each by its share of the running
+        // total gives every layer exactly its desired share of the final pose
+        const float desired = stateWeight * machine.mMotionWeights[i];
+        totalWeight += desired;
+        const float weight = totalWeight > 0 ? desired / totalWeight : 0.0f;
+        if(weight != layer.mWeight) {
+            layer.mWeight = weight;
+            stack.mDirty = true;
+        }
+    }
+}
+
+void AssetManager::sampleAnimations() {
+    const size_t numJobs = _animationSampleJobs.size();
+    if(numJobs == 0) {
+        return;
+    }
+
+    // not worth waking other threads for a handful of animations
+    const size_t numWorkers = numJobs < kMinParallelAnimationJobs ? 0 : std::max(1u, std::thread::hardware_concurrency()) - 1;
+    if(numWorkers == 0) {
+        for(auto& job : _animationSampleJobs) {
+            runSampleJob(job);
+        }
+        return;
+    }
+
+    if(!_animationWorkers) {
+        _animationWorkers = new WorkerPool(numWorkers);
+    }
+
+    // this thread and the workers each claim the next job until none are left; nothing is allocated per frame
+    auto sample = [this](size_t job) {
+        runSampleJob(_animationSampleJobs[job]);
+    };
+    _animationWorkers->run(numJobs, sample);
+}
+
+void AssetManager::setAnimationTimeScale(float timeScale) {
+    if(timeScale < 0) {
+        Log("ERROR: animation time scale must not be negative (use reverse playback instead).");
+        return;
+    }
+    std::lock_guard lock(_animationMutex);
+    _animationTimeScale = timeScale;
+}
+
+bool AssetManager::setAnimationTimeScale(EntityId entityId, float timeScale) {
+    if(timeScale < 0) {
+        Log("ERROR: animation time scale must not be negative (use reverse playback instead).");
+        return false;
+    }
+    std::lock_guard lock(_animationMutex);
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return false;
+    }
+    _assets[pos->second].mTimeScale = timeScale;
+    return true;
+}
+
+void AssetManager::setAnimationsPaused(bool paused) {
+    std::lock_guard lock(_animationMutex);
+    _animationsPaused = paused;
+}
+
+bool AssetManager::setAnimationsPaused(EntityId entityId, bool paused) {
+    std::lock_guard lock(_animationMutex);
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return false;
+    }
+    _assets[pos->second].mPaused = paused;
+    return true;
+}
+
+void AssetManager::setFixedAnimationTimestep(float timestepInSecs) {
+    std::lock_guard lock(_animationMutex);
+    _fixedAnimationTimestep = std::max(timestepInSecs, 0.0f);
+}
+
+void AssetManager::setBoneTransform(SceneAsset& asset) {
+    
+    auto& buffer = asset.mBoneAnimationBuffer;
+    const auto& jointInstances = buffer.mRetargetMap->mJointInstances;
+    TransformManager &transformManager = _engine->getTransformManager();
+    
+    // defer updating world transforms until every joint has been set, rather than walking the hierarchy once per joint
+    transformManager.openLocalTransformTransaction();
+    for(size_t i = 0; i < jointInstances.size(); i++) {
+        // bones the asset has no joint for are skipped
+        if(jointInstances[i]) {
+            transformManager.setTransform(jointInstances[i], buffer.mTransforms[i]);
+        }
+    }
+    transformManager.commitLocalTransformTransaction();
+}
+
+void AssetManager::remove(EntityId entityId) {
+    // live pose streams are created (and their assets looked up) from other threads
+    std::lock_guard lock(_animationMutex);
+    const auto pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("Couldn't find asset under specified entity id.");
+        return;
+    }
+    const int index = pos->second;
+    // copied, as the asset is moved (or destroyed) when it's erased below
+    const SceneAsset& sceneAsset = _assets[index];
+    FilamentAsset* const asset = sceneAsset.mAsset;
+    filament::Texture* const texture = sceneAsset.mTexture;
+    AssetLoader* const loader = getLoaderForAsset(sceneAsset);
+    const std::string uri = sceneAsset.mUri;
+    _retargetCache.removeTarget(entityId);
+    publishMetadata(std::atomic_load(&_metadata)->without(entityId));
+    // these use the asset's materials
+    removeInstancedMeshes(entityId);
+
+    _assets.erase(_assets.begin() + index);
+    _entityIdLookup.erase(entityId);
+    // every asset after the one removed has moved down a slot
+    for(auto it = _entityIdLookup.begin(); it != _entityIdLookup.end(); ++it) {
+        if(it->second > index) {
+            it.value()--;
+        }
+    }
+    
+    _scene->removeEntities(asset->getEntities(), asset->getEntityCount());
+    
+    _scene->removeEntities(asset->getLightEntities(), asset->getLightEntityCount());
+    
+    loader->destroyAsset(asset);
+    
+    if(texture) {
+        _engine->destroy(texture);
+    }
+    EntityManager& em = EntityManager::get();
+    em.destroy(Entity::import(entityId));
+
+    // baked animations are kept for as long as any asset loaded from the same source is
+    if(!uri.empty() && std::none_of(_assets.begin(), _assets.end(), [&](const SceneAsset& asset) { return asset.mUri == uri; })) {
+        _clipCache.remove(uri);
+        for(auto it = _clipBounds.begin(); it != _clipBounds.end();) {
+            it = it->first.first == uri ? _clipBounds.erase(it) : std::next(it);
+        }
+    }
+
+}
+
+void AssetManager::setMorphTargetWeights(EntityId entityId, const char* const entityName, const float* const weights, const int count) {
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return;
+    }
+    auto& asset = _assets[pos->second];
+    
+    auto entity = findEntityByName(asset, entityName);
+    if(!entity) {
+        Log("Warning: failed to find entity %s", entityName);
+        return;
+    }
+    
+    RenderableManager &rm = _engine->getRenderableManager();
+
+    auto renderableInstance = rm.getInstance(entity);
+
+    if(!renderableInstance.isValid()) {
+        Log("Warning: failed to find renderable instance for entity %s", entityName);
+        return;
+    }
+    
+    rm.setMorphWeights(
+                       renderableInstance,
+                       weights,
+                       count
+                       );
+}
+
+utils::Entity AssetManager::findEntityByName(const SceneAsset& asset, const char* entityName) {
+    utils::Entity entity;
+    for (size_t i = 0, c = asset.mAsset->getEntityCount(); i != c; ++i) {
+        auto entity = asset.mAsset->getEntities()[i];
+        auto nameInstance = _ncm->getInstance(entity);
+        if(!nameInstance.isValid()) {
+            continue;
+        }
+        auto name = _ncm->getName(nameInstance);
+        if(!name) {
+            continue;
+        }
+        if(strcmp(entityName,name)==0) {
+            return entity;
+        }
+    }
+    return entity;
+}
+
+// gltfio names the entity of each node after the node (or its mesh, if the node has no name)
+static const char* getSourceNodeName(const cgltf_node& node) {
+    if(node.name) {
+        return node.name;
+    }
+    return node.mesh ? node.mesh->name : nullptr;
+}
+
+cgltf_data* AssetManager::loadSourceAsset(const SceneAsset& asset, const ResourceBuffer& rbuf, vector<ResourceBuffer>& resourceBuffers) {
+    if(!rbuf.data || rbuf.size == 0) {
+        Log("ERROR: failed to load %s", asset.mUri.c_str());
+        return nullptr;
+    }
+    cgltf_options options {};
+    cgltf_data* data = nullptr;
+    if(cgltf_parse(&options, rbuf.data, rbuf.size, &data) != cgltf_result_success) {
+        Log("ERROR: failed to parse %s", asset.mUri.c_str());
+        return nullptr;
+    }
+    // external buffers are loaded the same way as in loadGltf; the GLB chunk and data URIs are read by cgltf
+    for(size_t i = 0; i < data->buffers_count; i++) {
+        cgltf_buffer& buffer = data->buffers[i];
+        if(!buffer.uri || strncmp(buffer.uri, "data:", 5) == 0) {
+            continue;
+        }
+        string uri = asset.mResourcePath.empty() ? string(buffer.uri) : asset.mResourcePath + string("/") + string(buffer.uri);
+        ResourceBuffer buf = _resourceLoaderWrapper->load(uri.c_str());
+        resourceBuffers.push_back(buf);
+        if(!buf.data || (size_t)buf.size < buffer.size) {
+            Log("ERROR: failed to load buffer %s", uri.c_str());
+            cgltf_free(data);
+            return nullptr;
+        }
+        buffer.data = const_cast<void*>(buf.data);
+        buffer.data_free_method = cgltf_data_free_method_none;
+    }
+    if(cgltf_load_buffers(&options, data, nullptr) != cgltf_result_success) {
+        Log("ERROR: failed to load the buffers of %s", asset.mUri.c_str());
+        cgltf_free(data);
+        return nullptr;
+    }
+    return data;
+}
+
+EntityId AssetManager::addInstancedMesh(EntityId assetId, const cgltf_mesh* mesh, int primitiveIndex, utils::Entity source, utils::Entity parent, const math::mat4f* transforms, size_t count) {
+    RenderableManager& rm = _engine->getRenderableManager();
+    TransformManager& tm = _engine->getTransformManager();
+    const auto renderable = rm.getInstance(source);
+    if(!renderable.isValid()) {
+        Log("ERROR: the mesh to instance has no renderable.");
+        return 0;
+    }
+    InstancedMesh instanced;
+    if(!createInstancedPrimitives(instanced, mesh, primitiveIndex, renderable, *_engine)) {
+        return 0;
+    }
+    instanced.mAsset = assetId;
+    instanced.mRoot = EntityManager::get().create();
+    tm.create(instanced.mRoot, tm.getInstance(parent));
+    createInstancedRenderables(instanced, transforms, count, *_engine, *_scene);
+    const EntityId id = Entity::smuggle(instanced.mRoot);
+    Log("Drawing %zu instances of %s with %zu renderables", count, mesh->name ? mesh->name : "mesh", instanced.mRenderables.size());
+    _instancedMeshes.emplace(id, std::move(instanced));
+    return id;
+}
+
+void AssetManager::addGpuInstancedNodes(const SceneAsset& asset, EntityId assetId) {
+    // only available until the source data is released
+    const cgltf_data* data = static_cast<const cgltf_data*>(asset.mAsset->getSourceAsset());
+    if(!data) {
+        return;
+    }
+    vector<math::mat4f> transforms;
+    for(size_t i = 0; i < data->nodes_count; i++) {
+        const cgltf_node& node = data->nodes[i];
+        if(!readMeshGpuInstancing(data, &node, transforms)) {
+            continue;
+        }
+        const char* name = getSourceNodeName(node);
+        const auto entity = name ? findEntityByName(asset, name) : utils::Entity();
+        if(entity.isNull()) {
+            Log("ERROR: can't instance unnamed node %zu", i);
+            continue;
+        }
+        // gltfio draws the mesh once at the node, so that copy is replaced by the instances (which are relative to the node)
+        if(addInstancedMesh(assetId, node.mesh, -1, entity, entity, transforms.data(), transforms.size())) {
+            _scene->remove(entity);
+        }
+    }
+}
+
+EntityId AssetManager::createInstancedMesh(EntityId entityId, const char* meshName, int primitiveIndex, const float* const transforms, int count) {
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return 0;
+    }
+    if(count <= 0) {
+        Log("ERROR: at least one instance is required.");
+        return 0;
+    }
+    const auto& asset = _assets[pos->second];
+    const auto source = findEntityByName(asset, meshName);
+    if(source.isNull()) {
+        Log("Mesh %s could not be found", meshName);
+        return 0;
+    }
+
+    // gltfio releases the glTF once loaded (and doesn't expose the buffers it created), so the geometry is read from the source again
+    if(asset.mUri.empty()) {
+        Log("ERROR: instanced meshes are only supported for assets loaded from a path.");
+        return 0;
+    }
+    ResourceBuffer rbuf = _resourceLoaderWrapper->load(asset.mUri.c_str());
+    vector<ResourceBuffer> resourceBuffers;
+    EntityId id = 0;
+    if(cgltf_data* data = loadSourceAsset(asset, rbuf, resourceBuffers)) {
+        const cgltf_mesh* mesh = nullptr;
+        for(size_t i = 0; i < data->nodes_count && !mesh; i++) {
+            const char* name = getSourceNodeName(data->nodes[i]);
+            if(data->nodes[i].mesh && name && strcmp(name, meshName) == 0) {
+                mesh = data->nodes[i].mesh;
+            }
+        }
+        if(!mesh) {
+            Log("ERROR: no glTF node with a mesh is named %s", meshName);
+        } else {
+            // column-major, as mat4f is laid out
+            id = addInstancedMesh(entityId, mesh, primitiveIndex, source, asset.mAsset->getRoot(), reinterpret_cast<const math::mat4f*>(transforms), count);
+        }
+        cgltf_free(data);
+    }
+    for(auto& rb : resourceBuffers) {
+        _resourceLoaderWrapper->free(rb);
+    }
+    _resourceLoaderWrapper->free(rbuf);
+    return id;
+}
+
+bool AssetManager::setInstanceTransforms(EntityId instancedMesh, const float* const transforms, int offset, int count) {
+    auto it = _instancedMeshes.find(instancedMesh);
+    if(it == _instancedMeshes.end()) {
+        Log("ERROR: instanced mesh not found for entity.");
+        return false;
+    }
+    auto& mesh = it.value();
+    if(offset < 0 || count <= 0 || (size_t)(offset + count) > mesh.mTransforms.size()) {
+        Log("ERROR: instances [%d, %d) are out of range (there are %zu).", offset, offset + count, mesh.mTransforms.size());
+        return false;
+    }
+    polyvox::setInstanceTransforms(mesh, reinterpret_cast<const math::mat4f*>(transforms), offset, count, *_engine);
+    return true;
+}
+
+bool AssetManager::removeInstancedMesh(EntityId instancedMesh) {
+    auto it = _instancedMeshes.find(instancedMesh);
+    if(it == _instancedMeshes.end()) {
+        Log("ERROR: instanced mesh not found for entity.");
+        return false;
+    }
+    destroyInstancedMesh(it.value(), *_engine, *_scene);
+    _instancedMeshes.erase(it);
+    return true;
+}
+
+void AssetManager::removeInstancedMeshes(EntityId assetId) {
+    // collected first and erased by key, as assigning robin_map iterators is deprecated
+    vector<EntityId> removed;
+    for(auto it = _instancedMeshes.begin(); it != _instancedMeshes.end(); ++it) {
+        if(it->second.mAsset == assetId) {
+            removed.push_back(it->first);
+        }
+    }
+    for(const EntityId id : removed) {
+        destroyInstancedMesh(_instancedMeshes.at(id), *_engine, *_scene);
+        _instancedMeshes.erase(id);
+    }
+}
+
+void AssetManager::setAnimationCompression(bool enabled, float maxError) {
+    std::lock_guard lock(_animationMutex);
+    _animationCompressionEnabled = enabled;
+    _animationCompressionMaxError = std::max(maxError, 0.0f);
+}
+
+bool AssetManager::setMorphAnimationBuffer(
+                                           EntityId entityId,
+                                           const char* entityName,
+                                           const float* const morphData,
+                                           const int* const morphIndices,
+                                           int numMorphTargets,
+                                           int numFrames,
+                                           float frameLengthInMs) {
+    bool compress;
+    float maxError;
+    {
+        std::lock_guard lock(_animationMutex);
+        compress = _animationCompressionEnabled;
+        maxError = _animationCompressionMaxError;
     }
-    EntityManager& em = EntityManager::get();
-    em.destroy(Entity::import(entityId));
-
-
+    shared_ptr<const CompressedMorphTracks> compressed;
+    if(compress && numFrames > 0 && numMorphTargets > 0) {
+        compressed = CompressedMorphTracks::compress(morphData, numFrames, numMorphTargets, frameLengthInMs, maxError);
+    }
+    return setMorphAnimationBuffer(entityId, entityName, compressed ? nullptr : morphData, compressed, nullptr, morphIndices, numMorphTargets, numFrames, frameLengthInMs);
 }
 
-void AssetManager::setMorphTargetWeights(EntityId entityId, const char* const entityName, const float* const weights, const int count) {
-    const auto& pos = _entityIdLookup.find(entityId);
-    if(pos == _entityIdLookup.end()) {
-        Log("ERROR: asset not found for entity.");
-        return;
-    }
-    auto& asset = _assets[pos->second];
-    
-    auto entity = findEntityByName(asset, entityName);
-    if(!entity) {
-        Log("Warning: failed to find entity %s", entityName);
-        return;
+bool AssetManager::setCompressedMorphAnimationBuffer(
+                                                     EntityId entityId,
+                                                     const char* entityName,
+                                                     const void* const data,
+                                                     size_t size,
+                                                     const int* const morphIndices,
+                                                     int numMorphTargets) {
+    auto compressed = CompressedMorphTracks::deserialize(data, size);
+    if(!compressed) {
+        return false;
     }
-    
-    RenderableManager &rm = _engine->getRenderableManager();
-
-    auto renderableInstance = rm.getInstance(entity);
-
-    if(!renderableInstance.isValid()) {
-        Log("Warning: failed to find renderable instance for entity %s", entityName);
-        return;
+    if((int)compressed->numTargets != numMorphTargets) {
+        Log("ERROR: compressed morph animation has %d targets, but %d morph indices were provided.", compressed->numTargets, numMorphTargets);
+        return false;
     }
-    
-    rm.setMorphWeights(
-                       renderableInstance,
-                       weights,
-                       count
-                       );
+    return setMorphAnimationBuffer(entityId, entityName, nullptr, compressed, nullptr, morphIndices, numMorphTargets, compressed->numFrames, compressed->frameLengthInMs);
 }
 
-utils::Entity AssetManager::findEntityByName(SceneAsset asset, const char* entityName) {
-    utils::Entity entity;
-    for (size_t i = 0, c = asset.mAsset->getEntityCount(); i != c; ++i) {
-        auto entity = asset.mAsset->getEntities()[i];
-        auto nameInstance = _ncm->getInstance(entity);
-        if(!nameInstance.isValid()) {
-            continue;
-        }
-        auto name = _ncm->getName(nameInstance);
-        if(!name) {
-            continue;
-        }
-        if(strcmp(entityName,name)==0) {
-            return entity;
-        }
+bool AssetManager::setMorphAnimationCurves(
+                                           EntityId entityId,
+                                           const char* entityName,
+                                           const int* const morphIndices,
+                                           const int* const interpolations,
+                                           const int* const keyCounts,
+                                           const float* const keys,
+                                           int numCurves) {
+    if(numCurves <= 0) {
+        Log("ERROR: morph animation must contain at least one curve.");
+        return false;
     }
-    return entity;
+    // curve i writes the weight for morphIndices[i]
+    vector<int> targets(numCurves);
+    for(int i = 0; i < numCurves; i++) {
+        targets[i] = i;
+    }
+    auto curves = AnimationCurves::create(targets.data(), interpolations, keyCounts, keys, numCurves, numCurves);
+    if(!curves) {
+        return false;
+    }
+    if(curves->duration <= 0) {
+        Log("ERROR: morph animation curves must span a positive duration.");
+        return false;
+    }
+    // the whole animation is treated as a single "frame", since curves are sampled directly at the playback time
+    return setMorphAnimationBuffer(entityId, entityName, nullptr, nullptr, curves, morphIndices, numCurves, 1, curves->duration * 1000.0f);
 }
 
 bool AssetManager::setMorphAnimationBuffer(
                                            EntityId entityId,
                                            const char* entityName,
                                            const float* const morphData,
+                                           shared_ptr<const CompressedMorphTracks> compressed,
+                                           shared_ptr<const AnimationCurves> curves,
                                            const int* const morphIndices,
                                            int numMorphTargets,
                                            int numFrames,
@@ -482,23 +2473,76 @@ bool AssetManager::setMorphAnimationBuffer(
         return false;
     }
     
-    asset.mMorphAnimationBuffer.mMeshTarget = entity;
-    asset.mMorphAnimationBuffer.mFrameData.clear();
-    asset.mMorphAnimationBuffer.mFrameData.insert(
-                                                  asset.mMorphAnimationBuffer.mFrameData.begin(),
-                                                  morphData,
-                                                  morphData + (numFrames * numMorphTargets)
-                                                  );
-    asset.mMorphAnimationBuffer.mFrameLengthInMs = frameLengthInMs;
-    asset.mMorphAnimationBuffer.mMorphIndices.resize(numMorphTargets);
-    for(int i =0; i< numMorphTargets; i++) {
-        asset.mMorphAnimationBuffer.mMorphIndices[i] = morphIndices[i];
+    RenderableManager& rm = _engine->getRenderableManager();
+    auto renderableInstance = rm.getInstance(entity);
+    if(!renderableInstance.isValid()) {
+        Log("Warning: failed to find renderable instance for entity %s", entityName);
+        return false;
+    }
+
+    if(numFrames <= 0 || numMorphTargets <= 0 || frameLengthInMs <= 0) {
+        Log("ERROR: morph animation must contain at least one frame and one morph target, with a positive frame length.");
+        return false;
+    }
+
+    auto minMax = std::minmax_element(morphIndices, morphIndices + numMorphTargets);
+    if(*minMax.first < 0) {
+        Log("ERROR: morph target indices must not be negative.");
+        return false;
+    }
+
+    // replace any existing animation for the same mesh
+    int bufferIndex = -1;
+    for(size_t i = 0; i < asset.mMorphAnimationBuffers.size(); i++) {
+        if(asset.mMorphAnimationBuffers[i].mMeshTarget == entity) {
+            bufferIndex = i;
+            break;
+        }
+    }
+    if(bufferIndex == -1) {
+        bufferIndex = asset.mMorphAnimationBuffers.size();
+        asset.mMorphAnimationBuffers.emplace_back();
+    } else {
+        asset.mAnimations.erase(std::remove_if(asset.mAnimations.begin(),
+                                               asset.mAnimations.end(),
+                                               [=](AnimationStatus& anim) { return anim.type == AnimationType::MORPH && anim.morphBufferIndex == bufferIndex; }),
+                                asset.mAnimations.end());
+    }
+
+    auto& buffer = asset.mMorphAnimationBuffers[bufferIndex];
+    buffer.mMeshTarget = entity;
+    buffer.mRenderableInstance = renderableInstance;
+    buffer.mNumFrames = numFrames;
+    buffer.mFrameLengthInMs = frameLengthInMs;
+    if(compressed || curves) {
+        buffer.mFrameData.clear();
+        buffer.mFrameData.shrink_to_fit();
+        buffer.mDecompressed.resize(numMorphTargets);
+    } else {
+        buffer.mFrameData.assign(morphData, morphData + (numFrames * numMorphTargets));
+    }
+    buffer.mCompressed = compressed;
+    buffer.mCurves = curves;
+    buffer.mCurveCursors.assign(curves ? curves->curves.size() : 0, 0);
+    buffer.mMorphIndices.assign(morphIndices, morphIndices + numMorphTargets);
+    buffer.mMinMorphIndex = *minMax.first;
+    buffer.mWeights.assign(*minMax.second - *minMax.first + 1, 0.0f);
+    // usually a single run, as the animated targets are typically contiguous
+    vector<int> sorted(buffer.mMorphIndices);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    buffer.mWeightRuns.clear();
+    for(size_t i = 0; i < sorted.size(); i++) {
+        if(i == 0 || sorted[i] != sorted[i - 1] + 1) {
+            buffer.mWeightRuns.emplace_back(sorted[i] - buffer.mMinMorphIndex, 0);
+        }
+        buffer.mWeightRuns.back().second++;
     }
     
     AnimationStatus animation;
     animation.mDuration = (frameLengthInMs * numFrames) / 1000.0f;
-    animation.mStart = high_resolution_clock::now();
     animation.type = AnimationType::MORPH;
+    animation.morphBufferIndex = bufferIndex;
     asset.mAnimations.push_back(animation);
     return true;
 }
@@ -543,6 +2587,95 @@ bool AssetManager::setBoneAnimationBuffer(
                                           const char** const boneNames,
                                           const char** const meshNames,
                                           int numMeshTargets,
+                                          float frameLengthInMs,
+                                          bool includesScale) {
+    if(numFrames <= 0 || numBones <= 0 || frameLengthInMs <= 0) {
+        Log("ERROR: bone animation must contain at least one frame and one bone, with a positive frame length.");
+        return false;
+    }
+    bool compress;
+    float maxError;
+    {
+        std::lock_guard lock(_animationMutex);
+        compress = _animationCompressionEnabled;
+        maxError = _animationCompressionMaxError;
+    }
+    auto tracks = std::make_shared<vector<float>>(numFrames * numBones * BoneTrack::COMPONENT_COUNT);
+    interleavedToBoneTracks(frameData, numFrames, numBones, includesScale, tracks->data());
+    shared_ptr<const CompressedBoneTracks> compressed;
+    if(compress) {
+        compressed = CompressedBoneTracks::compress(tracks->data(), numFrames, numBones, includesScale, frameLengthInMs, maxError);
+        tracks.reset();
+    }
+    return setBoneAnimationBuffer(entityId, tracks, compressed, nullptr, numFrames, numBones, boneNames, meshNames, numMeshTargets, frameLengthInMs);
+}
+
+bool AssetManager::setCompressedBoneAnimationBuffer(
+                                                    EntityId entityId,
+                                                    const void* const data,
+                                                    size_t size,
+                                                    int numBones,
+                                                    const char** const boneNames,
+                                                    const char** const meshNames,
+                                                    int numMeshTargets) {
+    auto compressed = CompressedBoneTracks::deserialize(data, size);
+    if(!compressed) {
+        return false;
+    }
+    if((int)compressed->numBones != numBones) {
+        Log("ERROR: compressed bone animation has %d bones, but %d bone names were provided.", compressed->numBones, numBones);
+        return false;
+    }
+    return setBoneAnimationBuffer(entityId, nullptr, compressed, nullptr, compressed->numFrames, numBones, boneNames, meshNames, numMeshTargets, compressed->frameLengthInMs);
+}
+
+bool AssetManager::setBoneAnimationCurves(
+                                          EntityId entityId,
+                                          const char** const boneNames,
+                                          int numBones,
+                                          const char** const meshNames,
+                                          int numMeshTargets,
+                                          const int* const channels,
+                                          const int* const interpolations,
+                                          const int* const keyCounts,
+                                          const float* const keys,
+                                          int numCurves) {
+    if(numBones <= 0 || numCurves <= 0) {
+        Log("ERROR: bone animation must contain at least one bone and one curve.");
+        return false;
+    }
+    // channels are numbered bone * BoneTrack::COMPONENT_COUNT + component; curves write directly into the SoA pose
+    vector<int> targets(numCurves);
+    for(int i = 0; i < numCurves; i++) {
+        if(channels[i] < 0 || channels[i] >= numBones * (int)BoneTrack::COMPONENT_COUNT) {
+            Log("ERROR: bone animation curve %d has invalid channel %d.", i, channels[i]);
+            return false;
+        }
+        const int bone = channels[i] / BoneTrack::COMPONENT_COUNT;
+        const int component = channels[i] % BoneTrack::COMPONENT_COUNT;
+        targets[i] = component * numBones + bone;
+    }
+    auto curves = AnimationCurves::create(targets.data(), interpolations, keyCounts, keys, numCurves, numBones * BoneTrack::COMPONENT_COUNT);
+    if(!curves) {
+        return false;
+    }
+    if(curves->duration <= 0) {
+        Log("ERROR: bone animation curves must span a positive duration.");
+        return false;
+    }
+    return setBoneAnimationBuffer(entityId, nullptr, nullptr, curves, 1, numBones, boneNames, meshNames, numMeshTargets, curves->duration * 1000.0f);
+}
+
+bool AssetManager::setBoneAnimationBuffer(
+                                          EntityId entityId,
+                                          shared_ptr<const vector<float>> tracks,
+                                          shared_ptr<const CompressedBoneTracks> compressed,
+                                          shared_ptr<const AnimationCurves> curves,
+                                          int numFrames,
+                                          int numBones,
+                                          const char** const boneNames,
+                                          const char** const meshNames,
+                                          int numMeshTargets,
                                           float frameLengthInMs) {
     std::lock_guard lock(_animationMutex);
 
@@ -552,88 +2685,181 @@ bool AssetManager::setBoneAnimationBuffer(
         return false;
     }
     auto& asset = _assets[pos->second];
-    auto filamentInstance = asset.mAsset->getInstance();
     
-    size_t skinCount = filamentInstance->getSkinCount();
-    
-    if(skinCount > 1) {
-        Log("WARNING - skin count > 1 not currently implemented. This will probably not work");
+    if(numFrames <= 0 || numBones <= 0 || frameLengthInMs <= 0) {
+        Log("ERROR: bone animation must contain at least one frame and one bone, with a positive frame length.");
+        return false;
     }
-    
-    TransformManager &transformManager = _engine->getTransformManager();
-    
-    int skinIndex = 0;
-    const utils::Entity* joints = filamentInstance->getJointsAt(skinIndex);
-    size_t numJoints = filamentInstance->getJointCountAt(skinIndex);
-    
-    BoneAnimationBuffer& animationBuffer = asset.mBoneAnimationBuffer;
-    
-    // if an animation has already been set,  reset the transform for the respective bones
-    for(int i = 0; i < animationBuffer.mBones.size(); i++) {
-        auto boneIndex = animationBuffer.mBones[i];
-        auto jointInstance = transformManager.getInstance(joints[boneIndex]);
-        transformManager.setTransform(jointInstance, animationBuffer.mBaseTransforms[i]);
+
+    vector<utils::Entity> meshTargets;
+    for(int i = 0; i < numMeshTargets; i++) {
+        auto entity = findEntityByName(asset, meshNames[i]);
+        if(!entity) {
+            Log("Mesh target %s for bone animation could not be found", meshNames[i]);
+            return false;
+        }
+        meshTargets.push_back(entity);
     }
+
+    // the previous animation is cleared first, so the new map captures the joints' rest transforms rather than an animated pose.
+    // names passed directly are matched every time; use a skeleton and clips (see createSkeleton) to match them once per asset.
+    clearBoneAnimation(asset);
+    Skeleton skeleton;
+    skeleton.mBoneNames.assign(boneNames, boneNames + numBones);
+    auto retargetMap = RetargetCache::build(skeleton, asset.mAsset->getInstance(), *_ncm, _engine->getTransformManager(), true);
+    if(!retargetMap) {
+        return false;
+    }
+
+    applyBoneAnimation(asset, retargetMap, tracks, compressed, curves, numFrames, frameLengthInMs);
+    asset.mBoneAnimationBuffer.mMeshTargets = std::move(meshTargets);
+    return true;
+}
+
+void AssetManager::clearBoneAnimation(SceneAsset& asset) {
+    BoneAnimationBuffer& animationBuffer = asset.mBoneAnimationBuffer;
     
-    asset.mAnimator->resetBoneMatrices();
-    
-    animationBuffer.mBones.resize(numBones);
-    animationBuffer.mBaseTransforms.resize(numBones);
-    
-    for(int i = 0; i < numBones; i++) {
-        for(int j = 0; j < numJoints; j++) {
-            const char* jointName = _ncm->getName(_ncm->getInstance(joints[j]));
-            if(strcmp(jointName, boneNames[i]) == 0) {
-                auto jointInstance = transformManager.getInstance(joints[j]);
-                // auto currentXform = ;
-                auto baseTransform = transformManager.getTransform(jointInstance); // inverse(filamentInstance->getInverseBindMatricesAt(skinIndex)[j]);
-                animationBuffer.mBaseTransforms[i] = baseTransform;
-                animationBuffer.mBones[i] = j;
-                break;
+    // if an animation has already been set, reset the transform for the respective bones
+    if(animationBuffer.mRetargetMap) {
+        TransformManager &transformManager = _engine->getTransformManager();
+        const auto& retargetMap = *animationBuffer.mRetargetMap;
+        for(size_t i = 0; i < retargetMap.mJointInstances.size(); i++) {
+            if(retargetMap.mJointInstances[i]) {
+                transformManager.setTransform(retargetMap.mJointInstances[i], retargetMap.mRestTransforms[i]);
             }
         }
     }
+    animationBuffer = BoneAnimationBuffer();
+    asset.mAnimations.erase(std::remove_if(asset.mAnimations.begin(),
+                                           asset.mAnimations.end(),
+                                           [](AnimationStatus& anim) { return anim.type == AnimationType::BONE; }),
+                            asset.mAnimations.end());
     
-    if(animationBuffer.mBones.size() != numBones) {
-        Log("Failed to find one or more bone indices");
-        return false;
-    }
-    
-    animationBuffer.mFrameData.clear();
-    // 7 == locX, locY, locZ, rotW, rotX, rotY, rotZ
-    animationBuffer.mFrameData.resize(numFrames * numBones * 7);
-    animationBuffer.mFrameData.insert(
-                                      animationBuffer.mFrameData.begin(),
-                                      frameData,
-                                      frameData + numFrames * numBones * 7
-                                      );
+    asset.mAnimator->resetBoneMatrices();
+}
+
+void AssetManager::applyBoneAnimation(
+                                      SceneAsset& asset,
+                                      shared_ptr<const RetargetMap> retargetMap,
+                                      shared_ptr<const vector<float>> tracks,
+                                      shared_ptr<const CompressedBoneTracks> compressed,
+                                      shared_ptr<const AnimationCurves> curves,
+                                      int numFrames,
+                                      float frameLengthInMs) {
+    BoneAnimationBuffer& animationBuffer = asset.mBoneAnimationBuffer;
+    const size_t numBones = retargetMap->mJointInstances.size();
+    animationBuffer.mRetargetMap = retargetMap;
+    animationBuffer.mFrameData = tracks;
+    animationBuffer.mCompressed = compressed;
+    animationBuffer.mDecompressed.resize(compressed ? 2 * numBones * BoneTrack::COMPONENT_COUNT : 0);
+    animationBuffer.mCurves = curves;
+    animationBuffer.mCurveCursors.assign(curves ? curves->curves.size() : 0, 0);
+    animationBuffer.mPose.resize(numBones * BoneTrack::COMPONENT_COUNT);
+    animationBuffer.mTransforms.resize(numBones);
     
     animationBuffer.mFrameLengthInMs = frameLengthInMs;
     animationBuffer.mNumFrames = numFrames;
     
-    animationBuffer.mMeshTargets.clear();
-    for(int i = 0; i < numMeshTargets; i++) {
-        auto entity = findEntityByName(asset, meshNames[i]);
-        if(!entity) {
-            Log("Mesh target %s for bone animation could not be found", meshNames[i]);
-            return false;
-        }
-        Log("Added mesh target %s", meshNames[i]);
-        animationBuffer.mMeshTargets.push_back(entity);
-    }
-    
     AnimationStatus animation;
-    animation.mStart = std::chrono::high_resolution_clock::now();
     animation.mReverse = false;
     animation.mDuration = (frameLengthInMs * numFrames) / 1000.0f;
     animation.type = AnimationType::BONE;
     asset.mAnimations.push_back(animation);
-    
+}
+
+int AssetManager::createSkeleton(const char** const boneNames, int numBones, const float* const restPose) {
+    std::lock_guard lock(_animationMutex);
+    return _retargetCache.addSkeleton(boneNames, numBones, restPose);
+}
+
+bool AssetManager::removeSkeleton(int skeleton) {
+    std::lock_guard lock(_animationMutex);
+    if(!_retargetCache.removeSkeleton(skeleton)) {
+        return false;
+    }
+    // clips can't outlive their skeleton, though assets playing them keep their data until replaced
+    for(auto it = _boneClips.begin(); it != _boneClips.end();) {
+        it = it->second.mSkeleton == skeleton ? _boneClips.erase(it) : std::next(it);
+    }
+    return true;
+}
+
+int AssetManager::createBoneAnimationClip(int skeleton, const float* const frameData, int numFrames, float frameLengthInMs, bool includesScale) {
+    if(numFrames <= 0 || frameLengthInMs <= 0) {
+        Log("ERROR: bone animation must contain at least one frame, with a positive frame length.");
+        return -1;
+    }
+    size_t numBones;
+    bool compress;
+    float maxError;
+    {
+        std::lock_guard lock(_animationMutex);
+        const Skeleton* source = _retargetCache.getSkeleton(skeleton);
+        if(!source) {
+            Log("ERROR: skeleton %d not found.", skeleton);
+            return -1;
+        }
+        numBones = source->mBoneNames.size();
+        compress = _animationCompressionEnabled;
+        maxError = _animationCompressionMaxError;
+    }
+
+    // converted (and compressed) once here, rather than every time the clip is set
+    BoneAnimationClip clip;
+    clip.mSkeleton = skeleton;
+    clip.mNumFrames = numFrames;
+    clip.mFrameLengthInMs = frameLengthInMs;
+    auto tracks = std::make_shared<vector<float>>(numFrames * numBones * BoneTrack::COMPONENT_COUNT);
+    interleavedToBoneTracks(frameData, numFrames, numBones, includesScale, tracks->data());
+    if(compress) {
+        clip.mCompressed = CompressedBoneTracks::compress(tracks->data(), numFrames, numBones, includesScale, frameLengthInMs, maxError);
+    } else {
+        clip.mFrameData = tracks;
+    }
+
+    std::lock_guard lock(_animationMutex);
+    const int id = _nextBoneClipId++;
+    _boneClips.emplace(id, std::move(clip));
+    return id;
+}
+
+bool AssetManager::removeBoneAnimationClip(int clip) {
+    std::lock_guard lock(_animationMutex);
+    if(_boneClips.erase(clip) == 0) {
+        Log("ERROR: bone animation clip %d not found.", clip);
+        return false;
+    }
+    return true;
+}
+
+bool AssetManager::setBoneAnimationClip(EntityId entityId, int clipId) {
+    std::lock_guard lock(_animationMutex);
+
+    const auto& pos = _entityIdLookup.find(entityId);
+    if(pos == _entityIdLookup.end()) {
+        Log("ERROR: asset not found for entity.");
+        return false;
+    }
+    auto& asset = _assets[pos->second];
+    const auto it = _boneClips.find(clipId);
+    if(it == _boneClips.end()) {
+        Log("ERROR: bone animation clip %d not found.", clipId);
+        return false;
+    }
+    const auto& clip = it->second;
+
+    // cleared before the map is looked up, so if it is built now it captures the rest pose
+    clearBoneAnimation(asset);
+    auto retargetMap = _retargetCache.getOrBuild(clip.mSkeleton, entityId, asset.mAsset->getInstance(), *_ncm, _engine->getTransformManager());
+    if(!retargetMap) {
+        return false;
+    }
+    applyBoneAnimation(asset, retargetMap, clip.mFrameData, clip.mCompressed, nullptr, clip.mNumFrames, clip.mFrameLengthInMs);
     return true;
 }
 
 
-void AssetManager::playAnimation(EntityId e, int index, bool loop, bool reverse, bool replaceActive, float crossfade) {
+void AssetManager::playAnimation(EntityId e, int index, bool loop, bool reverse, bool replaceActive, float crossfade, float startOffset) {
     std::lock_guard lock(_animationMutex);
 
     if(index < 0) {
@@ -646,6 +2872,12 @@ void AssetManager::playAnimation(EntityId e, int index, bool loop, bool reverse,
         return;
     }
     auto& asset = _assets[pos->second];
+
+    // playing an animation that was only being seeked takes over from it
+    asset.mAnimations.erase(std::remove_if(asset.mAnimations.begin(),
+                                           asset.mAnimations.end(),
+                                           [=](AnimationStatus& anim) { return anim.mHeld && anim.gltfIndex == index; }),
+                            asset.mAnimations.end());
     
     if(replaceActive) {
         vector<int> active;
@@ -658,9 +2890,7 @@ void AssetManager::playAnimation(EntityId e, int index, bool loop, bool reverse,
             auto& last = asset.mAnimations[active.back()];
             asset.fadeGltfAnimationIndex = last.gltfIndex;
             asset.fadeDuration = crossfade;
-            auto now = high_resolution_clock::now();
-            auto elapsed = float(std::chrono::duration_cast<std::chrono::milliseconds>(now - last.mStart).count()) / 1000.0f;
-            asset.fadeOutAnimationStart = elapsed;
+            asset.fadeOutAnimationStart = last.mTime;
             for(int j = active.size() - 1; j >= 0; j--) {
                 asset.mAnimations.erase(asset.mAnimations.begin() + active[j]);
             }
@@ -678,11 +2908,17 @@ void AssetManager::playAnimation(EntityId e, int index, bool loop, bool reverse,
     
     AnimationStatus animation;
     animation.gltfIndex = index;
-    animation.mStart = std::chrono::high_resolution_clock::now();
     animation.mLoop = loop;
     animation.mReverse = reverse;
     animation.type = AnimationType::GLTF;
     animation.mDuration = asset.mAnimator->getAnimationDuration(index);
+    // lets instances sharing a baked clip play out of phase with each other
+    animation.mTime = startOffset;
+    if(loop && animation.mDuration > 0) {
+        animation.mTime = fmod(animation.mTime, animation.mDuration);
+    }
+    // this may be called from any thread, so baking (which poses the asset) is deferred to the next updateAnimations
+    animation.mBake = _animationBakingEnabled;
     
     asset.mAnimations.push_back(animation);
 
@@ -777,82 +3013,81 @@ void AssetManager::loadTexture(EntityId entity, const char* resourcePath, int re
 }
 
 
-void AssetManager::setAnimationFrame(EntityId entity, int animationIndex, int animationFrame) {
+bool AssetManager::seekAnimation(EntityId entity, int animationIndex, float timeInSecs) {
+    std::lock_guard lock(_animationMutex);
     const auto& pos = _entityIdLookup.find(entity);
     if(pos == _entityIdLookup.end()) {
         Log("ERROR: asset not found for entity.");
-        return;
+        return false;
     }
     auto& asset = _assets[pos->second];
-    auto offset = 60 * animationFrame * 1000; // TODO - don't hardcore 60fps framerate
-    asset.mAnimator->applyAnimation(animationIndex, offset);
-    asset.mAnimator->updateBoneMatrices();
+    if(animationIndex < 0 || animationIndex >= (int)asset.mAnimator->getAnimationCount()) {
+        Log("ERROR: glTF animation index %d is out of range.", animationIndex);
+        return false;
+    }
+
+    // this only records the time; the pose is evaluated (once, however many seeks arrive in between) on the next updateAnimations
+    const float duration = asset.mAnimator->getAnimationDuration(animationIndex);
+    bool found = false;
+    for(auto& anim : asset.mAnimations) {
+        if(anim.type == AnimationType::GLTF && anim.gltfIndex == animationIndex) {
+            anim.mSeekTime = anim.mLoop && duration > 0 ? fmod(std::max(timeInSecs, 0.0f), duration) : std::clamp(timeInSecs, 0.0f, duration);
+            found = true;
+        }
+    }
+    if(!found) {
+        AnimationStatus animation;
+        animation.gltfIndex = animationIndex;
+        animation.type = AnimationType::GLTF;
+        animation.mDuration = duration;
+        animation.mHeld = true;
+        animation.mSeekTime = std::clamp(timeInSecs, 0.0f, duration);
+        // always baked (regardless of setAnimationBaking), so scrubbing is a table lookup and lerp rather than a search of every glTF channel
+        animation.mBake = true;
+        asset.mAnimations.push_back(animation);
+    }
+    asset.mSeekPending = true;
+    return true;
+}
+
+bool AssetManager::setAnimationFrame(EntityId entity, int animationIndex, int animationFrame, float framesPerSecond) {
+    if(framesPerSecond <= 0) {
+        Log("ERROR: frame rate must be greater than zero.");
+        return false;
+    }
+    return seekAnimation(entity, animationIndex, animationFrame / framesPerSecond);
 }
 
 float AssetManager::getAnimationDuration(EntityId entity, int animationIndex) {
-    const auto& pos = _entityIdLookup.find(entity);
-    
-    unique_ptr<vector<string>> names = make_unique<vector<string>>();
-    
-    if(pos == _entityIdLookup.end()) {
+    const auto metadata = getMetadata(entity);
+    if(!metadata) {
         Log("ERROR: asset not found for entity id.");
         return -1.0f;
     }
-    
-    auto& asset = _assets[pos->second];
-    return asset.mAnimator->getAnimationDuration(animationIndex);
+    if(animationIndex < 0 || animationIndex >= (int)metadata->mAnimationDurations.size()) {
+        Log("ERROR: glTF animation index %d is out of range.", animationIndex);
+        return -1.0f;
+    }
+    return metadata->mAnimationDurations[animationIndex];
 }
 
 unique_ptr<vector<string>> AssetManager::getAnimationNames(EntityId entity) {
-    
-    const auto& pos = _entityIdLookup.find(entity);
-    
-    unique_ptr<vector<string>> names = make_unique<vector<string>>();
-    
-    if(pos == _entityIdLookup.end()) {
+    const auto metadata = getMetadata(entity);
+    if(!metadata) {
         Log("ERROR: asset not found for entity id.");
-        return names;
-    }
-    auto& asset = _assets[pos->second];
-    
-    size_t count = asset.mAnimator->getAnimationCount();
-    
-    
-    for (size_t i = 0; i < count; i++) {
-        names->push_back(asset.mAnimator->getAnimationName(i));
+        return make_unique<vector<string>>();
     }
-    
-    return names;
+    return make_unique<vector<string>>(metadata->mAnimationNames);
 }
 
 unique_ptr<vector<string>> AssetManager::getMorphTargetNames(EntityId entity, const char *meshName) {
-    
-    unique_ptr<vector<string>> names = make_unique<vector<string>>();
-    
-    const auto& pos = _entityIdLookup.find(entity);
-    if(pos == _entityIdLookup.end()) {
+    const auto metadata = getMetadata(entity);
+    if(!metadata) {
         Log("ERROR: asset not found for entity.");
-        return names;
-    }
-    auto& asset = _assets[pos->second];
-    
-    const utils::Entity *entities = asset.mAsset->getEntities();
-    
-    for (int i = 0; i < asset.mAsset->getEntityCount(); i++) {
-        utils::Entity e = entities[i];
-        auto inst = _ncm->getInstance(e);
-        const char *name = _ncm->getName(inst);
-        
-        if (name && strcmp(name, meshName) == 0) {
-            size_t count = asset.mAsset->getMorphTargetCountAt(e);
-            for (int j = 0; j < count; j++) {
-                const char *morphName = asset.mAsset->getMorphTargetNameAt(e, j);
-                names->push_back(morphName);
-            }
-            break;
-        }
+        return make_unique<vector<string>>();
     }
-    return names;
+    const auto* mesh = metadata->findMesh(meshName);
+    return mesh ? make_unique<vector<string>>(mesh->mMorphTargetNames) : make_unique<vector<string>>();
 }
 
 void AssetManager::transformToUnitCube(EntityId entity) {
@@ -956,7 +3191,17 @@ size_t AssetManager::getLightEntityCount(EntityId entity) const noexcept {
     return asset.mAsset->getLightEntityCount();
 }
 
+const char* AssetManager::getMetadataName(EntityId entityId) {
+  const auto metadata = std::atomic_load(&_metadata);
+  const auto name = metadata->mEntityNames.find(entityId);
+  // like names held by the NameComponentManager, this is valid until the asset is removed
+  return name == metadata->mEntityNames.end() ? nullptr : name->second;
+}
+
 const char* AssetManager::getNameForEntity(EntityId entityId) {
+  if(const char* name = getMetadataName(entityId)) {
+    return name;
+  }
   const auto& entity = Entity::import(entityId);
   auto nameInstance = _ncm->getInstance(entity);
   if(!nameInstance.isValid()) {
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include <gltfio/Animator.h>
+#include <gltfio/FilamentInstance.h>
+#include <utils/Entity.h>
+
+#include "AssetMetadata.hpp"
+
+namespace polyvox {
+
+using namespace filament;
+using namespace filament::gltfio;
+
+static const char* getName(const utils::NameComponentManager& ncm, utils::Entity entity) {
+    const auto instance = ncm.getInstance(entity);
+    return instance.isValid() ? ncm.getName(instance) : nullptr;
+}
+
+static void appendString(std::string& json, const std::string& value) {
+    json += '"';
+    for(const char c : value) {
+        switch(c) {
+            case '"':
+                json += "\\\"";
+                break;
+            case '\\':
+                json += "\\\\";
+                break;
+            case '\n':
+                json += "\\n";
+                break;
+            default:
+                if((unsigned char)c < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    json += escaped;
+                } else {
+                    json += c;
+                }
+        }
+    }
+    json += '"';
+}
+
+static void appendNumber(std::string& json, float value) {
+    // JSON has no representation for infinity (e.g. the bounds of an asset with no renderables)
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%g", std::isfinite(value) ? value : 0.0f);
+    json += buffer;
+}
+
+static void appendStrings(std::string& json, const std::vector<std::string>& values) {
+    json += '[';
+    for(size_t i = 0; i < values.size(); i++) {
+        if(i > 0) {
+            json += ',';
+        }
+        appendString(json, values[i]);
+    }
+    json += ']';
+}
+
+static void appendEntities(std::string& json, const std::vector<NamedEntity>& entities) {
+    json += '[';
+    for(size_t i = 0; i < entities.size(); i++) {
+        json += i > 0 ? ",{\"name\":" : "{\"name\":";
+        appendString(json, entities[i].mName);
+        json += ",\"entity\":" + std::to_string(entities[i].mEntity) + "}";
+    }
+    json += ']';
+}
+
+static void appendVector(std::string& json, const math::float3& value) {
+    json += '[';
+    appendNumber(json, value.x);
+    json += ',';
+    appendNumber(json, value.y);
+    json += ',';
+    appendNumber(json, value.z);
+    json += ']';
+}
+
+static std::vector<NamedEntity> getNamedEntities(const utils::NameComponentManager& ncm, const utils::Entity* entities, size_t count) {
+    std::vector<NamedEntity> named;
+    for(size_t i = 0; i < count; i++) {
+        const char* name = getName(ncm, entities[i]);
+        named.push_back({ name ? name : "", utils::Entity::smuggle(entities[i]) });
+    }
+    return named;
+}
+
+std::shared_ptr<AssetMetadata> buildAssetMetadata(FilamentAsset* asset, const utils::NameComponentManager& ncm) {
+    auto metadata = std::make_shared<AssetMetadata>();
+    FilamentInstance* instance = asset->getInstance();
+    Animator* animator = instance->getAnimator();
+    for(size_t i = 0; i < animator->getAnimationCount(); i++) {
+        metadata->mAnimationNames.push_back(animator->getAnimationName(i));
+        metadata->mAnimationDurations.push_back(animator->getAnimationDuration(i));
+    }
+
+    const utils::Entity* renderables = asset->getRenderableEntities();
+    for(size_t i = 0; i < asset->getRenderableEntityCount(); i++) {
+        const char* name = getName(ncm, renderables[i]);
+        MeshMetadata mesh { name ? name : "", utils::Entity::smuggle(renderables[i]), {} };
+        for(size_t j = 0; j < asset->getMorphTargetCountAt(renderables[i]); j++) {
+            const char* morphName = asset->getMorphTargetNameAt(renderables[i], j);
+            mesh.mMorphTargetNames.push_back(morphName ? morphName : "");
+        }
+        metadata->mMeshes.push_back(std::move(mesh));
+    }
+
+    std::vector<utils::Entity> joints;
+    for(size_t skin = 0; skin < instance->getSkinCount(); skin++) {
+        const utils::Entity* skinJoints = instance->getJointsAt(skin);
+        for(size_t i = 0; i < instance->getJointCountAt(skin); i++) {
+            if(std::find(joints.begin(), joints.end(), skinJoints[i]) == joints.end()) {
+                joints.push_back(skinJoints[i]);
+                const char* name = getName(ncm, skinJoints[i]);
+                metadata->mJointNames.push_back(name ? name : "");
+            }
+        }
+    }
+
+    metadata->mCameras = getNamedEntities(ncm, asset->getCameraEntities(), asset->getCameraEntityCount());
+    metadata->mLights = getNamedEntities(ncm, asset->getLightEntities(), asset->getLightEntityCount());
+    for(auto& entity : getNamedEntities(ncm, asset->getEntities(), asset->getEntityCount())) {
+        if(!entity.mName.empty()) {
+            metadata->mEntities.push_back(std::move(entity));
+        }
+    }
+
+    const Aabb bounds = asset->getBoundingBox();
+    metadata->mBoundsMin = bounds.min;
+    metadata->mBoundsMax = bounds.max;
+
+    auto& json = metadata->mJson;
+    json = "{\"animations\":[";
+    for(size_t i = 0; i < metadata->mAnimationNames.size(); i++) {
+        json += i > 0 ? ",{\"name\":" : "{\"name\":";
+        appendString(json, metadata->mAnimationNames[i]);
+        json += ",\"duration\":";
+        appendNumber(json, metadata->mAnimationDurations[i]);
+        json += '}';
+    }
+    json += "],\"meshes\":[";
+    for(size_t i = 0; i < metadata->mMeshes.size(); i++) {
+        json += i > 0 ? ",{\"name\":" : "{\"name\":";
+        appendString(json, metadata->mMeshes[i].mName);
+        json += ",\"entity\":" + std::to_string(metadata->mMeshes[i].mEntity) + ",\"morphTargets\":";
+        appendStrings(json, metadata->mMeshes[i].mMorphTargetNames);
+        json += '}';
+    }
+    json += "],\"joints\":";
+    appendStrings(json, metadata->mJointNames);
+    json += ",\"cameras\":";
+    appendEntities(json, metadata->mCameras);
+    json += ",\"lights\":";
+    appendEntities(json, metadata->mLights);
+    json += ",\"bounds\":{\"min\":";
+    appendVector(json, metadata->mBoundsMin);
+    json += ",\"max\":";
+    appendVector(json, metadata->mBoundsMax);
+    json += "}}";
+    return metadata;
+}
+
+const MeshMetadata* AssetMetadata::findMesh(const char* name) const {
+    for(const auto& mesh : mMeshes) {
+        if(mesh.mName == name) {
+            return &mesh;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<const AssetMetadata> AssetMetadataTable::find(int32_t asset) const {
+    const auto it = mAssets.find(asset);
+    return it == mAssets.end() ? nullptr : it->second;
+}
+
+std::shared_ptr<AssetMetadataTable> AssetMetadataTable::with(int32_t asset, std::shared_ptr<const AssetMetadata> metadata) const {
+    auto table = std::make_shared<AssetMetadataTable>(*this);
+    for(const auto& entity : metadata->mEntities) {
+        table->mEntityNames[entity.mEntity] = entity.mName.c_str();
+    }
+    table->mAssets[asset] = std::move(metadata);
+    return table;
+}
+
+std::shared_ptr<AssetMetadataTable> AssetMetadataTable::without(int32_t asset) const {
+    auto table = std::make_shared<AssetMetadataTable>(*this);
+    const auto it = table->mAssets.find(asset);
+    if(it != table->mAssets.end()) {
+        for(const auto& entity : it->second->mEntities) {
+            table->mEntityNames.erase(entity.mEntity);
+        }
+        table->mAssets.erase(it);
+    }
+    return table;
+}
+
+}
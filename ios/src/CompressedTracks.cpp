@@ -0,0 +1,445 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "CompressedTracks.hpp"
+#include "BoneTracks.hpp"
+#include "Log.hpp"
+
+namespace polyvox {
+
+static constexpr uint32_t kTrackBlobMagic = 0x54415650; // "PVAT"
+static constexpr uint32_t kTrackBlobVersion = 1;
+static constexpr uint32_t kMorphTrackBlob = 0;
+static constexpr uint32_t kBoneTrackBlob = 1;
+static constexpr uint32_t kBoneTrackBlobHasScale = 1;
+
+// bounds the cost of keyframe reduction (which is quadratic in the gap between keys)
+static constexpr uint32_t kMaxKeyframeGap = 64;
+
+static constexpr float kSqrt2 = 1.41421356f;
+
+struct TrackBlobHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t type;
+    uint32_t flags;
+    uint32_t numFrames;
+    uint32_t numTracks;
+    uint32_t numKeys;
+    float frameLengthInMs;
+};
+
+static bool canInterpolate(const float* frames, size_t frameSize, uint32_t from, uint32_t to, float maxError) {
+    const float* a = frames + from * frameSize;
+    const float* b = frames + to * frameSize;
+    for(uint32_t frame = from + 1; frame < to; frame++) {
+        const float t = float(frame - from) / float(to - from);
+        const float* v = frames + frame * frameSize;
+        for(size_t i = 0; i < frameSize; i++) {
+            if(std::fabs(a[i] + (b[i] - a[i]) * t - v[i]) > maxError) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static std::vector<uint32_t> reduceKeyframes(const float* frames, uint32_t numFrames, size_t frameSize, float maxError) {
+    std::vector<uint32_t> keys;
+    if(maxError <= 0) {
+        keys.resize(numFrames);
+        for(uint32_t i = 0; i < numFrames; i++) {
+            keys[i] = i;
+        }
+        return keys;
+    }
+    // greedily extend each key for as long as every frame since the last key can be rebuilt by interpolation
+    keys.push_back(0);
+    uint32_t from = 0;
+    for(uint32_t to = 2; to < numFrames; to++) {
+        if(to - from > kMaxKeyframeGap || !canInterpolate(frames, frameSize, from, to, maxError)) {
+            from = to - 1;
+            keys.push_back(from);
+        }
+    }
+    if(numFrames > 1) {
+        keys.push_back(numFrames - 1);
+    }
+    return keys;
+}
+
+static uint16_t quantize(float value, float minimum, float extent) {
+    if(extent <= 0) {
+        return 0;
+    }
+    return static_cast<uint16_t>(std::lround(std::clamp((value - minimum) / extent, 0.0f, 1.0f) * 65535.0f));
+}
+
+static void encodeQuaternion(float x, float y, float z, float w, uint16_t* out) {
+    float q[4] = { x, y, z, w };
+    const float invLength = 1.0f / std::sqrt(x * x + y * y + z * z + w * w);
+    int largest = 0;
+    for(int i = 0; i < 4; i++) {
+        q[i] *= invLength;
+        if(std::fabs(q[i]) > std::fabs(q[largest])) {
+            largest = i;
+        }
+    }
+    // q and -q are the same rotation, so flip it to make the dropped component positive
+    const float sign = q[largest] < 0 ? -1.0f : 1.0f;
+    // 2 bits for the index of the dropped component, then 15 bits for each of the others (which lie within +/- 1/sqrt(2))
+    uint64_t bits = largest;
+    for(int i = 0; i < 4; i++) {
+        if(i != largest) {
+            const float v = std::clamp(q[i] * sign * kSqrt2, -1.0f, 1.0f);
+            bits = (bits << 15) | static_cast<uint64_t>(std::lround((v * 0.5f + 0.5f) * 32767.0f));
+        }
+    }
+    out[0] = static_cast<uint16_t>(bits >> 32);
+    out[1] = static_cast<uint16_t>(bits >> 16);
+    out[2] = static_cast<uint16_t>(bits);
+}
+
+static void decodeQuaternion(const uint16_t* in, float* q) {
+    const uint64_t bits = (uint64_t(in[0]) << 32) | (uint64_t(in[1]) << 16) | uint64_t(in[2]);
+    const int largest = static_cast<int>(bits >> 45) & 3;
+    int shift = 30;
+    float sumOfSquares = 0.0f;
+    for(int i = 0; i < 4; i++) {
+        if(i == largest) {
+            continue;
+        }
+        const float v = (float((bits >> shift) & 0x7fff) * (2.0f / 32767.0f) - 1.0f) * (1.0f / kSqrt2);
+        q[i] = v;
+        sumOfSquares += v * v;
+        shift -= 15;
+    }
+    q[largest] = std::sqrt(std::max(0.0f, 1.0f - sumOfSquares));
+}
+
+// the range of [count] values spaced [stride] apart
+static void getRange(const float* values, size_t count, size_t stride, float& minimum, float& extent) {
+    float lo = values[0];
+    float hi = values[0];
+    for(size_t i = 1; i < count; i++) {
+        lo = std::min(lo, values[i * stride]);
+        hi = std::max(hi, values[i * stride]);
+    }
+    minimum = lo;
+    extent = hi - lo;
+}
+
+template<typename T>
+static void writeArray(uint8_t*& cursor, const std::vector<T>& values) {
+    memcpy(cursor, values.data(), values.size() * sizeof(T));
+    cursor += values.size() * sizeof(T);
+}
+
+template<typename T>
+static void readArray(const uint8_t*& cursor, std::vector<T>& values, size_t count) {
+    values.resize(count);
+    memcpy(values.data(), cursor, count * sizeof(T));
+    cursor += count * sizeof(T);
+}
+
+static size_t writeBlob(const TrackBlobHeader& header, const CompressedKeyframes& keyframes,
+                        std::initializer_list<const std::vector<float>*> ranges,
+                        std::initializer_list<const std::vector<uint16_t>*> data,
+                        uint8_t* out, size_t capacity) {
+    size_t size = sizeof(header) + keyframes.keys.size() * sizeof(uint32_t);
+    for(auto* range : ranges) {
+        size += range->size() * sizeof(float);
+    }
+    for(auto* values : data) {
+        size += values->size() * sizeof(uint16_t);
+    }
+    if(!out || capacity < size) {
+        return size;
+    }
+    memcpy(out, &header, sizeof(header));
+    uint8_t* cursor = out + sizeof(header);
+    writeArray(cursor, keyframes.keys);
+    for(auto* range : ranges) {
+        writeArray(cursor, *range);
+    }
+    for(auto* values : data) {
+        writeArray(cursor, *values);
+    }
+    return size;
+}
+
+// validates everything but the size of the payload, and reads the keys
+static const uint8_t* readBlobHeader(const void* data, size_t size, uint32_t type, TrackBlobHeader& header, CompressedKeyframes& keyframes) {
+    if(!data || size < sizeof(header)) {
+        Log("ERROR: animation track blob is too small.");
+        return nullptr;
+    }
+    memcpy(&header, data, sizeof(header));
+    if(header.magic != kTrackBlobMagic || header.version != kTrackBlobVersion || header.type != type) {
+        Log("ERROR: not a %s animation track blob (or an unsupported version).", type == kMorphTrackBlob ? "morph" : "bone");
+        return nullptr;
+    }
+    if(header.numFrames == 0 || header.numTracks == 0 || header.numKeys == 0 || header.numKeys > header.numFrames || !(header.frameLengthInMs > 0)) {
+        Log("ERROR: invalid animation track blob header.");
+        return nullptr;
+    }
+    if(size < sizeof(header) + uint64_t(header.numKeys) * sizeof(uint32_t)) {
+        Log("ERROR: animation track blob is truncated.");
+        return nullptr;
+    }
+    const uint8_t* cursor = static_cast<const uint8_t*>(data) + sizeof(header);
+    readArray(cursor, keyframes.keys, header.numKeys);
+    bool valid = keyframes.keys.front() == 0 && keyframes.keys.back() == header.numFrames - 1;
+    for(size_t i = 1; i < keyframes.keys.size() && valid; i++) {
+        valid = keyframes.keys[i] > keyframes.keys[i - 1];
+    }
+    if(!valid) {
+        Log("ERROR: animation track blob keys must be increasing, and include the first and last frames.");
+        return nullptr;
+    }
+    keyframes.numFrames = header.numFrames;
+    keyframes.frameLengthInMs = header.frameLengthInMs;
+    return cursor;
+}
+
+void CompressedKeyframes::locate(int frame, int nextFrame, float alpha, uint32_t& fromKey, uint32_t& toKey, float& keyAlpha) const {
+    if(keys.size() == numFrames) {
+        fromKey = frame;
+        toKey = nextFrame;
+        keyAlpha = alpha;
+        return;
+    }
+    fromKey = static_cast<uint32_t>(std::upper_bound(keys.begin(), keys.end(), static_cast<uint32_t>(frame)) - keys.begin()) - 1;
+    if(nextFrame <= frame) {
+        // either held on the last frame, or looping from the last frame to the first (which are both keys)
+        toKey = nextFrame == frame ? fromKey : 0;
+        keyAlpha = alpha;
+        return;
+    }
+    toKey = fromKey + 1;
+    keyAlpha = (frame + alpha - keys[fromKey]) / float(keys[toKey] - keys[fromKey]);
+}
+
+std::shared_ptr<CompressedMorphTracks> CompressedMorphTracks::compress(
+    const float* const frameData,
+    uint32_t numFrames,
+    uint32_t numTargets,
+    float frameLengthInMs,
+    float maxError) {
+
+    if(numFrames == 0 || numTargets == 0) {
+        return nullptr;
+    }
+    auto tracks = std::make_shared<CompressedMorphTracks>();
+    tracks->numFrames = numFrames;
+    tracks->numTargets = numTargets;
+    tracks->frameLengthInMs = frameLengthInMs;
+    tracks->keys = reduceKeyframes(frameData, numFrames, numTargets, maxError);
+    tracks->minimum.resize(numTargets);
+    tracks->extent.resize(numTargets);
+    for(uint32_t target = 0; target < numTargets; target++) {
+        getRange(frameData + target, numFrames, numTargets, tracks->minimum[target], tracks->extent[target]);
+    }
+    tracks->weights.resize(tracks->keys.size() * numTargets);
+    for(size_t key = 0; key < tracks->keys.size(); key++) {
+        const float* frame = frameData + tracks->keys[key] * numTargets;
+        for(uint32_t target = 0; target < numTargets; target++) {
+            tracks->weights[key * numTargets + target] = quantize(frame[target], tracks->minimum[target], tracks->extent[target]);
+        }
+    }
+    return tracks;
+}
+
+void CompressedMorphTracks::sample(int frame, int nextFrame, float alpha, float* out) const {
+    uint32_t fromKey, toKey;
+    float keyAlpha;
+    locate(frame, nextFrame, alpha, fromKey, toKey, keyAlpha);
+    const uint16_t* a = weights.data() + fromKey * numTargets;
+    const uint16_t* b = weights.data() + toKey * numTargets;
+    for(uint32_t i = 0; i < numTargets; i++) {
+        const float scale = extent[i] * (1.0f / 65535.0f);
+        const float from = minimum[i] + a[i] * scale;
+        const float to = minimum[i] + b[i] * scale;
+        out[i] = from + (to - from) * keyAlpha;
+    }
+}
+
+size_t CompressedMorphTracks::serialize(uint8_t* out, size_t capacity) const {
+    TrackBlobHeader header { kTrackBlobMagic, kTrackBlobVersion, kMorphTrackBlob, 0, numFrames, numTargets, (uint32_t)keys.size(), frameLengthInMs };
+    return writeBlob(header, *this, { &minimum, &extent }, { &weights }, out, capacity);
+}
+
+std::shared_ptr<CompressedMorphTracks> CompressedMorphTracks::deserialize(const void* data, size_t size) {
+    auto tracks = std::make_shared<CompressedMorphTracks>();
+    TrackBlobHeader header;
+    const uint8_t* cursor = readBlobHeader(data, size, kMorphTrackBlob, header, *tracks);
+    if(!cursor) {
+        return nullptr;
+    }
+    const uint64_t numTargets = header.numTracks;
+    const uint64_t expectedSize = sizeof(header)
+        + header.numKeys * sizeof(uint32_t)
+        + 2 * numTargets * sizeof(float)
+        + header.numKeys * numTargets * sizeof(uint16_t);
+    if(size != expectedSize) {
+        Log("ERROR: morph animation track blob should be %llu bytes, but is %zu.", (unsigned long long)expectedSize, size);
+        return nullptr;
+    }
+    tracks->numTargets = header.numTracks;
+    readArray(cursor, tracks->minimum, numTargets);
+    readArray(cursor, tracks->extent, numTargets);
+    readArray(cursor, tracks->weights, header.numKeys * numTargets);
+    return tracks;
+}
+
+std::shared_ptr<CompressedBoneTracks> CompressedBoneTracks::compress(
+    const float* const frameData,
+    uint32_t numFrames,
+    uint32_t numBones,
+    bool hasScale,
+    float frameLengthInMs,
+    float maxError) {
+
+    if(numFrames == 0 || numBones == 0) {
+        return nullptr;
+    }
+    const size_t frameSize = numBones * BoneTrack::COMPONENT_COUNT;
+    auto tracks = std::make_shared<CompressedBoneTracks>();
+    tracks->numFrames = numFrames;
+    tracks->numBones = numBones;
+    tracks->hasScale = hasScale;
+    tracks->frameLengthInMs = frameLengthInMs;
+    tracks->keys = reduceKeyframes(frameData, numFrames, frameSize, maxError);
+    const size_t numKeys = tracks->keys.size();
+
+    tracks->translationMinimum.resize(numBones * 3);
+    tracks->translationExtent.resize(numBones * 3);
+    if(hasScale) {
+        tracks->scaleMinimum.resize(numBones * 3);
+        tracks->scaleExtent.resize(numBones * 3);
+    }
+    for(uint32_t bone = 0; bone < numBones; bone++) {
+        for(size_t axis = 0; axis < 3; axis++) {
+            getRange(frameData + (BoneTrack::TX + axis) * numBones + bone, numFrames, frameSize,
+                     tracks->translationMinimum[bone * 3 + axis], tracks->translationExtent[bone * 3 + axis]);
+            if(hasScale) {
+                getRange(frameData + (BoneTrack::SX + axis) * numBones + bone, numFrames, frameSize,
+                         tracks->scaleMinimum[bone * 3 + axis], tracks->scaleExtent[bone * 3 + axis]);
+            }
+        }
+    }
+
+    tracks->rotations.resize(numKeys * numBones * 3);
+    tracks->translations.resize(numKeys * 3 * numBones);
+    if(hasScale) {
+        tracks->scales.resize(numKeys * 3 * numBones);
+    }
+    for(size_t key = 0; key < numKeys; key++) {
+        const float* frame = frameData + tracks->keys[key] * frameSize;
+        for(uint32_t bone = 0; bone < numBones; bone++) {
+            encodeQuaternion(
+                frame[BoneTrack::RX * numBones + bone],
+                frame[BoneTrack::RY * numBones + bone],
+                frame[BoneTrack::RZ * numBones + bone],
+                frame[BoneTrack::RW * numBones + bone],
+                tracks->rotations.data() + (key * numBones + bone) * 3);
+            for(size_t axis = 0; axis < 3; axis++) {
+                const size_t i = (key * 3 + axis) * numBones + bone;
+                tracks->translations[i] = quantize(frame[(BoneTrack::TX + axis) * numBones + bone],
+                                                   tracks->translationMinimum[bone * 3 + axis], tracks->translationExtent[bone * 3 + axis]);
+                if(hasScale) {
+                    tracks->scales[i] = quantize(frame[(BoneTrack::SX + axis) * numBones + bone],
+                                                 tracks->scaleMinimum[bone * 3 + axis], tracks->scaleExtent[bone * 3 + axis]);
+                }
+            }
+        }
+    }
+    return tracks;
+}
+
+void CompressedBoneTracks::decodeKey(uint32_t key, float* out) const {
+    for(uint32_t bone = 0; bone < numBones; bone++) {
+        float q[4];
+        decodeQuaternion(rotations.data() + (key * numBones + bone) * 3, q);
+        out[BoneTrack::RX * numBones + bone] = q[0];
+        out[BoneTrack::RY * numBones + bone] = q[1];
+        out[BoneTrack::RZ * numBones + bone] = q[2];
+        out[BoneTrack::RW * numBones + bone] = q[3];
+    }
+    for(size_t axis = 0; axis < 3; axis++) {
+        const uint16_t* t = translations.data() + (key * 3 + axis) * numBones;
+        float* o = out + (BoneTrack::TX + axis) * numBones;
+        for(uint32_t bone = 0; bone < numBones; bone++) {
+            o[bone] = translationMinimum[bone * 3 + axis] + t[bone] * translationExtent[bone * 3 + axis] * (1.0f / 65535.0f);
+        }
+        o = out + (BoneTrack::SX + axis) * numBones;
+        if(hasScale) {
+            const uint16_t* s = scales.data() + (key * 3 + axis) * numBones;
+            for(uint32_t bone = 0; bone < numBones; bone++) {
+                o[bone] = scaleMinimum[bone * 3 + axis] + s[bone] * scaleExtent[bone * 3 + axis] * (1.0f / 65535.0f);
+            }
+        } else {
+            std::fill(o, o + numBones, 1.0f);
+        }
+    }
+}
+
+void CompressedBoneTracks::sample(int frame, int nextFrame, float alpha, float* scratch, float* out) const {
+    uint32_t fromKey, toKey;
+    float keyAlpha;
+    locate(frame, nextFrame, alpha, fromKey, toKey, keyAlpha);
+    const size_t frameSize = numBones * BoneTrack::COMPONENT_COUNT;
+    decodeKey(fromKey, scratch);
+    if(toKey == fromKey) {
+        memcpy(out, scratch, frameSize * sizeof(float));
+        return;
+    }
+    decodeKey(toKey, scratch + frameSize);
+    interpolateBoneTracks(scratch, scratch + frameSize, keyAlpha, numBones, out);
+}
+
+size_t CompressedBoneTracks::serialize(uint8_t* out, size_t capacity) const {
+    TrackBlobHeader header { kTrackBlobMagic, kTrackBlobVersion, kBoneTrackBlob, hasScale ? kBoneTrackBlobHasScale : 0, numFrames, numBones, (uint32_t)keys.size(), frameLengthInMs };
+    return writeBlob(header, *this,
+                     { &translationMinimum, &translationExtent, &scaleMinimum, &scaleExtent },
+                     { &rotations, &translations, &scales },
+                     out, capacity);
+}
+
+std::shared_ptr<CompressedBoneTracks> CompressedBoneTracks::deserialize(const void* data, size_t size) {
+    auto tracks = std::make_shared<CompressedBoneTracks>();
+    TrackBlobHeader header;
+    const uint8_t* cursor = readBlobHeader(data, size, kBoneTrackBlob, header, *tracks);
+    if(!cursor) {
+        return nullptr;
+    }
+    const bool hasScale = header.flags & kBoneTrackBlobHasScale;
+    const uint64_t numBones = header.numTracks;
+    const uint64_t numRanges = hasScale ? 4 : 2;
+    const uint64_t numPlanes = hasScale ? 9 : 6;
+    const uint64_t expectedSize = sizeof(header)
+        + header.numKeys * sizeof(uint32_t)
+        + numRanges * numBones * 3 * sizeof(float)
+        + numPlanes * header.numKeys * numBones * sizeof(uint16_t);
+    if(size != expectedSize) {
+        Log("ERROR: bone animation track blob should be %llu bytes, but is %zu.", (unsigned long long)expectedSize, size);
+        return nullptr;
+    }
+    tracks->numBones = header.numTracks;
+    tracks->hasScale = hasScale;
+    readArray(cursor, tracks->translationMinimum, numBones * 3);
+    readArray(cursor, tracks->translationExtent, numBones * 3);
+    if(hasScale) {
+        readArray(cursor, tracks->scaleMinimum, numBones * 3);
+        readArray(cursor, tracks->scaleExtent, numBones * 3);
+    }
+    readArray(cursor, tracks->rotations, header.numKeys * numBones * 3);
+    readArray(cursor, tracks->translations, header.numKeys * numBones * 3);
+    if(hasScale) {
+        readArray(cursor, tracks->scales, header.numKeys * numBones * 3);
+    }
+    return tracks;
+}
+
+}
@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <limits>
+
+#include <filament/Box.h>
+#include <filament/MaterialEnums.h>
+#include <filament/TransformManager.h>
+#include <geometry/SurfaceOrientation.h>
+#include <math/vec3.h>
+#include <utils/EntityManager.h>
+
+#include "DynamicMesh.hpp"
+#include "Log.hpp"
+
+namespace polyvox {
+
+using namespace filament;
+using namespace filament::math;
+
+static VertexBuffer::AttributeType toAttributeType(uint8_t components) {
+    switch(components) {
+        case 1:
+            return VertexBuffer::AttributeType::FLOAT;
+        case 2:
+            return VertexBuffer::AttributeType::FLOAT2;
+        case 3:
+            return VertexBuffer::AttributeType::FLOAT3;
+        default:
+            return VertexBuffer::AttributeType::FLOAT4;
+    }
+}
+
+static VertexAttribute toVertexAttribute(int attribute) {
+    switch(attribute) {
+        case DYNAMIC_MESH_POSITION:
+            return VertexAttribute::POSITION;
+        case DYNAMIC_MESH_NORMAL:
+            return VertexAttribute::TANGENTS;
+        case DYNAMIC_MESH_UV:
+            return VertexAttribute::UV0;
+        case DYNAMIC_MESH_COLOR:
+            return VertexAttribute::COLOR;
+        default:
+            return VertexAttribute(VertexAttribute::CUSTOM0 + (attribute - DYNAMIC_MESH_CUSTOM0));
+    }
+}
+
+static void releaseUpload(void*, size_t, void* user) {
+    // called by Filament once the driver has consumed the data, which is only then returned to the producer
+    static_cast<std::atomic<int>*>(user)->fetch_sub(1, std::memory_order_release);
+}
+
+DynamicMesh::DynamicMesh(
+    const Layout& layout,
+    RenderableManager::PrimitiveType type,
+    uint32_t numBuffers,
+    Material* material,
+    Engine& engine) :
+    mLayout(layout),
+    mType(type),
+    mMaterial(material),
+    mPublished(pack(0, 2)) {
+
+    size_t numFloats = 0;
+    uint8_t numVertexBuffers = 0;
+    VertexBuffer::Builder builder;
+    builder.vertexCount(layout.mMaxVertices);
+    for(int attribute = 0; attribute < DYNAMIC_MESH_ATTRIBUTE_COUNT; attribute++) {
+        const uint8_t components = layout.mComponents[attribute];
+        if(components == 0) {
+            mBufferIndices[attribute] = -1;
+            continue;
+        }
+        mOffsets[attribute] = numFloats;
+        numFloats += components * layout.mMaxVertices;
+        mBufferIndices[attribute] = numVertexBuffers;
+        if(attribute == DYNAMIC_MESH_NORMAL) {
+            builder.attribute(VertexAttribute::TANGENTS, numVertexBuffers++, VertexBuffer::AttributeType::SHORT4);
+            builder.normalized(VertexAttribute::TANGENTS);
+        } else {
+            builder.attribute(toVertexAttribute(attribute), numVertexBuffers++, toAttributeType(components));
+        }
+    }
+    builder.bufferCount(numVertexBuffers);
+
+    for(auto& slot : mSlots) {
+        slot.mVertices.resize(numFloats, 0.0f);
+        slot.mIndices.resize(layout.mMaxIndices, 0);
+        if(layout.mComponents[DYNAMIC_MESH_NORMAL]) {
+            slot.mTangents.resize(layout.mMaxVertices);
+        }
+    }
+    for(uint32_t i = 0; i < numBuffers; i++) {
+        mVertexBuffers.push_back(builder.build(engine));
+        mIndexBuffers.push_back(IndexBuffer::Builder()
+            .indexCount(layout.mMaxIndices)
+            .bufferType(IndexBuffer::IndexType::UINT)
+            .build(engine));
+    }
+
+    mMaterialInstance = mMaterial->createInstance();
+    mEntity = utils::EntityManager::get().create();
+    // nothing is drawn (or added to the scene) until the first publish
+    RenderableManager::Builder(1)
+        .boundingBox({ float3(0.0f), float3(0.0f) })
+        .material(0, mMaterialInstance)
+        .geometry(0, mType, mVertexBuffers[0], mIndexBuffers[0], 0, 0)
+        .build(engine, mEntity);
+    engine.getTransformManager().create(mEntity);
+}
+
+void DynamicMesh::destroy(Engine& engine, Scene& scene) {
+    scene.remove(mEntity);
+    engine.destroy(mEntity);
+    engine.getTransformManager().destroy(mEntity);
+    utils::EntityManager::get().destroy(mEntity);
+    for(auto* vertexBuffer : mVertexBuffers) {
+        engine.destroy(vertexBuffer);
+    }
+    for(auto* indexBuffer : mIndexBuffers) {
+        engine.destroy(indexBuffer);
+    }
+    engine.destroy(mMaterialInstance);
+    engine.destroy(mMaterial);
+    mVertexBuffers.clear();
+    mIndexBuffers.clear();
+    // the slots may still be referenced by uploads in flight
+    engine.flushAndWait();
+}
+
+float* DynamicMesh::getAttribute(uint32_t slot, DynamicMeshAttribute attribute) {
+    if(mLayout.mComponents[attribute] == 0) {
+        return nullptr;
+    }
+    return mSlots[slot].mVertices.data() + mOffsets[attribute];
+}
+
+uint32_t DynamicMesh::publish(uint32_t numVertices, uint32_t numIndices) {
+    Slot& slot = mSlots[mWriteSlot];
+    slot.mNumVertices = std::min(numVertices, mLayout.mMaxVertices);
+    slot.mNumIndices = std::min(numIndices, mLayout.mMaxIndices);
+    // release makes the writes to the slot visible to the consumer that acquires it
+    const uint64_t previous = mPublished.exchange(pack(++mSequence, mWriteSlot), std::memory_order_acq_rel);
+    mWriteSlot = previous & 0xFF;
+    return mWriteSlot;
+}
+
+bool DynamicMesh::acquire() {
+    // the slot we're reading can't be handed back until Filament is done with it; the next frame will pick up the latest publish instead
+    if(mSlots[mReadSlot].mPendingUploads.load(std::memory_order_acquire) > 0) {
+        return false;
+    }
+    uint64_t published = mPublished.load(std::memory_order_acquire);
+    while(true) {
+        const uint64_t sequence = published >> 8;
+        if(sequence == mLastSequence) {
+            return false;
+        }
+        if(mPublished.compare_exchange_weak(published, pack(sequence, mReadSlot), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            mReadSlot = published & 0xFF;
+            mLastSequence = sequence;
+            return true;
+        }
+    }
+}
+
+bool DynamicMesh::update(Engine& engine, Scene& scene) {
+    if(!acquire()) {
+        return false;
+    }
+    upload(mSlots[mReadSlot], engine, scene);
+    return true;
+}
+
+void DynamicMesh::upload(Slot& slot, Engine& engine, Scene& scene) {
+    const size_t numVertices = slot.mNumVertices;
+    const size_t numIndices = slot.mNumIndices;
+    if(numVertices == 0 || numIndices == 0) {
+        scene.remove(mEntity);
+        return;
+    }
+
+    VertexBuffer* vertexBuffer = mVertexBuffers[mNextBuffer];
+    IndexBuffer* indexBuffer = mIndexBuffers[mNextBuffer];
+    mNextBuffer = (mNextBuffer + 1) % mVertexBuffers.size();
+
+    for(int attribute = 0; attribute < DYNAMIC_MESH_ATTRIBUTE_COUNT; attribute++) {
+        if(mBufferIndices[attribute] < 0) {
+            continue;
+        }
+        const float* values = slot.mVertices.data() + mOffsets[attribute];
+        slot.mPendingUploads.fetch_add(1, std::memory_order_relaxed);
+        if(attribute == DYNAMIC_MESH_NORMAL) {
+            auto* orientation = geometry::SurfaceOrientation::Builder()
+                .vertexCount(numVertices)
+                .normals(reinterpret_cast<const float3*>(values))
+                .build();
+            orientation->getQuats(slot.mTangents.data(), numVertices);
+            delete orientation;
+            vertexBuffer->setBufferAt(engine, mBufferIndices[attribute],
+                VertexBuffer::BufferDescriptor(slot.mTangents.data(), numVertices * sizeof(short4), releaseUpload, &slot.mPendingUploads));
+        } else {
+            // only the vertices in use are uploaded, straight from the slot
+            vertexBuffer->setBufferAt(engine, mBufferIndices[attribute],
+                VertexBuffer::BufferDescriptor(values, numVertices * mLayout.mComponents[attribute] * sizeof(float), releaseUpload, &slot.mPendingUploads));
+        }
+    }
+    slot.mPendingUploads.fetch_add(1, std::memory_order_relaxed);
+    indexBuffer->setBuffer(engine,
+        IndexBuffer::BufferDescriptor(slot.mIndices.data(), numIndices * sizeof(uint32_t), releaseUpload, &slot.mPendingUploads));
+
+    const float3* positions = reinterpret_cast<const float3*>(slot.mVertices.data() + mOffsets[DYNAMIC_MESH_POSITION]);
+    float3 lo(std::numeric_limits<float>::max());
+    float3 hi(std::numeric_limits<float>::lowest());
+    for(size_t i = 0; i < numVertices; i++) {
+        lo = min(lo, positions[i]);
+        hi = max(hi, positions[i]);
+    }
+
+    auto& rm = engine.getRenderableManager();
+    const auto instance = rm.getInstance(mEntity);
+    rm.setGeometryAt(instance, 0, mType, vertexBuffer, indexBuffer, 0, numIndices);
+    rm.setAxisAlignedBoundingBox(instance, Box().set(lo, hi));
+    if(!scene.hasEntity(mEntity)) {
+        scene.addEntity(mEntity);
+    }
+}
+
+}
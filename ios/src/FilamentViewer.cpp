@@ -80,6 +80,7 @@
 #include "StreamBufferAdapter.hpp"
 #include "material/image.h"
 #include "TimeIt.hpp"
+#include "ProgramBlobCache.hpp"
 
 using namespace filament;
 using namespace filament::math;
@@ -115,6 +116,64 @@ namespace polyvox
 
   static const uint16_t sFullScreenTriangleIndices[3] = {0, 1, 2};
 
+#if !defined(__APPLE__)
+  static constexpr size_t kDefaultProgramCacheSize = 64 * 1024 * 1024;
+
+  static std::mutex sProgramCacheMutex;
+  static bool sProgramCacheConfigured = false;
+  // intentionally never freed; a platform may hold callbacks into the cache for the lifetime of the process
+  static ProgramBlobCache *sProgramCache = nullptr;
+
+  static std::string defaultProgramCacheDirectory()
+  {
+#if defined(_WIN32)
+    const char *localAppData = getenv("LOCALAPPDATA");
+    if (localAppData)
+    {
+      return std::string(localAppData) + "\\flutter_filament\\programs";
+    }
+#elif !defined(__ANDROID__)
+    const char *xdgCache = getenv("XDG_CACHE_HOME");
+    if (xdgCache)
+    {
+      return std::string(xdgCache) + "/flutter_filament/programs";
+    }
+    const char *home = getenv("HOME");
+    if (home)
+    {
+      return std::string(home) + "/.cache/flutter_filament/programs";
+    }
+#endif
+    // Android has no well-known writable location; the caller must provide one via configureProgramCache.
+    return std::string();
+  }
+
+  static ProgramBlobCache *getProgramCache()
+  {
+    std::lock_guard lock(sProgramCacheMutex);
+    if (!sProgramCacheConfigured)
+    {
+      sProgramCacheConfigured = true;
+      auto directory = defaultProgramCacheDirectory();
+      if (!directory.empty())
+      {
+        sProgramCache = new ProgramBlobCache(directory.c_str(), kDefaultProgramCacheSize, nullptr);
+      }
+    }
+    return sProgramCache && sProgramCache->isValid() ? sProgramCache : nullptr;
+  }
+#endif
+
+  void FilamentViewer::configureProgramCache(const char *directory, size_t maxSizeInBytes, const char *driverTag)
+  {
+#if !defined(__APPLE__)
+    std::lock_guard lock(sProgramCacheMutex);
+    sProgramCacheConfigured = true;
+    // any previous cache may still be attached to a live platform, so it is leaked rather than deleted
+    sProgramCache = directory ? new ProgramBlobCache(directory, maxSizeInBytes == 0 ? kDefaultProgramCacheSize : maxSizeInBytes, driverTag) : nullptr;
+#endif
+  }
+
   FilamentViewer::FilamentViewer(const void *sharedContext, const ResourceLoaderWrapper *const resourceLoaderWrapper, void *const platform, const char *uberArchivePath)
       : _resourceLoaderWrapper(resourceLoaderWrapper)
   {
@@ -129,6 +188,12 @@ namespace polyvox
     _engine = Engine::create(Engine::Backend::METAL);
 #else
     _engine = Engine::create(Engine::Backend::OPENGL, (backend::Platform *)platform, (void *)sharedContext, nullptr);
+    // programs are only compiled once materials are created, so attaching after Engine::create is early enough
+    auto programCache = getProgramCache();
+    if (programCache)
+    {
+      programCache->attach(_engine->getPlatform());
+    }
 #endif
 
     _renderer = _engine->createRenderer();
@@ -348,6 +413,73 @@ namespace polyvox
     _lights.clear();
   }
 
+  DynamicMesh *FilamentViewer::createDynamicMesh(const char *const materialPath, RenderableManager::PrimitiveType type, const int *const components, int maxVertices, int maxIndices, int numBuffers)
+  {
+    if (maxVertices <= 0 || maxIndices <= 0)
+    {
+      Log("ERROR: a dynamic mesh needs at least one vertex and index.");
+      return nullptr;
+    }
+    if (numBuffers < 2 || numBuffers > 3)
+    {
+      Log("ERROR: dynamic meshes must be double or triple buffered (not %d).", numBuffers);
+      return nullptr;
+    }
+    if (components[DYNAMIC_MESH_POSITION] != 3)
+    {
+      Log("ERROR: dynamic mesh positions must have 3 components.");
+      return nullptr;
+    }
+    DynamicMesh::Layout layout;
+    layout.mMaxVertices = maxVertices;
+    layout.mMaxIndices = maxIndices;
+    for (int i = 0; i < DYNAMIC_MESH_ATTRIBUTE_COUNT; i++)
+    {
+      const int expected = i == DYNAMIC_MESH_NORMAL ? 3 : i == DYNAMIC_MESH_UV ? 2 : i == DYNAMIC_MESH_COLOR ? 4 : 0;
+      if (components[i] < 0 || components[i] > 4 || (expected > 0 && components[i] != 0 && components[i] != expected))
+      {
+        Log("ERROR: dynamic mesh attribute %d can't have %d components.", i, components[i]);
+        return nullptr;
+      }
+      layout.mComponents[i] = components[i];
+    }
+
+    ResourceBuffer rbuf = _resourceLoaderWrapper->load(materialPath);
+    if (!rbuf.data || rbuf.size == 0)
+    {
+      Log("Failed to load material package at %s", materialPath);
+      return nullptr;
+    }
+    Material *material = Material::Builder()
+                             .package(rbuf.data, rbuf.size)
+                             .build(*_engine);
+    _resourceLoaderWrapper->free(rbuf);
+    if (!material)
+    {
+      Log("ERROR: failed to build material %s", materialPath);
+      return nullptr;
+    }
+
+    auto *mesh = new DynamicMesh(layout, type, numBuffers, material, *_engine);
+    _dynamicMeshes.push_back(mesh);
+    Log("Created dynamic mesh under entity ID %d with %d vertices and %d indices", Entity::smuggle(mesh->getEntity()), maxVertices, maxIndices);
+    return mesh;
+  }
+
+  bool FilamentViewer::removeDynamicMesh(DynamicMesh *mesh)
+  {
+    auto it = std::find(_dynamicMeshes.begin(), _dynamicMeshes.end(), mesh);
+    if (it == _dynamicMeshes.end())
+    {
+      Log("ERROR: dynamic mesh not found.");
+      return false;
+    }
+    _dynamicMeshes.erase(it);
+    mesh->destroy(*_engine, *_scene);
+    delete mesh;
+    return true;
+  }
+
   static bool endsWith(string path, string ending)
   {
     return path.compare(path.length() - ending.length(), ending.length(), ending) == 0;
@@ -616,9 +748,26 @@ namespace polyvox
 
   FilamentViewer::~FilamentViewer()
   {
+    // waits for any in-flight decoding to finish
+    delete _environmentWorker;
+    delete _iblPrefilter;
+    finishEnvironmentFade();
+    for (auto &retired : _retiredEnvironments)
+    {
+      destroyEnvironment(retired.environment);
+    }
+    _retiredEnvironments.clear();
+
     clearAssets();
     delete _assetManager;
 
+    for (auto *mesh : _dynamicMeshes)
+    {
+      mesh->destroy(*_engine, *_scene);
+      delete mesh;
+    }
+    _dynamicMeshes.clear();
+
     for (auto it : _lights)
     {
       _engine->destroy(it);
@@ -736,6 +885,15 @@ namespace polyvox
     cam.setExposure(aperture, shutterSpeed, sensitivity);
   }
 
+  ///
+  /// Tweens the exposure (aperture, shutter speed, sensitivity) of the current active camera.
+  /// The tween keeps targeting this camera even if another camera is made active.
+  ///
+  int32_t FilamentViewer::tweenCameraExposure(const float *const from, const float *const to, float durationInSecs, Easing easing)
+  {
+    return _assetManager->tween(Entity::smuggle(_view->getCamera().getEntity()), TweenProperty::CAMERA_EXPOSURE, from, to, durationInSecs, easing);
+  }
+
   ///
   /// Set the focal length of the active camera.
   ///
@@ -826,129 +984,354 @@ namespace polyvox
     return true;
   }
 
-  void FilamentViewer::loadSkybox(const char *const skyboxPath)
+  ///
+  /// Loads the resource at [path] on the calling thread (the resource loader may not be thread-safe), then parses it as a KTX1 bundle on the environment worker.
+  /// Returns an invalid future if the resource could not be loaded.
+  ///
+  std::future<std::unique_ptr<image::Ktx1Bundle>> FilamentViewer::loadKtxAsync(const char *const path)
   {
+    ResourceBuffer rb = _resourceLoaderWrapper->load(path);
+    if (rb.size <= 0)
+    {
+      Log("Could not load KTX resource at %s", path);
+      return {};
+    }
+    Log("Loaded KTX data of length %d from %s", rb.size, path);
+    auto data = std::make_shared<std::vector<uint8_t>>((const uint8_t *)rb.data, (const uint8_t *)rb.data + rb.size);
+    _resourceLoaderWrapper->free(rb);
 
-    removeSkybox();
+    if (!_environmentWorker)
+    {
+      _environmentWorker = new flutter_filament::ThreadPool();
+    }
+    std::packaged_task<std::unique_ptr<image::Ktx1Bundle>()> task([=]
+                                                                 { return std::make_unique<image::Ktx1Bundle>(data->data(), (uint32_t)data->size()); });
+    return _environmentWorker->add_task(task);
+  }
 
+  void FilamentViewer::loadSkybox(const char *const skyboxPath)
+  {
     if (!skyboxPath)
     {
-      Log("No skybox path provided, removed skybox.");
+      Log("No skybox path provided, removing skybox.");
+      removeSkybox();
+      return;
     }
+    loadEnvironment(skyboxPath, nullptr, 0.0f, 0.0f);
+  }
 
-    Log("Loading skybox from path %s", skyboxPath);
+  void FilamentViewer::loadIbl(const char *const iblPath, float intensity)
+  {
+    if (!iblPath)
+    {
+      removeIbl();
+      return;
+    }
+    loadEnvironment(nullptr, iblPath, intensity, 0.0f);
+  }
 
-    ResourceBuffer skyboxBuffer = _resourceLoaderWrapper->load(skyboxPath);
+  void FilamentViewer::loadEnvironment(const char *const skyboxPath, const char *const iblPath, float intensity, float crossfadeInSecs)
+  {
+    PendingEnvironment pending;
+    pending.intensity = intensity;
+    pending.crossfadeInSecs = crossfadeInSecs;
+    if (skyboxPath)
+    {
+      Log("Loading skybox from path %s", skyboxPath);
+      pending.skybox = loadKtxAsync(skyboxPath);
+    }
+    if (iblPath)
+    {
+      Log("Loading IBL from %s", iblPath);
+      pending.ibl = loadKtxAsync(iblPath);
+    }
+    if (!pending.skybox.valid() && !pending.ibl.valid())
+    {
+      Log("Error loading environment, no resources could be loaded.");
+      return;
+    }
+    _pendingEnvironments.push_back(std::move(pending));
+  }
 
-    // because this will go out of scope before the texture callback is invoked, we need to make a copy to the heap
-    ResourceBuffer *skyboxBufferCopy = new ResourceBuffer(skyboxBuffer);
+  void FilamentViewer::loadIblFromEquirect(const char *const path, float intensity, const char *const cacheDirectory)
+  {
+    Log("Loading equirectangular IBL from %s", path);
 
-    if (skyboxBuffer.size <= 0)
+    // the resource loader may not be safe to call from other threads, so we read the file here and hand a copy to the worker
+    ResourceBuffer rb = _resourceLoaderWrapper->load(path);
+    if (rb.size <= 0)
     {
-      Log("Could not load skybox resource.");
+      Log("Error loading IBL, resource could not be loaded.");
       return;
     }
+    auto source = std::make_shared<std::vector<uint8_t>>((const uint8_t *)rb.data, (const uint8_t *)rb.data + rb.size);
+    _resourceLoaderWrapper->free(rb);
 
-    Log("Loaded skybox data of length %d", skyboxBuffer.size);
+    if (!_environmentWorker)
+    {
+      _environmentWorker = new flutter_filament::ThreadPool();
+    }
 
-    std::vector<void *> *callbackData = new std::vector<void *>{(void *)_resourceLoaderWrapper, skyboxBufferCopy};
+    std::string sourceName(path);
+    std::string cacheDir(cacheDirectory ? cacheDirectory : "");
+    std::packaged_task<std::unique_ptr<DecodedEquirect>()> task([=]
+                                                               { return IblPrefilter::decode(source->data(), source->size(), sourceName.c_str(), cacheDir.empty() ? nullptr : cacheDir.c_str()); });
+    // replacing a pending future simply discards the earlier result when it completes
+    _pendingIbl = _environmentWorker->add_task(task);
+    _pendingIblIntensity = intensity;
+  }
 
-    image::Ktx1Bundle *skyboxBundle =
-        new image::Ktx1Bundle(static_cast<const uint8_t *>(skyboxBuffer.data),
-                              static_cast<uint32_t>(skyboxBuffer.size));
+  template <typename T>
+  static bool isReady(const std::future<T> &future)
+  {
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  }
 
-    _skyboxTexture =
-        ktxreader::Ktx1Reader::createTexture(
-            _engine, *skyboxBundle, false, [](void *userdata)
-            {
-        std::vector<void*>* vec = (std::vector<void*>*)userdata;
-        ResourceLoaderWrapper* loader = (ResourceLoaderWrapper*)vec->at(0);
-        ResourceBuffer* rb = (ResourceBuffer*) vec->at(1);
-        loader->free(*rb);
-        delete rb;
-        delete vec;
-        Log("Skybox load complete."); },
-            callbackData);
-    _skybox =
-        filament::Skybox::Builder().environment(_skyboxTexture).build(*_engine);
+  ///
+  /// Called once per frame on the render thread. Swaps in any environments that have finished loading,
+  /// advances the current crossfade (if any), and destroys environments that were swapped out a few frames ago.
+  ///
+  void FilamentViewer::updateEnvironment()
+  {
+    for (auto it = _retiredEnvironments.begin(); it != _retiredEnvironments.end();)
+    {
+      if (--it->framesRemaining <= 0)
+      {
+        destroyEnvironment(it->environment);
+        it = _retiredEnvironments.erase(it);
+      }
+      else
+      {
+        it++;
+      }
+    }
+
+    if (_environmentFade.active)
+    {
+      stepEnvironmentFade();
+    }
+
+    // environments are applied in the order they were requested, and only once any previous crossfade has completed
+    while (!_environmentFade.active && !_pendingEnvironments.empty())
+    {
+      auto &pending = _pendingEnvironments.front();
+      if ((pending.skybox.valid() && !isReady(pending.skybox)) || (pending.ibl.valid() && !isReady(pending.ibl)))
+      {
+        break;
+      }
+
+      Environment incoming;
+      bool replaceSkybox = false;
+      bool replaceIbl = false;
 
-    _scene->setSkybox(_skybox);
+      if (pending.skybox.valid())
+      {
+        // Ktx1Reader takes ownership of the bundle and frees it once uploaded
+        incoming.skyboxTexture = ktxreader::Ktx1Reader::createTexture(_engine, pending.skybox.get().release(), false);
+        incoming.skybox = filament::Skybox::Builder().environment(incoming.skyboxTexture).build(*_engine);
+        replaceSkybox = true;
+      }
+      if (pending.ibl.valid())
+      {
+        auto bundle = pending.ibl.get();
+        math::float3 harmonics[9];
+        bundle->getSphericalHarmonics(harmonics);
+        incoming.reflections = ktxreader::Ktx1Reader::createTexture(_engine, bundle.release(), false);
+        incoming.indirectLight = IndirectLight::Builder()
+                                     .reflections(incoming.reflections)
+                                     .irradiance(3, harmonics)
+                                     .intensity(pending.intensity)
+                                     .build(*_engine);
+        replaceIbl = true;
+      }
+      float intensity = pending.intensity;
+      float crossfadeInSecs = pending.crossfadeInSecs;
+      _pendingEnvironments.pop_front();
+      beginEnvironmentSwap(incoming, replaceSkybox, replaceIbl, intensity, crossfadeInSecs);
+    }
+
+    applyPendingIbl();
   }
 
-  void FilamentViewer::removeSkybox()
+  void FilamentViewer::beginEnvironmentSwap(Environment incoming, bool replaceSkybox, bool replaceIbl, float intensity, float crossfadeInSecs)
   {
-    Log("Removing skybox");
-    _scene->setSkybox(nullptr);
-    if (_skybox)
+    if (crossfadeInSecs > 0 && replaceIbl && _indirectLight)
+    {
+      _environmentFade.active = true;
+      _environmentFade.swapped = false;
+      _environmentFade.start = std::chrono::steady_clock::now();
+      _environmentFade.durationInSecs = crossfadeInSecs;
+      _environmentFade.outgoingIntensity = _indirectLight->getIntensity();
+      _environmentFade.incomingIntensity = intensity;
+      _environmentFade.incoming = incoming;
+      _environmentFade.replaceSkybox = replaceSkybox;
+      _environmentFade.replaceIbl = replaceIbl;
+      return;
+    }
+    swapEnvironment(incoming, replaceSkybox, replaceIbl);
+  }
+
+  ///
+  /// Fades the outgoing IBL to zero over the first half of the crossfade, swaps the environment at the midpoint, then fades the incoming IBL in over the second half.
+  /// (Filament can only have a single IndirectLight per scene, so two IBLs can't be blended directly).
+  ///
+  void FilamentViewer::stepEnvironmentFade()
+  {
+    auto &fade = _environmentFade;
+    float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - fade.start).count();
+    float t = std::min(elapsed / fade.durationInSecs, 1.0f);
+    if (!fade.swapped)
     {
-      _engine->destroy(_skybox);
-      _skybox = nullptr;
+      if (t < 0.5f)
+      {
+        _indirectLight->setIntensity(fade.outgoingIntensity * (1.0f - 2.0f * t));
+        return;
+      }
+      swapEnvironment(fade.incoming, fade.replaceSkybox, fade.replaceIbl);
+      fade.incoming = {};
+      fade.swapped = true;
     }
-    if (_skyboxTexture)
+    if (t >= 1.0f)
+    {
+      _indirectLight->setIntensity(fade.incomingIntensity);
+      fade.active = false;
+    }
+    else
     {
-      _engine->destroy(_skyboxTexture);
-      _skyboxTexture = nullptr;
+      _indirectLight->setIntensity(fade.incomingIntensity * (2.0f * t - 1.0f));
     }
   }
 
-  void FilamentViewer::removeIbl()
+  void FilamentViewer::finishEnvironmentFade()
   {
+    if (!_environmentFade.active)
+    {
+      return;
+    }
+    if (!_environmentFade.swapped)
+    {
+      swapEnvironment(_environmentFade.incoming, _environmentFade.replaceSkybox, _environmentFade.replaceIbl);
+      _environmentFade.incoming = {};
+    }
     if (_indirectLight)
     {
-      _engine->destroy(_indirectLight);
-      _engine->destroy(_iblTexture);
-      _indirectLight = nullptr;
-      _iblTexture = nullptr;
+      _indirectLight->setIntensity(_environmentFade.incomingIntensity);
     }
-    _scene->setIndirectLight(nullptr);
+    _environmentFade.active = false;
   }
 
-  void FilamentViewer::loadIbl(const char *const iblPath, float intensity)
+  ///
+  /// Atomically (i.e. within a single frame) replaces the skybox and/or IBL, retiring the outgoing resources.
+  ///
+  void FilamentViewer::swapEnvironment(Environment incoming, bool replaceSkybox, bool replaceIbl)
   {
-    removeIbl();
-    if (iblPath)
+    Environment outgoing;
+    if (replaceSkybox)
     {
-      Log("Loading IBL from %s", iblPath);
+      outgoing.skybox = _skybox;
+      outgoing.skyboxTexture = _skyboxTexture;
+      _skybox = incoming.skybox;
+      _skyboxTexture = incoming.skyboxTexture;
+      _scene->setSkybox(_skybox);
+    }
+    if (replaceIbl)
+    {
+      outgoing.indirectLight = _indirectLight;
+      outgoing.reflections = _iblTexture;
+      outgoing.irradiance = _iblIrradianceTexture;
+      _indirectLight = incoming.indirectLight;
+      _iblTexture = incoming.reflections;
+      _iblIrradianceTexture = incoming.irradiance;
+      _scene->setIndirectLight(_indirectLight);
+    }
+    retireEnvironment(outgoing);
+  }
 
-      // Load IBL.
-      ResourceBuffer iblBuffer = _resourceLoaderWrapper->load(iblPath);
-      // because this will go out of scope before the texture callback is invoked, we need to make a copy to the heap
-      ResourceBuffer *iblBufferCopy = new ResourceBuffer(iblBuffer);
+  void FilamentViewer::retireEnvironment(Environment environment)
+  {
+    // the outgoing resources may still be referenced by frames in flight, so they are destroyed a few frames later
+    _retiredEnvironments.push_back({kEnvironmentRetireFrames, environment});
+  }
 
-      if (iblBuffer.size == 0)
-      {
-        Log("Error loading IBL, resource could not be loaded.");
-        return;
-      }
+  void FilamentViewer::destroyEnvironment(Environment &environment)
+  {
+    if (environment.skybox)
+    {
+      _engine->destroy(environment.skybox);
+    }
+    if (environment.skyboxTexture)
+    {
+      _engine->destroy(environment.skyboxTexture);
+    }
+    if (environment.indirectLight)
+    {
+      _engine->destroy(environment.indirectLight);
+    }
+    if (environment.reflections)
+    {
+      _engine->destroy(environment.reflections);
+    }
+    if (environment.irradiance)
+    {
+      _engine->destroy(environment.irradiance);
+    }
+    environment = {};
+  }
 
-      image::Ktx1Bundle *iblBundle =
-          new image::Ktx1Bundle(static_cast<const uint8_t *>(iblBuffer.data),
-                                static_cast<uint32_t>(iblBuffer.size));
-      math::float3 harmonics[9];
-      iblBundle->getSphericalHarmonics(harmonics);
-
-      std::vector<void *> *callbackData = new std::vector<void *>{(void *)_resourceLoaderWrapper, iblBufferCopy};
-
-      _iblTexture =
-          ktxreader::Ktx1Reader::createTexture(
-              _engine, *iblBundle, false, [](void *userdata)
-              {
-            std::vector<void*>* vec = (std::vector<void*>*)userdata;
-            ResourceLoaderWrapper* loader = (ResourceLoaderWrapper*)vec->at(0);
-            ResourceBuffer* rb = (ResourceBuffer*) vec->at(1);
-            loader->free(*rb);
-            delete rb;
-            delete vec; },
-              callbackData);
-      _indirectLight = IndirectLight::Builder()
-                           .reflections(_iblTexture)
-                           .irradiance(3, harmonics)
-                           .intensity(intensity)
-                           .build(*_engine);
-      _scene->setIndirectLight(_indirectLight);
+  void FilamentViewer::removeSkybox()
+  {
+    Log("Removing skybox");
+    finishEnvironmentFade();
+    // a skybox that is still loading would otherwise replace the removed one
+    for (auto &pending : _pendingEnvironments)
+    {
+      pending.skybox = {};
+    }
+    swapEnvironment({}, true, false);
+  }
 
-      Log("IBL loaded.");
+  void FilamentViewer::removeIbl()
+  {
+    finishEnvironmentFade();
+    // discard any IBL still loading/being prefiltered so it doesn't replace whatever is set next
+    for (auto &pending : _pendingEnvironments)
+    {
+      pending.ibl = {};
     }
+    _pendingIbl = {};
+    swapEnvironment({}, false, true);
+  }
+
+  void FilamentViewer::applyPendingIbl()
+  {
+    if (!_pendingIbl.valid() || !isReady(_pendingIbl))
+    {
+      return;
+    }
+    auto equirect = _pendingIbl.get();
+    if (!equirect)
+    {
+      Log("Decoding IBL failed, keeping the current IBL.");
+      return;
+    }
+    if (!_iblPrefilter)
+    {
+      _iblPrefilter = new IblPrefilter(_engine);
+    }
+    Environment incoming;
+    if (!_iblPrefilter->prefilter(*equirect, &incoming.reflections, &incoming.irradiance))
+    {
+      Log("Prefiltering IBL failed, keeping the current IBL.");
+      destroyEnvironment(incoming);
+      return;
+    }
+    incoming.indirectLight = IndirectLight::Builder()
+                                 .reflections(incoming.reflections)
+                                 .irradiance(incoming.irradiance)
+                                 .intensity(_pendingIblIntensity)
+                                 .build(*_engine);
+    swapEnvironment(incoming, false, true);
+    Log("Prefiltered IBL applied.");
   }
 
   double _elapsed = 0;
@@ -974,13 +1357,30 @@ namespace polyvox
       _frameCount = 0;
     }
 
+    updateEnvironment();
+
+    // the FFI render loop doesn't supply a frame time, so fall back to a single clock read per frame
+    uint64_t frameTime = frameTimeInNanos > 0 ? frameTimeInNanos : std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    float deltaInSecs = 0.0f;
+    if (_lastFrameTimeInNanos > 0 && frameTime > _lastFrameTimeInNanos)
+    {
+      // clamped so a stall (e.g. the app being backgrounded) doesn't skip animations forward
+      deltaInSecs = std::min((frameTime - _lastFrameTimeInNanos) / 1e9f, kMaxAnimationDeltaInSecs);
+    }
+    _lastFrameTimeInNanos = frameTime;
+
     Timer tmr;
 
-    _assetManager->updateAnimations();
+    _assetManager->updateAnimations(deltaInSecs, &_view->getCamera());
 
     _elapsed += tmr.elapsed();
     _frameCount++;
 
+    for (auto *mesh : _dynamicMeshes)
+    {
+      mesh->update(*_engine, *_scene);
+    }
+
     // if a manipulator is active, update the active camera orientation
     if (_manipulator)
     {
@@ -4,6 +4,10 @@
 #include "filament/LightManager.h"
 #include "Log.hpp"
 #include "ThreadPool.hpp"
+#include "BoneTracks.hpp"
+#include "CompressedTracks.hpp"
+#include "LivePoseStream.hpp"
+#include "DynamicMesh.hpp"
 
 #include <thread>
 #include <functional>
@@ -15,6 +19,11 @@ extern "C"
 
 #include "FlutterFilamentApi.h"
 
+    FLUTTER_PLUGIN_EXPORT void configure_program_cache(const char *directory, size_t maxSizeInBytes, const char *driverTag)
+    {
+        FilamentViewer::configureProgramCache(directory, maxSizeInBytes, driverTag);
+    }
+
     FLUTTER_PLUGIN_EXPORT const void *create_filament_viewer(const void *context, const ResourceLoaderWrapper *const loader, void *const platform, const char *uberArchivePath)
     {
         return (const void *)new FilamentViewer(context, loader, platform, uberArchivePath);
@@ -76,6 +85,16 @@ extern "C"
         ((FilamentViewer *)viewer)->loadIbl(iblPath, intensity);
     }
 
+    FLUTTER_PLUGIN_EXPORT void load_ibl_from_equirect(const void *const viewer, const char *path, float intensity, const char *cacheDirectory)
+    {
+        ((FilamentViewer *)viewer)->loadIblFromEquirect(path, intensity, cacheDirectory);
+    }
+
+    FLUTTER_PLUGIN_EXPORT void load_environment(const void *const viewer, const char *skyboxPath, const char *iblPath, float intensity, float crossfadeInSecs)
+    {
+        ((FilamentViewer *)viewer)->loadEnvironment(skyboxPath, iblPath, intensity, crossfadeInSecs);
+    }
+
     FLUTTER_PLUGIN_EXPORT void remove_skybox(const void *const viewer)
     {
         ((FilamentViewer *)viewer)->removeSkybox();
@@ -101,11 +120,69 @@ extern "C"
         ((FilamentViewer *)viewer)->clearLights();
     }
 
+    FLUTTER_PLUGIN_EXPORT void *create_dynamic_mesh(const void *const viewer, const char *materialPath, int primitiveType, const int *const components, int maxVertices, int maxIndices, int numBuffers)
+    {
+        auto type = (RenderableManager::PrimitiveType)primitiveType;
+        if (type != RenderableManager::PrimitiveType::POINTS && type != RenderableManager::PrimitiveType::LINES && type != RenderableManager::PrimitiveType::LINE_STRIP &&
+            type != RenderableManager::PrimitiveType::TRIANGLES && type != RenderableManager::PrimitiveType::TRIANGLE_STRIP)
+        {
+            Log("ERROR: unsupported primitive type %d", primitiveType);
+            return nullptr;
+        }
+        return ((FilamentViewer *)viewer)->createDynamicMesh(materialPath, type, components, maxVertices, maxIndices, numBuffers);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool remove_dynamic_mesh(const void *const viewer, void *const mesh)
+    {
+        return ((FilamentViewer *)viewer)->removeDynamicMesh((DynamicMesh *)mesh);
+    }
+
+    FLUTTER_PLUGIN_EXPORT EntityId get_dynamic_mesh_entity(void *const mesh)
+    {
+        return Entity::smuggle(((DynamicMesh *)mesh)->getEntity());
+    }
+
+    FLUTTER_PLUGIN_EXPORT float *get_dynamic_mesh_attribute(void *const mesh, int slot, int attribute)
+    {
+        if (slot < 0 || slot >= (int)DynamicMesh::NUM_SLOTS || attribute < 0 || attribute >= DYNAMIC_MESH_ATTRIBUTE_COUNT)
+        {
+            Log("ERROR: dynamic mesh slot %d or attribute %d is out of range.", slot, attribute);
+            return nullptr;
+        }
+        return ((DynamicMesh *)mesh)->getAttribute(slot, (DynamicMeshAttribute)attribute);
+    }
+
+    FLUTTER_PLUGIN_EXPORT uint32_t *get_dynamic_mesh_indices(void *const mesh, int slot)
+    {
+        if (slot < 0 || slot >= (int)DynamicMesh::NUM_SLOTS)
+        {
+            Log("ERROR: dynamic mesh slot %d is out of range.", slot);
+            return nullptr;
+        }
+        return ((DynamicMesh *)mesh)->getIndices(slot);
+    }
+
+    FLUTTER_PLUGIN_EXPORT int get_dynamic_mesh_write_slot(void *const mesh)
+    {
+        return ((DynamicMesh *)mesh)->getWriteSlot();
+    }
+
+    // like publish_live_pose, this can be called directly from any thread at any rate
+    FLUTTER_PLUGIN_EXPORT int publish_dynamic_mesh(void *const mesh, int numVertices, int numIndices)
+    {
+        return ((DynamicMesh *)mesh)->publish(std::max(numVertices, 0), std::max(numIndices, 0));
+    }
+
     FLUTTER_PLUGIN_EXPORT EntityId load_glb(void *assetManager, const char *assetPath, bool unlit)
     {
         return ((AssetManager *)assetManager)->loadGlb(assetPath, unlit);
     }
 
+    FLUTTER_PLUGIN_EXPORT bool add_material_specialization(void *assetManager, const char *packagePath, uint32_t features)
+    {
+        return ((AssetManager *)assetManager)->addMaterialSpecialization(packagePath, features);
+    }
+
     FLUTTER_PLUGIN_EXPORT EntityId load_gltf(void *assetManager, const char *assetPath, const char *relativePath)
     {
         return ((AssetManager *)assetManager)->loadGltf(assetPath, relativePath);
@@ -193,6 +270,11 @@ extern "C"
         ((FilamentViewer *)viewer)->setCameraExposure(aperture, shutterSpeed, sensitivity);
     }
 
+    FLUTTER_PLUGIN_EXPORT int32_t tween_camera_exposure(const void *const viewer, const float *const from, const float *const to, float durationInSecs, int easing)
+    {
+        return ((FilamentViewer *)viewer)->tweenCameraExposure(from, to, durationInSecs, (Easing)easing);
+    }
+
     FLUTTER_PLUGIN_EXPORT void set_camera_position(const void *const viewer, float x, float y, float z)
     {
         ((FilamentViewer *)viewer)->setCameraPosition(x, y, z);
@@ -329,6 +411,143 @@ extern "C"
         ((AssetManager *)assetManager)->setBoneAnimationBuffer(asset, frameData, numFrames, numBones, boneNames, meshNames, numMeshTargets, frameLengthInMs);
     }
 
+    FLUTTER_PLUGIN_EXPORT bool set_bone_animation_trs(
+        void *assetManager,
+        EntityId asset,
+        const float *const frameData,
+        int numFrames,
+        int numBones,
+        const char **const boneNames,
+        const char **const meshNames,
+        int numMeshTargets,
+        float frameLengthInMs)
+    {
+        return ((AssetManager *)assetManager)->setBoneAnimationBuffer(asset, frameData, numFrames, numBones, boneNames, meshNames, numMeshTargets, frameLengthInMs, true);
+    }
+
+    FLUTTER_PLUGIN_EXPORT void set_animation_compression(void *assetManager, bool enabled, float maxError)
+    {
+        ((AssetManager *)assetManager)->setAnimationCompression(enabled, maxError);
+    }
+
+    FLUTTER_PLUGIN_EXPORT size_t compress_morph_animation(
+        const float *const morphData,
+        int numMorphTargets,
+        int numFrames,
+        float frameLengthInMs,
+        float maxError,
+        uint8_t *out,
+        size_t capacity)
+    {
+        if (numFrames <= 0 || numMorphTargets <= 0 || frameLengthInMs <= 0)
+        {
+            Log("ERROR: morph animation must contain at least one frame and one morph target, with a positive frame length.");
+            return 0;
+        }
+        auto tracks = CompressedMorphTracks::compress(morphData, numFrames, numMorphTargets, frameLengthInMs, maxError);
+        return tracks->serialize(out, capacity);
+    }
+
+    FLUTTER_PLUGIN_EXPORT size_t compress_bone_animation(
+        const float *const frameData,
+        int numFrames,
+        int numBones,
+        bool includesScale,
+        float frameLengthInMs,
+        float maxError,
+        uint8_t *out,
+        size_t capacity)
+    {
+        if (numFrames <= 0 || numBones <= 0 || frameLengthInMs <= 0)
+        {
+            Log("ERROR: bone animation must contain at least one frame and one bone, with a positive frame length.");
+            return 0;
+        }
+        std::vector<float> tracks(numFrames * numBones * BoneTrack::COMPONENT_COUNT);
+        interleavedToBoneTracks(frameData, numFrames, numBones, includesScale, tracks.data());
+        auto compressed = CompressedBoneTracks::compress(tracks.data(), numFrames, numBones, includesScale, frameLengthInMs, maxError);
+        return compressed->serialize(out, capacity);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_morph_animation_compressed(
+        void *assetManager,
+        EntityId asset,
+        const char *const entityName,
+        const void *const data,
+        size_t size,
+        const int *const morphIndices,
+        int numMorphTargets)
+    {
+        return ((AssetManager *)assetManager)->setCompressedMorphAnimationBuffer(asset, entityName, data, size, morphIndices, numMorphTargets);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_bone_animation_compressed(
+        void *assetManager,
+        EntityId asset,
+        const void *const data,
+        size_t size,
+        int numBones,
+        const char **const boneNames,
+        const char **const meshNames,
+        int numMeshTargets)
+    {
+        return ((AssetManager *)assetManager)->setCompressedBoneAnimationBuffer(asset, data, size, numBones, boneNames, meshNames, numMeshTargets);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_morph_animation_curves(
+        void *assetManager,
+        EntityId asset,
+        const char *const entityName,
+        const int *const morphIndices,
+        const int *const interpolations,
+        const int *const keyCounts,
+        const float *const keys,
+        int numCurves)
+    {
+        return ((AssetManager *)assetManager)->setMorphAnimationCurves(asset, entityName, morphIndices, interpolations, keyCounts, keys, numCurves);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_bone_animation_curves(
+        void *assetManager,
+        EntityId asset,
+        const char **const boneNames,
+        int numBones,
+        const char **const meshNames,
+        int numMeshTargets,
+        const int *const channels,
+        const int *const interpolations,
+        const int *const keyCounts,
+        const float *const keys,
+        int numCurves)
+    {
+        return ((AssetManager *)assetManager)->setBoneAnimationCurves(asset, boneNames, numBones, meshNames, numMeshTargets, channels, interpolations, keyCounts, keys, numCurves);
+    }
+
+    FLUTTER_PLUGIN_EXPORT int create_skeleton(void *assetManager, const char **const boneNames, int numBones, const float *const restPose)
+    {
+        return ((AssetManager *)assetManager)->createSkeleton(boneNames, numBones, restPose);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool remove_skeleton(void *assetManager, int skeleton)
+    {
+        return ((AssetManager *)assetManager)->removeSkeleton(skeleton);
+    }
+
+    FLUTTER_PLUGIN_EXPORT int create_bone_animation_clip(void *assetManager, int skeleton, const float *const frameData, int numFrames, float frameLengthInMs)
+    {
+        return ((AssetManager *)assetManager)->createBoneAnimationClip(skeleton, frameData, numFrames, frameLengthInMs, true);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool remove_bone_animation_clip(void *assetManager, int clip)
+    {
+        return ((AssetManager *)assetManager)->removeBoneAnimationClip(clip);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_bone_animation_clip(void *assetManager, EntityId asset, int clip)
+    {
+        return ((AssetManager *)assetManager)->setBoneAnimationClip(asset, clip);
+    }
+
     FLUTTER_PLUGIN_EXPORT void set_post_processing(void *const viewer, bool enabled)
     {
         ((FilamentViewer *)viewer)->setPostProcessing(enabled);
@@ -368,18 +587,29 @@ extern "C"
         bool loop,
         bool reverse,
         bool replaceActive,
-        float crossfade)
+        float crossfade,
+        float startOffset)
+    {
+        ((AssetManager *)assetManager)->playAnimation(asset, index, loop, reverse, replaceActive, crossfade, startOffset);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool seek_animation(
+        void *assetManager,
+        EntityId asset,
+        int animationIndex,
+        float timeInSecs)
     {
-        ((AssetManager *)assetManager)->playAnimation(asset, index, loop, reverse, replaceActive, crossfade);
+        return ((AssetManager *)assetManager)->seekAnimation(asset, animationIndex, timeInSecs);
     }
 
-    FLUTTER_PLUGIN_EXPORT void set_animation_frame(
+    FLUTTER_PLUGIN_EXPORT bool set_animation_frame(
         void *assetManager,
         EntityId asset,
         int animationIndex,
-        int animationFrame)
+        int animationFrame,
+        float framesPerSecond)
     {
-        // ((AssetManager*)assetManager)->setAnimationFrame(asset, animationIndex, animationFrame);
+        return ((AssetManager *)assetManager)->setAnimationFrame(asset, animationIndex, animationFrame, framesPerSecond);
     }
 
     float get_animation_duration(void *assetManager, EntityId asset, int animationIndex)
@@ -391,8 +621,8 @@ extern "C"
         void *assetManager,
         EntityId asset)
     {
-        auto names = ((AssetManager *)assetManager)->getAnimationNames(asset);
-        return (int)names->size();
+        auto metadata = ((AssetManager *)assetManager)->getMetadata(asset);
+        return metadata ? (int)metadata->mAnimationNames.size() : 0;
     }
 
     FLUTTER_PLUGIN_EXPORT void get_animation_name(
@@ -401,22 +631,50 @@ extern "C"
         char *const outPtr,
         int index)
     {
-        auto names = ((AssetManager *)assetManager)->getAnimationNames(asset);
-        string name = names->at(index);
-        strcpy(outPtr, name.c_str());
+        auto metadata = ((AssetManager *)assetManager)->getMetadata(asset);
+        if (!metadata || index < 0 || index >= (int)metadata->mAnimationNames.size())
+        {
+            Log("ERROR: animation %d not found.", index);
+            outPtr[0] = '\0';
+            return;
+        }
+        strcpy(outPtr, metadata->mAnimationNames[index].c_str());
     }
 
     FLUTTER_PLUGIN_EXPORT int get_morph_target_name_count(void *assetManager, EntityId asset, const char *meshName)
     {
-        unique_ptr<vector<string>> names = ((AssetManager *)assetManager)->getMorphTargetNames(asset, meshName);
-        return (int)names->size();
+        auto metadata = ((AssetManager *)assetManager)->getMetadata(asset);
+        auto mesh = metadata ? metadata->findMesh(meshName) : nullptr;
+        return mesh ? (int)mesh->mMorphTargetNames.size() : 0;
     }
 
     FLUTTER_PLUGIN_EXPORT void get_morph_target_name(void *assetManager, EntityId asset, const char *meshName, char *const outPtr, int index)
     {
-        unique_ptr<vector<string>> names = ((AssetManager *)assetManager)->getMorphTargetNames(asset, meshName);
-        string name = names->at(index);
-        strcpy(outPtr, name.c_str());
+        auto metadata = ((AssetManager *)assetManager)->getMetadata(asset);
+        auto mesh = metadata ? metadata->findMesh(meshName) : nullptr;
+        if (!mesh || index < 0 || index >= (int)mesh->mMorphTargetNames.size())
+        {
+            Log("ERROR: morph target %d not found for mesh %s.", index, meshName);
+            outPtr[0] = '\0';
+            return;
+        }
+        strcpy(outPtr, mesh->mMorphTargetNames[index].c_str());
+    }
+
+    FLUTTER_PLUGIN_EXPORT int get_asset_metadata(void *assetManager, EntityId asset, char *const outPtr, int capacity)
+    {
+        auto metadata = ((AssetManager *)assetManager)->getMetadata(asset);
+        if (!metadata)
+        {
+            Log("ERROR: asset not found for entity.");
+            return -1;
+        }
+        const int length = (int)metadata->mJson.size();
+        if (outPtr && capacity > length)
+        {
+            memcpy(outPtr, metadata->mJson.c_str(), length + 1);
+        }
+        return length;
     }
 
     FLUTTER_PLUGIN_EXPORT void remove_asset(const void *const viewer, EntityId asset)
@@ -459,6 +717,223 @@ extern "C"
         ((AssetManager *)assetManager)->stopAnimation(asset, index);
     }
 
+    FLUTTER_PLUGIN_EXPORT void set_animation_time_scale(void *assetManager, float timeScale)
+    {
+        ((AssetManager *)assetManager)->setAnimationTimeScale(timeScale);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_asset_animation_time_scale(void *assetManager, EntityId asset, float timeScale)
+    {
+        return ((AssetManager *)assetManager)->setAnimationTimeScale(asset, timeScale);
+    }
+
+    FLUTTER_PLUGIN_EXPORT void set_animations_paused(void *assetManager, bool paused)
+    {
+        ((AssetManager *)assetManager)->setAnimationsPaused(paused);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_asset_animations_paused(void *assetManager, EntityId asset, bool paused)
+    {
+        return ((AssetManager *)assetManager)->setAnimationsPaused(asset, paused);
+    }
+
+    FLUTTER_PLUGIN_EXPORT void set_fixed_animation_timestep(void *assetManager, float timestepInSecs)
+    {
+        ((AssetManager *)assetManager)->setFixedAnimationTimestep(timestepInSecs);
+    }
+
+    FLUTTER_PLUGIN_EXPORT void set_animation_lod(void *assetManager, bool enabled, float halfRateScreenSize, float quarterRateScreenSize)
+    {
+        ((AssetManager *)assetManager)->setAnimationLod(enabled, halfRateScreenSize, quarterRateScreenSize);
+    }
+
+    FLUTTER_PLUGIN_EXPORT void set_animation_baking(void *assetManager, bool enabled, float sampleRate)
+    {
+        ((AssetManager *)assetManager)->setAnimationBaking(enabled, sampleRate);
+    }
+
+    FLUTTER_PLUGIN_EXPORT int add_animation_layer(void *assetManager, EntityId asset, int index, float weight, bool additive, bool loop)
+    {
+        return ((AssetManager *)assetManager)->addAnimationLayer(asset, index, weight, additive, loop);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool remove_animation_layer(void *assetManager, EntityId asset, int layer)
+    {
+        return ((AssetManager *)assetManager)->removeAnimationLayer(asset, layer);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_animation_layer_weight(void *assetManager, EntityId asset, int layer, float weight)
+    {
+        return ((AssetManager *)assetManager)->setAnimationLayerWeight(asset, layer, weight);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_animation_layer_time(void *assetManager, EntityId asset, int layer, float timeInSecs)
+    {
+        return ((AssetManager *)assetManager)->setAnimationLayerTime(asset, layer, timeInSecs);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_animation_layer_speed(void *assetManager, EntityId asset, int layer, float speed)
+    {
+        return ((AssetManager *)assetManager)->setAnimationLayerSpeed(asset, layer, speed);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_animation_layer_mask(void *assetManager, EntityId asset, int layer, const char **const jointNames, const float *const weights, int count, bool includeDescendants)
+    {
+        return ((AssetManager *)assetManager)->setAnimationLayerMask(asset, layer, jointNames, weights, count, includeDescendants);
+    }
+
+    FLUTTER_PLUGIN_EXPORT void get_skin_update_stats(void *assetManager, uint64_t *updated, uint64_t *skipped, bool reset)
+    {
+        ((AssetManager *)assetManager)->getSkinUpdateStats(updated, skipped, reset);
+    }
+
+    FLUTTER_PLUGIN_EXPORT int32_t tween_property(void *assetManager, EntityId entity, int property, const float *const from, const float *const to, float durationInSecs, int easing)
+    {
+        return ((AssetManager *)assetManager)->tween(entity, (TweenProperty)property, from, to, durationInSecs, (Easing)easing);
+    }
+
+    FLUTTER_PLUGIN_EXPORT int32_t tween_material_color(void *assetManager, EntityId asset, const char *meshName, int materialIndex, const float *const from, const float *const to, float durationInSecs, int easing)
+    {
+        return ((AssetManager *)assetManager)->tweenMaterialColor(asset, meshName, materialIndex, from, to, durationInSecs, (Easing)easing);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool cancel_tween(void *assetManager, int32_t tween)
+    {
+        return ((AssetManager *)assetManager)->cancelTween(tween);
+    }
+
+    FLUTTER_PLUGIN_EXPORT void set_tween_callback(void *assetManager, void (*callback)(int32_t tween, bool finished))
+    {
+        ((AssetManager *)assetManager)->setTweenCallback(callback);
+    }
+
+    FLUTTER_PLUGIN_EXPORT void *create_live_pose_stream(void *assetManager, EntityId asset, const char *meshName, const char **const boneNames, int numBones)
+    {
+        return ((AssetManager *)assetManager)->createLivePoseStream(asset, meshName, boneNames, numBones);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool remove_live_pose_stream(void *assetManager, EntityId asset)
+    {
+        return ((AssetManager *)assetManager)->removeLivePoseStream(asset);
+    }
+
+    FLUTTER_PLUGIN_EXPORT void get_live_pose_stream_layout(void *const stream, int *numMorphWeights, int *numBones)
+    {
+        *numMorphWeights = ((LivePoseStream *)stream)->getNumMorphWeights();
+        *numBones = ((LivePoseStream *)stream)->getNumBones();
+    }
+
+    FLUTTER_PLUGIN_EXPORT float *get_live_pose_stream_slot(void *const stream, int slot)
+    {
+        if (slot < 0 || slot >= (int)LivePoseStream::NUM_SLOTS)
+        {
+            Log("ERROR: live pose stream slot %d is out of range.", slot);
+            return nullptr;
+        }
+        return ((LivePoseStream *)stream)->getSlot(slot);
+    }
+
+    FLUTTER_PLUGIN_EXPORT int get_live_pose_stream_write_slot(void *const stream)
+    {
+        return ((LivePoseStream *)stream)->getWriteSlot();
+    }
+
+    // neither copies nor blocks, so (unlike most calls here) this can be called directly from any thread at any rate
+    FLUTTER_PLUGIN_EXPORT int publish_live_pose(void *const stream)
+    {
+        return ((LivePoseStream *)stream)->publish();
+    }
+
+    FLUTTER_PLUGIN_EXPORT EntityId get_joint_handle(void *assetManager, EntityId asset, const char *jointName)
+    {
+        return ((AssetManager *)assetManager)->getJointHandle(asset, jointName);
+    }
+
+    FLUTTER_PLUGIN_EXPORT int add_two_bone_ik_constraint(void *assetManager, EntityId asset, EntityId upperJoint, EntityId lowerJoint, EntityId endJoint, float weight)
+    {
+        return ((AssetManager *)assetManager)->addTwoBoneIkConstraint(asset, upperJoint, lowerJoint, endJoint, weight);
+    }
+
+    FLUTTER_PLUGIN_EXPORT int add_chain_ik_constraint(void *assetManager, EntityId asset, const EntityId *const joints, int numJoints, bool fabrik, int iterations, float weight)
+    {
+        return ((AssetManager *)assetManager)->addChainIkConstraint(asset, joints, numJoints, fabrik, iterations, weight);
+    }
+
+    FLUTTER_PLUGIN_EXPORT int add_look_at_constraint(void *assetManager, EntityId asset, EntityId joint, float forwardX, float forwardY, float forwardZ, float maxAngle, float weight)
+    {
+        return ((AssetManager *)assetManager)->addLookAtConstraint(asset, joint, forwardX, forwardY, forwardZ, maxAngle, weight);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_constraint_target(void *assetManager, EntityId asset, int constraint, float x, float y, float z)
+    {
+        return ((AssetManager *)assetManager)->setConstraintTarget(asset, constraint, x, y, z);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_constraint_target_entity(void *assetManager, EntityId asset, int constraint, EntityId target)
+    {
+        return ((AssetManager *)assetManager)->setConstraintTargetEntity(asset, constraint, target);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_constraint_pole(void *assetManager, EntityId asset, int constraint, float x, float y, float z)
+    {
+        return ((AssetManager *)assetManager)->setConstraintPole(asset, constraint, x, y, z);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_constraint_weight(void *assetManager, EntityId asset, int constraint, float weight)
+    {
+        return ((AssetManager *)assetManager)->setConstraintWeight(asset, constraint, weight);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool remove_constraint(void *assetManager, EntityId asset, int constraint)
+    {
+        return ((AssetManager *)assetManager)->removeConstraint(asset, constraint);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_animated_bounds(void *assetManager, EntityId asset, int mode, float padding)
+    {
+        if (mode < 0 || mode > (int)AnimatedBoundsMode::PER_FRAME)
+        {
+            Log("ERROR: invalid animated bounds mode %d", mode);
+            return false;
+        }
+        return ((AssetManager *)assetManager)->setAnimatedBounds(asset, (AnimatedBoundsMode)mode, padding);
+    }
+
+    FLUTTER_PLUGIN_EXPORT int add_animation_state_parameter(void *assetManager, EntityId asset, const char *name, float value)
+    {
+        return ((AssetManager *)assetManager)->addAnimationStateParameter(asset, name, value);
+    }
+
+    FLUTTER_PLUGIN_EXPORT int add_animation_state(void *assetManager, EntityId asset, const char *name, const int *const clipIndices, const float *const thresholds, int numClips, int blendParameter, float speed, bool loop)
+    {
+        return ((AssetManager *)assetManager)->addAnimationState(asset, name, clipIndices, thresholds, numClips, blendParameter, speed, loop);
+    }
+
+    FLUTTER_PLUGIN_EXPORT int add_animation_state_transition(void *assetManager, EntityId asset, int fromState, int toState, float crossfadeInSecs, float exitTime, const int *const parameters, const int *const ops, const float *const values, int numConditions)
+    {
+        return ((AssetManager *)assetManager)->addAnimationStateTransition(asset, fromState, toState, crossfadeInSecs, exitTime, parameters, ops, values, numConditions);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_animation_state_parameter(void *assetManager, EntityId asset, int parameter, float value)
+    {
+        return ((AssetManager *)assetManager)->setAnimationStateParameter(asset, parameter, value);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_animation_state(void *assetManager, EntityId asset, int state, float crossfadeInSecs)
+    {
+        return ((AssetManager *)assetManager)->setAnimationState(asset, state, crossfadeInSecs);
+    }
+
+    FLUTTER_PLUGIN_EXPORT int get_animation_state(void *assetManager, EntityId asset)
+    {
+        return ((AssetManager *)assetManager)->getAnimationState(asset);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool remove_animation_state_machine(void *assetManager, EntityId asset)
+    {
+        return ((AssetManager *)assetManager)->removeAnimationStateMachine(asset);
+    }
+
     FLUTTER_PLUGIN_EXPORT int hide_mesh(void *assetManager, EntityId asset, const char *meshName)
     {
         return ((AssetManager *)assetManager)->hide(asset, meshName);
@@ -469,6 +944,21 @@ extern "C"
         return ((AssetManager *)assetManager)->reveal(asset, meshName);
     }
 
+    FLUTTER_PLUGIN_EXPORT EntityId create_instanced_mesh(void *assetManager, EntityId asset, const char *meshName, int primitiveIndex, const float *const transforms, int count)
+    {
+        return ((AssetManager *)assetManager)->createInstancedMesh(asset, meshName, primitiveIndex, transforms, count);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool set_instance_transforms(void *assetManager, EntityId instancedMesh, const float *const transforms, int offset, int count)
+    {
+        return ((AssetManager *)assetManager)->setInstanceTransforms(instancedMesh, transforms, offset, count);
+    }
+
+    FLUTTER_PLUGIN_EXPORT bool remove_instanced_mesh(void *assetManager, EntityId instancedMesh)
+    {
+        return ((AssetManager *)assetManager)->removeInstancedMesh(instancedMesh);
+    }
+
     FLUTTER_PLUGIN_EXPORT void pick(void *const viewer, int x, int y, EntityId *entityId)
     {
         ((FilamentViewer *)viewer)->pick(static_cast<uint32_t>(x), static_cast<uint32_t>(y), static_cast<int32_t *>(entityId));
@@ -226,6 +226,17 @@ FLUTTER_PLUGIN_EXPORT EntityId load_glb_ffi(void *const assetManager,
   return fut.get();
 }
 
+FLUTTER_PLUGIN_EXPORT bool add_material_specialization_ffi(void *const assetManager,
+                                                           const char *packagePath,
+                                                           uint32_t features) {
+  std::packaged_task<bool()> lambda([&]() mutable {
+    return add_material_specialization(assetManager, packagePath, features);
+  });
+  auto fut = _rl->add_task(lambda);
+  fut.wait();
+  return fut.get();
+}
+
 FLUTTER_PLUGIN_EXPORT void clear_background_image_ffi(void *const viewer) {
   std::packaged_task<void()> lambda([&] { clear_background_image(viewer); });
   auto fut = _rl->add_task(lambda);
@@ -273,6 +284,27 @@ FLUTTER_PLUGIN_EXPORT void load_ibl_ffi(void *const viewer, const char *iblPath,
   auto fut = _rl->add_task(lambda);
   fut.wait();
 }
+FLUTTER_PLUGIN_EXPORT void load_ibl_from_equirect_ffi(void *const viewer,
+                                                      const char *path,
+                                                      float intensity,
+                                                      const char *cacheDirectory) {
+  std::packaged_task<void()> lambda([&] {
+    load_ibl_from_equirect(viewer, path, intensity, cacheDirectory);
+  });
+  auto fut = _rl->add_task(lambda);
+  fut.wait();
+}
+FLUTTER_PLUGIN_EXPORT void load_environment_ffi(void *const viewer,
+                                                const char *skyboxPath,
+                                                const char *iblPath,
+                                                float intensity,
+                                                float crossfadeInSecs) {
+  std::packaged_task<void()> lambda([&] {
+    load_environment(viewer, skyboxPath, iblPath, intensity, crossfadeInSecs);
+  });
+  auto fut = _rl->add_task(lambda);
+  fut.wait();
+}
 FLUTTER_PLUGIN_EXPORT void remove_skybox_ffi(void *const viewer) {
   std::packaged_task<void()> lambda([&] { remove_skybox(viewer); });
   auto fut = _rl->add_task(lambda);
@@ -310,6 +342,28 @@ FLUTTER_PLUGIN_EXPORT void clear_lights_ffi(void *const viewer) {
   fut.wait();
 }
 
+FLUTTER_PLUGIN_EXPORT void *
+create_dynamic_mesh_ffi(void *const viewer, const char *materialPath,
+                        int primitiveType, const int *const components,
+                        int maxVertices, int maxIndices, int numBuffers) {
+  std::packaged_task<void *()> lambda([&] {
+    return create_dynamic_mesh(viewer, materialPath, primitiveType, components,
+                               maxVertices, maxIndices, numBuffers);
+  });
+  auto fut = _rl->add_task(lambda);
+  fut.wait();
+  return fut.get();
+}
+
+FLUTTER_PLUGIN_EXPORT bool remove_dynamic_mesh_ffi(void *const viewer,
+                                                   void *const mesh) {
+  std::packaged_task<bool()> lambda(
+      [&] { return remove_dynamic_mesh(viewer, mesh); });
+  auto fut = _rl->add_task(lambda);
+  fut.wait();
+  return fut.get();
+}
+
 FLUTTER_PLUGIN_EXPORT void remove_asset_ffi(void *const viewer,
                                             EntityId asset) {
   std::packaged_task<void()> lambda([&] { remove_asset(viewer, asset); });
@@ -343,25 +397,31 @@ FLUTTER_PLUGIN_EXPORT void set_bone_animation_ffi(
   fut.wait();
 }
 
-FLUTTER_PLUGIN_EXPORT void
-get_morph_target_name_ffi(void *assetManager, EntityId asset,
-                          const char *meshName, char *const outPtr, int index) {
-  std::packaged_task<void()> lambda([&] {
-    get_morph_target_name(assetManager, asset, meshName, outPtr, index);
+FLUTTER_PLUGIN_EXPORT bool set_bone_animation_trs_ffi(
+    void *assetManager, EntityId asset, const float *const frameData,
+    int numFrames, int numBones, const char **const boneNames,
+    const char **const meshName, int numMeshTargets, float frameLengthInMs) {
+  std::packaged_task<bool()> lambda([&] {
+    return set_bone_animation_trs(assetManager, asset, frameData, numFrames,
+                                  numBones, boneNames, meshName,
+                                  numMeshTargets, frameLengthInMs);
   });
   auto fut = _rl->add_task(lambda);
   fut.wait();
+  return fut.get();
+}
+
+FLUTTER_PLUGIN_EXPORT void
+get_morph_target_name_ffi(void *assetManager, EntityId asset,
+                          const char *meshName, char *const outPtr, int index) {
+  // reads the metadata published on load, so doesn't need the render thread
+  get_morph_target_name(assetManager, asset, meshName, outPtr, index);
 }
 
 FLUTTER_PLUGIN_EXPORT int
 get_morph_target_name_count_ffi(void *assetManager, EntityId asset,
                                 const char *meshName) {
-  std::packaged_task<int()> lambda([&] {
-    return get_morph_target_name_count(assetManager, asset, meshName);
-  });
-  auto fut = _rl->add_task(lambda);
-  fut.wait();
-  return fut.get();
+  return get_morph_target_name_count(assetManager, asset, meshName);
 }
 
 void set_morph_target_weights_ffi(void *const assetManager, EntityId asset,
@@ -375,10 +435,11 @@ FLUTTER_PLUGIN_EXPORT void play_animation_ffi(void *const assetManager,
                                               EntityId asset, int index,
                                               bool loop, bool reverse,
                                               bool replaceActive,
-                                              float crossfade) {
+                                              float crossfade,
+                                              float startOffset) {
   std::packaged_task<void()> lambda([&] {
     play_animation(assetManager, asset, index, loop, reverse, replaceActive,
-                   crossfade);
+                   crossfade, startOffset);
   });
   auto fut = _rl->add_task(lambda);
   fut.wait();
@@ -387,9 +448,11 @@ FLUTTER_PLUGIN_EXPORT void play_animation_ffi(void *const assetManager,
 FLUTTER_PLUGIN_EXPORT void set_animation_frame_ffi(void *const assetManager,
                                                    EntityId asset,
                                                    int animationIndex,
-                                                   int animationFrame) {
+                                                   int animationFrame,
+                                                   float framesPerSecond) {
   std::packaged_task<void()> lambda([&] {
-    set_animation_frame(assetManager, asset, animationIndex, animationFrame);
+    set_animation_frame(assetManager, asset, animationIndex, animationFrame,
+                        framesPerSecond);
   });
   auto fut = _rl->add_task(lambda);
   fut.wait();
@@ -405,20 +468,14 @@ FLUTTER_PLUGIN_EXPORT void stop_animation_ffi(void *const assetManager,
 
 FLUTTER_PLUGIN_EXPORT int get_animation_count_ffi(void *const assetManager,
                                                   EntityId asset) {
-  std::packaged_task<int()> lambda(
-      [&] { return get_animation_count(assetManager, asset); });
-  auto fut = _rl->add_task(lambda);
-  fut.wait();
-  return fut.get();
+  // reads the metadata published on load, so doesn't need the render thread
+  return get_animation_count(assetManager, asset);
 }
 FLUTTER_PLUGIN_EXPORT void get_animation_name_ffi(void *const assetManager,
                                                   EntityId asset,
                                                   char *const outPtr,
                                                   int index) {
-  std::packaged_task<void()> lambda(
-      [&] { get_animation_name(assetManager, asset, outPtr, index); });
-  auto fut = _rl->add_task(lambda);
-  fut.wait();
+  get_animation_name(assetManager, asset, outPtr, index);
 }
 
 FLUTTER_PLUGIN_EXPORT void set_post_processing_ffi(void *const viewer,
@@ -436,8 +493,46 @@ FLUTTER_PLUGIN_EXPORT void pick_ffi(void *const viewer, int x, int y,
   fut.wait();
 }
 
+FLUTTER_PLUGIN_EXPORT EntityId create_instanced_mesh_ffi(
+    void *const assetManager, EntityId asset, const char *meshName,
+    int primitiveIndex, const float *const transforms, int count) {
+  std::packaged_task<EntityId()> lambda([&] {
+    return create_instanced_mesh(assetManager, asset, meshName, primitiveIndex,
+                                 transforms, count);
+  });
+  auto fut = _rl->add_task(lambda);
+  fut.wait();
+  return fut.get();
+}
+
+FLUTTER_PLUGIN_EXPORT bool
+set_instance_transforms_ffi(void *const assetManager, EntityId instancedMesh,
+                            const float *const transforms, int offset,
+                            int count) {
+  std::packaged_task<bool()> lambda([&] {
+    return set_instance_transforms(assetManager, instancedMesh, transforms,
+                                   offset, count);
+  });
+  auto fut = _rl->add_task(lambda);
+  fut.wait();
+  return fut.get();
+}
+
+FLUTTER_PLUGIN_EXPORT bool remove_instanced_mesh_ffi(void *const assetManager,
+                                                     EntityId instancedMesh) {
+  std::packaged_task<bool()> lambda(
+      [&] { return remove_instanced_mesh(assetManager, instancedMesh); });
+  auto fut = _rl->add_task(lambda);
+  fut.wait();
+  return fut.get();
+}
+
 FLUTTER_PLUGIN_EXPORT const char *
 get_name_for_entity_ffi(void *const assetManager, const EntityId entityId) {
+  // entities in a loaded asset are named in its metadata; anything else needs the render thread
+  if (const char *name = ((AssetManager *)assetManager)->getMetadataName(entityId)) {
+    return name;
+  }
   std::packaged_task<const char *()> lambda(
       [&] { return get_name_for_entity(assetManager, entityId); });
   auto fut = _rl->add_task(lambda);
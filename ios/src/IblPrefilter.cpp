@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <istream>
+
+#include <filament-iblprefilter/IBLPrefilterContext.h>
+
+#include <image/LinearImage.h>
+#include <math/half.h>
+#include <math/vec3.h>
+#include <imageio/ImageDecoder.h>
+
+#include "IblPrefilter.hpp"
+#include "StreamBufferAdapter.hpp"
+#include "Log.hpp"
+
+namespace polyvox {
+
+using namespace filament;
+using namespace filament::math;
+
+static constexpr uint32_t kIblCacheMagic = 0x4342494c; // "LIBC"
+static constexpr uint32_t kIblCacheVersion = 1;
+
+// the default prefiltered cubemap is 256x256 per face, so anything beyond this is wasted
+static constexpr uint32_t kMaxEquirectHeight = 512;
+
+struct IblCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+};
+
+static uint64_t hashSource(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for(size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static float3 sampleBilinear(const image::LinearImage& image, float x, float y) {
+    const uint32_t width = image.getWidth();
+    const uint32_t height = image.getHeight();
+    x = x - 0.5f;
+    y = std::clamp(y - 0.5f, 0.0f, float(height - 1));
+    const int x0 = (int)std::floor(x);
+    const int y0 = (int)y;
+    const float fx = x - x0;
+    const float fy = y - y0;
+    // wrap horizontally, clamp vertically
+    const uint32_t xa = (x0 % (int)width + width) % width;
+    const uint32_t xb = (xa + 1) % width;
+    const uint32_t ya = y0;
+    const uint32_t yb = std::min<uint32_t>(ya + 1, height - 1);
+    auto at = [&](uint32_t px, uint32_t py) {
+        const float* p = image.getPixelRef(px, py);
+        return float3 { p[0], p[1], p[2] };
+    };
+    return mix(mix(at(xa, ya), at(xb, ya), fx), mix(at(xa, yb), at(xb, yb), fx), fy);
+}
+
+IblPrefilter::IblPrefilter(Engine* engine) : _engine(engine) {}
+
+IblPrefilter::~IblPrefilter() {
+    delete _context;
+}
+
+std::unique_ptr<DecodedEquirect> IblPrefilter::decode(
+    const void* const data,
+    size_t size,
+    const char* sourceName,
+    const char* cacheDirectory) {
+
+    std::string cachePath;
+    if(cacheDirectory) {
+        char name[32];
+        snprintf(name, sizeof(name), "/%016llx.ibl", (unsigned long long)hashSource(data, size));
+        cachePath = std::string(cacheDirectory) + name;
+        auto cached = readCache(cachePath);
+        if(cached) {
+            Log("Loaded decoded IBL source for %s from cache %s", sourceName, cachePath.c_str());
+            return cached;
+        }
+    }
+
+    StreamBufferAdapter sb((const char*)data, (const char*)data + size);
+    std::istream inputStream(&sb);
+    image::LinearImage source = image::ImageDecoder::decode(inputStream, sourceName, image::ImageDecoder::ColorSpace::LINEAR);
+    if(!source.isValid() || source.getChannels() < 3) {
+        Log("Failed to decode equirectangular image %s", sourceName);
+        return nullptr;
+    }
+
+    // the prefilter requires an exact 2:1 aspect ratio
+    auto result = std::make_unique<DecodedEquirect>();
+    result->height = std::min(kMaxEquirectHeight, (uint32_t)source.getHeight());
+    result->width = result->height * 2;
+    result->texels.resize(result->width * result->height * 3);
+
+    const float sx = float(source.getWidth()) / result->width;
+    const float sy = float(source.getHeight()) / result->height;
+    for(uint32_t y = 0; y < result->height; y++) {
+        for(uint32_t x = 0; x < result->width; x++) {
+            float3 texel = sampleBilinear(source, (x + 0.5f) * sx, (y + 0.5f) * sy);
+            // clamp to the largest finite half
+            texel = clamp(texel, float3(0.0f), float3(65504.0f));
+            uint16_t* dst = &result->texels[(y * result->width + x) * 3];
+            for(int c = 0; c < 3; c++) {
+                dst[c] = getBits(half(texel[c]));
+            }
+        }
+    }
+
+    if(!cachePath.empty()) {
+        writeCache(cachePath, *result);
+    }
+    Log("Decoded equirectangular IBL source %s (%dx%d)", sourceName, result->width, result->height);
+    return result;
+}
+
+bool IblPrefilter::prefilter(const DecodedEquirect& equirect, Texture** reflections, Texture** irradiance) {
+    if(!_context) {
+        _context = new IBLPrefilterContext(*_engine);
+    }
+
+    Texture* equirectTexture = Texture::Builder()
+        .width(equirect.width)
+        .height(equirect.height)
+        .levels(0xff)
+        .sampler(Texture::Sampler::SAMPLER_2D)
+        .format(Texture::InternalFormat::R11F_G11F_B10F)
+        .usage(Texture::Usage::DEFAULT | Texture::Usage::COLOR_ATTACHMENT)
+        .build(*_engine);
+    if(!equirectTexture) {
+        Log("Failed to create equirectangular texture");
+        return false;
+    }
+
+    // copied, since the source may be destroyed before the upload happens
+    auto* copy = new std::vector<uint16_t>(equirect.texels);
+    Texture::PixelBufferDescriptor pbd(
+        copy->data(), copy->size() * sizeof(uint16_t), Texture::Format::RGB, Texture::Type::HALF,
+        [](void* buffer, size_t size, void* user) { delete (std::vector<uint16_t>*)user; }, copy);
+    equirectTexture->setImage(*_engine, 0, std::move(pbd));
+    equirectTexture->generateMipmaps(*_engine);
+
+    IBLPrefilterContext::EquirectangularToCubemap equirectToCubemap(*_context);
+    Texture* environment = equirectToCubemap(equirectTexture);
+
+    IBLPrefilterContext::SpecularFilter specularFilter(*_context);
+    *reflections = specularFilter(environment);
+
+    // the specular filter has already generated the environment's mip chain
+    IBLPrefilterContext::IrradianceFilter irradianceFilter(*_context);
+    IBLPrefilterContext::IrradianceFilter::Options options;
+    options.generateMipmap = false;
+    *irradiance = irradianceFilter(options, environment);
+
+    _engine->destroy(environment);
+    _engine->destroy(equirectTexture);
+    return *reflections && *irradiance;
+}
+
+std::unique_ptr<DecodedEquirect> IblPrefilter::readCache(const std::string& path) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if(!f) {
+        return nullptr;
+    }
+    auto equirect = std::make_unique<DecodedEquirect>();
+    IblCacheHeader header;
+    bool ok = fread(&header, sizeof(header), 1, f) == 1
+        && header.magic == kIblCacheMagic
+        && header.version == kIblCacheVersion
+        && header.height > 0
+        && header.height <= kMaxEquirectHeight
+        && header.width == header.height * 2;
+    if(ok) {
+        equirect->width = header.width;
+        equirect->height = header.height;
+        equirect->texels.resize(header.width * header.height * 3);
+        ok = fread(equirect->texels.data(), sizeof(uint16_t), equirect->texels.size(), f) == equirect->texels.size();
+    }
+    fclose(f);
+    if(!ok) {
+        Log("Ignoring invalid IBL cache file %s", path.c_str());
+        return nullptr;
+    }
+    return equirect;
+}
+
+void IblPrefilter::writeCache(const std::string& path, const DecodedEquirect& equirect) {
+    // write-then-rename so a partially written file is never picked up by readCache
+    std::string tmpPath = path + ".tmp";
+    FILE* f = fopen(tmpPath.c_str(), "wb");
+    if(!f) {
+        Log("Failed to open IBL cache file %s for writing", tmpPath.c_str());
+        return;
+    }
+    IblCacheHeader header { kIblCacheMagic, kIblCacheVersion, equirect.width, equirect.height };
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1
+        && fwrite(equirect.texels.data(), sizeof(uint16_t), equirect.texels.size(), f) == equirect.texels.size();
+    fclose(f);
+    if(!ok || rename(tmpPath.c_str(), path.c_str()) != 0) {
+        // rename() won't replace an existing file on Windows, so a failure here usually just means another load got there first
+        remove(tmpPath.c_str());
+    }
+}
+
+}
@@ -0,0 +1,430 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <string>
+
+#include <filament/MaterialEnums.h>
+#include <filament/TransformManager.h>
+#include <geometry/SurfaceOrientation.h>
+#include <math/quat.h>
+#include <math/vec2.h>
+#include <math/vec4.h>
+#include <utils/EntityManager.h>
+
+#include "cgltf.h"
+
+#include "InstancedMesh.hpp"
+#include "Log.hpp"
+
+namespace polyvox {
+
+using namespace filament;
+using namespace filament::math;
+
+template <typename T>
+static backend::BufferDescriptor toBufferDescriptor(std::vector<T>&& data) {
+    // owned by the descriptor until the upload completes
+    auto* owned = new std::vector<T>(std::move(data));
+    return backend::BufferDescriptor(owned->data(), owned->size() * sizeof(T),
+        [](void*, size_t, void* user) { delete static_cast<std::vector<T>*>(user); }, owned);
+}
+
+template <typename T>
+static bool unpack(const cgltf_accessor* accessor, std::vector<T>& out, size_t count) {
+    constexpr size_t numComponents = sizeof(T) / sizeof(float);
+    out.resize(count);
+    if(cgltf_num_components(accessor->type) != numComponents || accessor->count != count) {
+        return false;
+    }
+    // reads any component type (normalizing if required) and applies sparse data; returns 0 if the data isn't available (e.g. Draco)
+    return cgltf_accessor_unpack_floats(accessor, reinterpret_cast<float*>(out.data()), count * numComponents) == count * numComponents;
+}
+
+static bool toPrimitiveType(cgltf_primitive_type type, RenderableManager::PrimitiveType& out) {
+    switch(type) {
+        case cgltf_primitive_type_points:
+            out = RenderableManager::PrimitiveType::POINTS;
+            return true;
+        case cgltf_primitive_type_lines:
+            out = RenderableManager::PrimitiveType::LINES;
+            return true;
+        case cgltf_primitive_type_line_strip:
+            out = RenderableManager::PrimitiveType::LINE_STRIP;
+            return true;
+        case cgltf_primitive_type_triangles:
+            out = RenderableManager::PrimitiveType::TRIANGLES;
+            return true;
+        case cgltf_primitive_type_triangle_strip:
+            out = RenderableManager::PrimitiveType::TRIANGLE_STRIP;
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void destroyPrimitives(InstancedMesh& mesh, Engine& engine) {
+    for(auto& primitive : mesh.mPrimitives) {
+        engine.destroy(primitive.mVertexBuffer);
+        engine.destroy(primitive.mIndexBuffer);
+    }
+    mesh.mPrimitives.clear();
+}
+
+static bool createPrimitive(
+    InstancedMesh& mesh,
+    const cgltf_primitive& source,
+    AttributeBitset attributes,
+    MaterialInstance* materialInstance,
+    Engine& engine) {
+
+    InstancedPrimitive primitive;
+    primitive.mMaterialInstance = materialInstance;
+    if(!toPrimitiveType(source.type, primitive.mType)) {
+        Log("ERROR: line loops and triangle fans can't be instanced.");
+        return false;
+    }
+    if(attributes[VertexAttribute::BONE_INDICES]) {
+        Log("ERROR: skinned primitives can't be instanced.");
+        return false;
+    }
+
+    const cgltf_accessor* positionAccessor = nullptr;
+    const cgltf_accessor* normalAccessor = nullptr;
+    const cgltf_accessor* tangentAccessor = nullptr;
+    const cgltf_accessor* uvAccessors[2] = { nullptr, nullptr };
+    const cgltf_accessor* colorAccessor = nullptr;
+    for(size_t i = 0; i < source.attributes_count; i++) {
+        const auto& attribute = source.attributes[i];
+        switch(attribute.type) {
+            case cgltf_attribute_type_position:
+                positionAccessor = attribute.data;
+                break;
+            case cgltf_attribute_type_normal:
+                normalAccessor = attribute.data;
+                break;
+            case cgltf_attribute_type_tangent:
+                tangentAccessor = attribute.data;
+                break;
+            case cgltf_attribute_type_texcoord:
+                if(attribute.index < 2) {
+                    uvAccessors[attribute.index] = attribute.data;
+                }
+                break;
+            case cgltf_attribute_type_color:
+                if(attribute.index == 0) {
+                    colorAccessor = attribute.data;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    if(!positionAccessor) {
+        Log("ERROR: primitive has no positions.");
+        return false;
+    }
+
+    const size_t numVertices = positionAccessor->count;
+    std::vector<float3> positions;
+    if(!unpack(positionAccessor, positions, numVertices)) {
+        Log("ERROR: failed to read primitive positions (compressed meshes can't be instanced).");
+        return false;
+    }
+
+    std::vector<uint32_t> indices;
+    if(source.indices) {
+        indices.resize(source.indices->count);
+        for(size_t i = 0; i < indices.size(); i++) {
+            indices[i] = (uint32_t)cgltf_accessor_read_index(source.indices, i);
+        }
+    } else {
+        indices.resize(numVertices);
+        std::iota(indices.begin(), indices.end(), 0u);
+    }
+    if(indices.empty()) {
+        Log("ERROR: primitive has no indices.");
+        return false;
+    }
+
+    Box box;
+    float3 lo(std::numeric_limits<float>::max());
+    float3 hi(std::numeric_limits<float>::lowest());
+    for(const auto& position : positions) {
+        lo = min(lo, position);
+        hi = max(hi, position);
+    }
+    box.set(lo, hi);
+
+    // only the attributes the material was built for are uploaded; any it needs that the glTF doesn't have get defaults (as in gltfio)
+    VertexBuffer::Builder builder;
+    builder.vertexCount(numVertices);
+    uint8_t numBuffers = 0;
+    builder.attribute(VertexAttribute::POSITION, numBuffers++, VertexBuffer::AttributeType::FLOAT3);
+
+    std::vector<short4> tangents;
+    if(attributes[VertexAttribute::TANGENTS]) {
+        tangents.assign(numVertices, short4(0, 0, 0, std::numeric_limits<int16_t>::max()));
+        std::vector<float3> normals;
+        std::vector<float4> sourceTangents;
+        const bool hasNormals = normalAccessor && unpack(normalAccessor, normals, numVertices);
+        const bool hasTangents = hasNormals && tangentAccessor && unpack(tangentAccessor, sourceTangents, numVertices);
+        geometry::SurfaceOrientation::Builder orientation;
+        orientation.vertexCount(numVertices);
+        if(hasNormals) {
+            orientation.normals(normals.data());
+            if(hasTangents) {
+                orientation.tangents(sourceTangents.data());
+            }
+        } else if(primitive.mType == RenderableManager::PrimitiveType::TRIANGLES) {
+            // flat shaded
+            orientation.positions(positions.data()).triangleCount(indices.size() / 3).triangles(reinterpret_cast<const uint3*>(indices.data()));
+        }
+        if(hasNormals || primitive.mType == RenderableManager::PrimitiveType::TRIANGLES) {
+            if(auto* quats = orientation.build()) {
+                quats->getQuats(tangents.data(), numVertices);
+                delete quats;
+            }
+        }
+        builder.attribute(VertexAttribute::TANGENTS, numBuffers++, VertexBuffer::AttributeType::SHORT4);
+        builder.normalized(VertexAttribute::TANGENTS);
+    }
+
+    std::vector<float2> uvs[2];
+    const VertexAttribute uvAttributes[2] = { VertexAttribute::UV0, VertexAttribute::UV1 };
+    for(int i = 0; i < 2; i++) {
+        if(!attributes[uvAttributes[i]]) {
+            continue;
+        }
+        if(!uvAccessors[i] || !unpack(uvAccessors[i], uvs[i], numVertices)) {
+            uvs[i].assign(numVertices, float2(0.0f));
+        }
+        builder.attribute(uvAttributes[i], numBuffers++, VertexBuffer::AttributeType::FLOAT2);
+    }
+
+    std::vector<float4> colors;
+    if(attributes[VertexAttribute::COLOR]) {
+        if(!colorAccessor) {
+            colors.assign(numVertices, float4(1.0f));
+        } else if(cgltf_num_components(colorAccessor->type) == 3) {
+            std::vector<float3> rgb;
+            unpack(colorAccessor, rgb, numVertices);
+            colors.resize(numVertices);
+            for(size_t i = 0; i < numVertices; i++) {
+                colors[i] = float4(rgb[i], 1.0f);
+            }
+        } else if(!unpack(colorAccessor, colors, numVertices)) {
+            colors.assign(numVertices, float4(1.0f));
+        }
+        builder.attribute(VertexAttribute::COLOR, numBuffers++, VertexBuffer::AttributeType::FLOAT4);
+    }
+
+    builder.bufferCount(numBuffers);
+    primitive.mVertexBuffer = builder.build(engine);
+    uint8_t buffer = 0;
+    primitive.mVertexBuffer->setBufferAt(engine, buffer++, toBufferDescriptor(std::move(positions)));
+    if(!tangents.empty()) {
+        primitive.mVertexBuffer->setBufferAt(engine, buffer++, toBufferDescriptor(std::move(tangents)));
+    }
+    for(auto& uv : uvs) {
+        if(!uv.empty()) {
+            primitive.mVertexBuffer->setBufferAt(engine, buffer++, toBufferDescriptor(std::move(uv)));
+        }
+    }
+    if(!colors.empty()) {
+        primitive.mVertexBuffer->setBufferAt(engine, buffer++, toBufferDescriptor(std::move(colors)));
+    }
+
+    primitive.mIndexBuffer = IndexBuffer::Builder()
+        .indexCount(indices.size())
+        .bufferType(IndexBuffer::IndexType::UINT)
+        .build(engine);
+    primitive.mIndexBuffer->setBuffer(engine, toBufferDescriptor(std::move(indices)));
+
+    if(mesh.mPrimitives.empty()) {
+        mesh.mBox = box;
+    } else {
+        mesh.mBox.unionSelf(box);
+    }
+    mesh.mPrimitives.push_back(primitive);
+    return true;
+}
+
+bool createInstancedPrimitives(
+    InstancedMesh& out,
+    const cgltf_mesh* mesh,
+    int primitiveIndex,
+    RenderableManager::Instance source,
+    Engine& engine) {
+
+    auto& rm = engine.getRenderableManager();
+    const size_t numPrimitives = std::min(mesh->primitives_count, rm.getPrimitiveCount(source));
+    if(primitiveIndex >= (int)numPrimitives) {
+        Log("ERROR: primitive index %d is out of range (the mesh has %zu).", primitiveIndex, numPrimitives);
+        return false;
+    }
+    const size_t first = primitiveIndex < 0 ? 0 : primitiveIndex;
+    const size_t last = primitiveIndex < 0 ? numPrimitives : primitiveIndex + 1;
+    for(size_t i = first; i < last; i++) {
+        // gltfio creates one renderable primitive per glTF primitive, in order
+        if(!createPrimitive(out, mesh->primitives[i], rm.getEnabledAttributesAt(source, i), rm.getMaterialInstanceAt(source, i), engine)) {
+            destroyPrimitives(out, engine);
+            return false;
+        }
+    }
+    out.mCastShadows = rm.isShadowCaster(source);
+    out.mReceiveShadows = rm.isShadowReceiver(source);
+    return true;
+}
+
+static Box getInstanceBounds(const InstancedMesh& mesh, size_t first, size_t count) {
+    Box bounds;
+    for(size_t i = first; i < first + count; i++) {
+        const mat4f& transform = mesh.mTransforms[i];
+        const Box box = Box::transform(transform.upperLeft(), transform[3].xyz, mesh.mBox);
+        if(i == first) {
+            bounds = box;
+        } else {
+            bounds.unionSelf(box);
+        }
+    }
+    return bounds;
+}
+
+void createInstancedRenderables(
+    InstancedMesh& mesh,
+    const mat4f* transforms,
+    size_t count,
+    Engine& engine,
+    Scene& scene) {
+
+    auto& tm = engine.getTransformManager();
+    const auto root = tm.getInstance(mesh.mRoot);
+    mesh.mInstancesPerRenderable = std::max<size_t>(1, engine.getMaxAutomaticInstances());
+    mesh.mTransforms.assign(transforms, transforms + count);
+
+    for(size_t first = 0; first < count; first += mesh.mInstancesPerRenderable) {
+        const size_t numInstances = std::min(mesh.mInstancesPerRenderable, count - first);
+        auto* instanceBuffer = InstanceBuffer::Builder(numInstances)
+            .localTransforms(mesh.mTransforms.data() + first)
+            .build(engine);
+        const auto entity = utils::EntityManager::get().create();
+        RenderableManager::Builder builder(mesh.mPrimitives.size());
+        for(size_t i = 0; i < mesh.mPrimitives.size(); i++) {
+            const auto& primitive = mesh.mPrimitives[i];
+            builder.geometry(i, primitive.mType, primitive.mVertexBuffer, primitive.mIndexBuffer);
+            builder.material(i, primitive.mMaterialInstance);
+        }
+        builder.instances(numInstances, instanceBuffer)
+            .boundingBox(getInstanceBounds(mesh, first, numInstances))
+            .castShadows(mesh.mCastShadows)
+            .receiveShadows(mesh.mReceiveShadows)
+            .build(engine, entity);
+        tm.create(entity, root);
+        scene.addEntity(entity);
+        mesh.mRenderables.push_back(entity);
+        mesh.mInstanceBuffers.push_back(instanceBuffer);
+    }
+}
+
+void setInstanceTransforms(
+    InstancedMesh& mesh,
+    const mat4f* transforms,
+    size_t offset,
+    size_t count,
+    Engine& engine) {
+
+    auto& rm = engine.getRenderableManager();
+    std::copy(transforms, transforms + count, mesh.mTransforms.begin() + offset);
+    const size_t perRenderable = mesh.mInstancesPerRenderable;
+    for(size_t r = offset / perRenderable; r * perRenderable < offset + count; r++) {
+        const size_t first = r * perRenderable;
+        const size_t numInstances = mesh.mInstanceBuffers[r]->getInstanceCount();
+        // only the instances in range are uploaded, but the bounds must cover every instance drawn by the renderable
+        const size_t updateStart = std::max(first, offset);
+        const size_t updateEnd = std::min(first + numInstances, offset + count);
+        mesh.mInstanceBuffers[r]->setLocalTransforms(mesh.mTransforms.data() + updateStart, updateEnd - updateStart, updateStart - first);
+        rm.setAxisAlignedBoundingBox(rm.getInstance(mesh.mRenderables[r]), getInstanceBounds(mesh, first, numInstances));
+    }
+}
+
+void destroyInstancedMesh(InstancedMesh& mesh, Engine& engine, Scene& scene) {
+    auto& tm = engine.getTransformManager();
+    auto& em = utils::EntityManager::get();
+    for(const auto entity : mesh.mRenderables) {
+        scene.remove(entity);
+        engine.destroy(entity);
+        tm.destroy(entity);
+        em.destroy(entity);
+    }
+    // instance buffers must outlive the renderables using them
+    for(auto* instanceBuffer : mesh.mInstanceBuffers) {
+        engine.destroy(instanceBuffer);
+    }
+    destroyPrimitives(mesh, engine);
+    tm.destroy(mesh.mRoot);
+    em.destroy(mesh.mRoot);
+    mesh.mRenderables.clear();
+    mesh.mInstanceBuffers.clear();
+    mesh.mTransforms.clear();
+}
+
+// the accessor index of [attribute] in the JSON of an EXT_mesh_gpu_instancing extension, or -1
+static int findInstancingAccessor(const char* json, const char* attribute) {
+    const std::string key = std::string("\"") + attribute + "\"";
+    const char* found = strstr(json, key.c_str());
+    if(!found) {
+        return -1;
+    }
+    const char* colon = strchr(found + key.size(), ':');
+    return colon ? atoi(colon + 1) : -1;
+}
+
+bool readMeshGpuInstancing(const cgltf_data* data, const cgltf_node* node, std::vector<mat4f>& out) {
+    const char* json = nullptr;
+    for(size_t i = 0; i < node->extensions_count; i++) {
+        if(node->extensions[i].name && strcmp(node->extensions[i].name, "EXT_mesh_gpu_instancing") == 0) {
+            json = node->extensions[i].data;
+        }
+    }
+    if(!json || !node->mesh) {
+        return false;
+    }
+
+    const cgltf_accessor* accessors[3] = { nullptr, nullptr, nullptr };
+    const char* attributes[3] = { "TRANSLATION", "ROTATION", "SCALE" };
+    size_t count = 0;
+    for(int i = 0; i < 3; i++) {
+        const int index = findInstancingAccessor(json, attributes[i]);
+        if(index >= 0 && index < (int)data->accessors_count) {
+            accessors[i] = &data->accessors[index];
+            count = std::max(count, (size_t)accessors[i]->count);
+        }
+    }
+    if(count == 0) {
+        Log("ERROR: EXT_mesh_gpu_instancing on node %s has no instances.", node->name ? node->name : "");
+        return false;
+    }
+
+    std::vector<float3> translations;
+    std::vector<float4> rotations;
+    std::vector<float3> scales;
+    if((accessors[0] && !unpack(accessors[0], translations, count)) ||
+       (accessors[1] && !unpack(accessors[1], rotations, count)) ||
+       (accessors[2] && !unpack(accessors[2], scales, count))) {
+        Log("ERROR: failed to read EXT_mesh_gpu_instancing on node %s.", node->name ? node->name : "");
+        return false;
+    }
+    out.resize(count);
+    for(size_t i = 0; i < count; i++) {
+        const float3 translation = accessors[0] ? translations[i] : float3(0.0f);
+        // glTF quaternions are stored as xyzw
+        const quatf rotation = accessors[1] ? quatf(rotations[i].w, rotations[i].x, rotations[i].y, rotations[i].z) : quatf(1.0f, 0.0f, 0.0f, 0.0f);
+        const float3 scale = accessors[2] ? scales[i] : float3(1.0f);
+        out[i] = mat4f::translation(translation) * mat4f(rotation) * mat4f::scaling(scale);
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <gltfio/math.h>
+#include <utils/Entity.h>
+
+#include "JointConstraints.hpp"
+
+namespace polyvox {
+
+using namespace filament;
+using namespace filament::math;
+
+static constexpr float kEpsilon = 1e-5f;
+
+static const quatf kIdentity(1.0f, 0.0f, 0.0f, 0.0f);
+
+static float3 safeNormalize(const float3& v) {
+    const float len = length(v);
+    return len > kEpsilon ? v / len : float3(0.0f);
+}
+
+// the shortest rotation taking the direction of [from] to the direction of [to]
+static quatf rotationBetween(const float3& from, const float3& to) {
+    const float3 f = safeNormalize(from);
+    const float3 t = safeNormalize(to);
+    if(length2(f) == 0.0f || length2(t) == 0.0f) {
+        return kIdentity;
+    }
+    return quatf::fromDirectedRotation(f, t);
+}
+
+static float3 getWorldPosition(TransformManager& tm, TransformManager::Instance joint) {
+    return tm.getWorldTransform(joint)[3].xyz;
+}
+
+// applies the world-space rotation [q] to [joint] about its own origin (which carries its descendants along)
+static void rotateJoint(TransformManager& tm, TransformManager::Instance joint, const quatf& q) {
+    const mat4f world = tm.getWorldTransform(joint);
+    const float3 origin = world[3].xyz;
+    const mat4f rotated = mat4f::translation(origin) * mat4f(q) * mat4f::translation(-origin) * world;
+    const auto parent = tm.getInstance(tm.getParent(joint));
+    const mat4f parentWorld = parent ? tm.getWorldTransform(parent) : mat4f();
+    tm.setTransform(joint, inverse(parentWorld) * rotated);
+}
+
+static float angleBetween(const float3& a, const float3& b) {
+    return std::acos(std::clamp(dot(safeNormalize(a), safeNormalize(b)), -1.0f, 1.0f));
+}
+
+static void solveTwoBone(TransformManager& tm, JointConstraint& constraint) {
+    const auto upper = constraint.mJoints[0];
+    const auto lower = constraint.mJoints[1];
+    const auto end = constraint.mJoints[2];
+    const float3 a = getWorldPosition(tm, upper);
+    const float3 b = getWorldPosition(tm, lower);
+    const float3 c = getWorldPosition(tm, end);
+    const float3 t = constraint.mTarget;
+
+    const float lab = length(b - a);
+    const float lcb = length(b - c);
+    if(lab < kEpsilon || lcb < kEpsilon) {
+        return;
+    }
+    const float lat = std::clamp(length(t - a), kEpsilon, lab + lcb - kEpsilon);
+
+    // the angles at the upper and lower joints, now and once the chain spans [lat]
+    const float acab0 = angleBetween(c - a, b - a);
+    const float babc0 = angleBetween(a - b, c - b);
+    const float acat0 = angleBetween(c - a, t - a);
+    const float acab1 = std::acos(std::clamp((lcb * lcb - lab * lab - lat * lat) / (-2.0f * lab * lat), -1.0f, 1.0f));
+    const float babc1 = std::acos(std::clamp((lat * lat - lab * lab - lcb * lcb) / (-2.0f * lab * lcb), -1.0f, 1.0f));
+
+    float3 bendAxis = safeNormalize(cross(c - a, b - a));
+    if(length2(bendAxis) == 0.0f) {
+        // the chain is fully extended, so bend towards the pole (or any perpendicular axis)
+        const float3 hint = constraint.mHasPole ? constraint.mPole - a : float3(0.0f, 0.0f, 1.0f);
+        bendAxis = safeNormalize(cross(c - a, hint));
+        if(length2(bendAxis) == 0.0f) {
+            bendAxis = safeNormalize(cross(c - a, float3(1.0f, 0.0f, 0.0f)));
+        }
+    }
+    const float3 swingAxis = safeNormalize(cross(c - a, t - a));
+
+    // the lower joint is rotated first, as its rotation is expressed in the pose before the upper joint moves
+    rotateJoint(tm, lower, quatf::fromAxisAngle(bendAxis, babc1 - babc0));
+    quatf upperRotation = quatf::fromAxisAngle(bendAxis, acab1 - acab0);
+    if(length2(swingAxis) > 0.0f) {
+        upperRotation = quatf::fromAxisAngle(swingAxis, acat0) * upperRotation;
+    }
+    rotateJoint(tm, upper, upperRotation);
+
+    if(constraint.mHasPole) {
+        // twist the chain about the upper joint -> target axis so the lower joint points towards the pole
+        const float3 axis = safeNormalize(t - a);
+        const float3 bent = getWorldPosition(tm, lower) - a;
+        const float3 pole = constraint.mPole - a;
+        const float3 bentInPlane = bent - axis * dot(bent, axis);
+        const float3 poleInPlane = pole - axis * dot(pole, axis);
+        if(length(bentInPlane) > kEpsilon && length(poleInPlane) > kEpsilon) {
+            rotateJoint(tm, upper, rotationBetween(bentInPlane, poleInPlane));
+        }
+    }
+}
+
+static void solveCcd(TransformManager& tm, JointConstraint& constraint) {
+    const size_t numJoints = constraint.mJoints.size();
+    const auto end = constraint.mJoints[numJoints - 1];
+    const float3 t = constraint.mTarget;
+    for(int iteration = 0; iteration < constraint.mIterations; iteration++) {
+        if(length(getWorldPosition(tm, end) - t) <= constraint.mTolerance) {
+            break;
+        }
+        for(int i = (int)numJoints - 2; i >= 0; i--) {
+            const auto joint = constraint.mJoints[i];
+            const float3 p = getWorldPosition(tm, joint);
+            rotateJoint(tm, joint, rotationBetween(getWorldPosition(tm, end) - p, t - p));
+        }
+    }
+}
+
+static void solveFabrik(TransformManager& tm, JointConstraint& constraint) {
+    const size_t numJoints = constraint.mJoints.size();
+    auto& positions = constraint.mPositions;
+    auto& lengths = constraint.mLengths;
+    positions.resize(numJoints);
+    lengths.resize(numJoints - 1);
+
+    float totalLength = 0.0f;
+    for(size_t i = 0; i < numJoints; i++) {
+        positions[i] = getWorldPosition(tm, constraint.mJoints[i]);
+        if(i > 0) {
+            lengths[i - 1] = length(positions[i] - positions[i - 1]);
+            totalLength += lengths[i - 1];
+        }
+    }
+
+    const float3 root = positions[0];
+    const float3 t = constraint.mTarget;
+    if(length(t - root) >= totalLength) {
+        // out of reach, so straighten the chain towards the target
+        for(size_t i = 0; i + 1 < numJoints; i++) {
+            positions[i + 1] = positions[i] + safeNormalize(t - positions[i]) * lengths[i];
+        }
+    } else {
+        for(int iteration = 0; iteration < constraint.mIterations; iteration++) {
+            if(length(positions[numJoints - 1] - t) <= constraint.mTolerance) {
+                break;
+            }
+            positions[numJoints - 1] = t;
+            for(int i = (int)numJoints - 2; i >= 0; i--) {
+                positions[i] = positions[i + 1] + safeNormalize(positions[i] - positions[i + 1]) * lengths[i];
+            }
+            positions[0] = root;
+            for(size_t i = 0; i + 1 < numJoints; i++) {
+                positions[i + 1] = positions[i] + safeNormalize(positions[i + 1] - positions[i]) * lengths[i];
+            }
+        }
+    }
+
+    // FABRIK only solves for positions; rotate each joint so its child lands on the solved position
+    for(size_t i = 0; i + 1 < numJoints; i++) {
+        const auto joint = constraint.mJoints[i];
+        const float3 p = getWorldPosition(tm, joint);
+        rotateJoint(tm, joint, rotationBetween(getWorldPosition(tm, constraint.mJoints[i + 1]) - p, positions[i + 1] - p));
+    }
+}
+
+static void solveLookAt(TransformManager& tm, JointConstraint& constraint) {
+    const auto joint = constraint.mJoints[0];
+    const mat4f world = tm.getWorldTransform(joint);
+    const float3 forward = (world * float4(constraint.mForward, 0.0f)).xyz;
+    quatf q = rotationBetween(forward, constraint.mTarget - world[3].xyz);
+    const float angle = 2.0f * std::acos(std::min(std::abs(q.w), 1.0f));
+    if(angle > constraint.mMaxAngle) {
+        q = slerp(kIdentity, q, constraint.mMaxAngle / angle);
+    }
+    rotateJoint(tm, joint, q);
+}
+
+void solveJointConstraint(TransformManager& tm, JointConstraint& constraint) {
+    const size_t numJoints = constraint.mJoints.size();
+
+    // joints that nothing else has written since the last solve still hold its result, so start again from the pose before it
+    if(constraint.mConstrained.size() == numJoints) {
+        for(size_t i = 0; i < numJoints; i++) {
+            const mat4f current = tm.getTransform(constraint.mJoints[i]);
+            if(memcmp(&current, &constraint.mConstrained[i], sizeof(mat4f)) == 0) {
+                tm.setTransform(constraint.mJoints[i], constraint.mUnconstrained[i]);
+            }
+        }
+    }
+    constraint.mUnconstrained.resize(numJoints);
+    constraint.mConstrained.resize(numJoints);
+    for(size_t i = 0; i < numJoints; i++) {
+        constraint.mUnconstrained[i] = tm.getTransform(constraint.mJoints[i]);
+    }
+
+    if(constraint.mTargetInstance) {
+        constraint.mTarget = tm.getWorldTransform(constraint.mTargetInstance)[3].xyz;
+    }
+
+    if(constraint.mWeight > 0.0f) {
+        switch(constraint.mType) {
+            case JointConstraintType::TWO_BONE_IK:
+                solveTwoBone(tm, constraint);
+                break;
+            case JointConstraintType::CCD_IK:
+                solveCcd(tm, constraint);
+                break;
+            case JointConstraintType::FABRIK_IK:
+                solveFabrik(tm, constraint);
+                break;
+            case JointConstraintType::LOOK_AT:
+                solveLookAt(tm, constraint);
+                break;
+        }
+    }
+
+    for(size_t i = 0; i < numJoints; i++) {
+        const auto joint = constraint.mJoints[i];
+        if(constraint.mWeight < 1.0f) {
+            // blend the rotation only; solving never changes a joint's local translation or scale
+            float3 translation, scale, solvedTranslation, solvedScale;
+            quatf rotation, solvedRotation;
+            gltfio::decomposeMatrix(constraint.mUnconstrained[i], &translation, &rotation, &scale);
+            gltfio::decomposeMatrix(tm.getTransform(joint), &solvedTranslation, &solvedRotation, &solvedScale);
+            rotation = slerp(rotation, solvedRotation, std::max(constraint.mWeight, 0.0f));
+            tm.setTransform(joint, gltfio::composeMatrix(translation, rotation, scale));
+        }
+        constraint.mConstrained[i] = tm.getTransform(joint);
+    }
+}
+
+}
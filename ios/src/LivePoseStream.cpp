@@ -0,0 +1,48 @@
+#include <algorithm>
+
+#include "LivePoseStream.hpp"
+#include "BoneTracks.hpp"
+
+namespace polyvox {
+
+static constexpr size_t kFloatsPerCacheLine = 64 / sizeof(float);
+
+LivePoseStream::LivePoseStream(uint32_t numMorphWeights, uint32_t numBones) :
+    mNumMorphWeights(numMorphWeights),
+    mNumBones(numBones),
+    mSlotSize(numMorphWeights + numBones * BoneTrack::COMPONENT_COUNT),
+    mSlotStride((mSlotSize + kFloatsPerCacheLine - 1) / kFloatsPerCacheLine * kFloatsPerCacheLine),
+    mSlots(mSlotStride * NUM_SLOTS, 0.0f),
+    mPublished(pack(0, 2)) {
+    // every slot starts at the identity pose, so nothing moves until the first publish
+    for(uint32_t slot = 0; slot < NUM_SLOTS; slot++) {
+        float* const pose = getSlot(slot) + numMorphWeights;
+        std::fill(pose + BoneTrack::RW * numBones, pose + (BoneTrack::RW + 1) * numBones, 1.0f);
+        std::fill(pose + BoneTrack::SX * numBones, pose + BoneTrack::COMPONENT_COUNT * numBones, 1.0f);
+    }
+}
+
+uint32_t LivePoseStream::publish() {
+    // release makes the writes to the slot visible to the consumer that acquires it
+    const uint64_t previous = mPublished.exchange(pack(++mSequence, mWriteSlot), std::memory_order_acq_rel);
+    mWriteSlot = previous & 0xFF;
+    return mWriteSlot;
+}
+
+bool LivePoseStream::acquire() {
+    uint64_t published = mPublished.load(std::memory_order_acquire);
+    while(true) {
+        const uint64_t sequence = published >> 8;
+        if(sequence == mLastSequence) {
+            return false;
+        }
+        // hand back the slot we were reading under the same sequence number, so it isn't mistaken for a new pose
+        if(mPublished.compare_exchange_weak(published, pack(sequence, mReadSlot), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            mReadSlot = published & 0xFF;
+            mLastSequence = sequence;
+            return true;
+        }
+    }
+}
+
+}
@@ -0,0 +1,241 @@
+#include "ProgramBlobCache.hpp"
+
+// std::filesystem is unavailable on our minimum iOS deployment target, and Apple platforms use Metal anyway.
+#if !defined(__APPLE__)
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <filament/MaterialEnums.h>
+
+#if defined(__ANDROID__) || defined(USE_ANGLE)
+#include <GLES3/gl3.h>
+#else
+#if defined(_WIN32)
+#include <Windows.h>
+#endif
+#include <GL/gl.h>
+#endif
+
+#include "Log.hpp"
+
+namespace polyvox {
+
+namespace fs = std::filesystem;
+
+static constexpr uint32_t kBlobMagic = 0x31434246; // "FBC1"
+
+struct BlobHeader {
+    uint32_t magic;
+    uint32_t keySize;
+    uint64_t valueSize;
+};
+
+static uint64_t fnv1a(const void* data, size_t size, uint64_t hash = 0xcbf29ce484222325ULL) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for(size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static std::string toHex(uint64_t value) {
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)value);
+    return std::string(buf);
+}
+
+static std::string getGlString(GLenum name) {
+    const GLubyte* value = glGetString(name);
+    return value ? std::string(reinterpret_cast<const char*>(value)) : std::string();
+}
+
+ProgramBlobCache::ProgramBlobCache(const char* directory, size_t maxSizeInBytes, const char* driverTag) :
+    _root(directory), _driverTag(driverTag ? driverTag : ""), _maxSizeInBytes(maxSizeInBytes) {
+    std::error_code ec;
+    fs::create_directories(_root, ec);
+    if(ec) {
+        Log("Failed to create program cache directory %s : %s", directory, ec.message().c_str());
+        return;
+    }
+    _valid = true;
+}
+
+bool ProgramBlobCache::open() {
+    if(_opened) {
+        return _ready;
+    }
+    _opened = true;
+
+    // the backend's context is current on the driver thread, which is where the blob callbacks are made
+    std::string identity = getGlString(GL_VENDOR) + "|" + getGlString(GL_RENDERER) + "|" + getGlString(GL_VERSION) + "|" +
+        _driverTag + "|opengl|" + std::to_string(filament::MATERIAL_VERSION);
+    std::string ns = toHex(fnv1a(identity.data(), identity.size()));
+
+    std::error_code ec;
+    fs::path root(_root);
+
+    // anything under the root that isn't the current namespace was written by a different driver/material version
+    std::vector<fs::path> stale;
+    for(auto& it : fs::directory_iterator(root, ec)) {
+        if(it.path().filename().string() != ns) {
+            stale.push_back(it.path());
+        }
+    }
+    for(auto& path : stale) {
+        Log("Removing stale program cache %s", path.string().c_str());
+        fs::remove_all(path, ec);
+    }
+
+    _directory = (root / ns).string();
+    fs::create_directories(_directory, ec);
+    if(ec) {
+        Log("Failed to create program cache directory %s : %s", _directory.c_str(), ec.message().c_str());
+        return false;
+    }
+
+    // rebuild the LRU index, ordered by last write time
+    std::vector<std::pair<fs::file_time_type, uint64_t>> existing;
+    std::vector<fs::path> invalid;
+    for(auto& it : fs::directory_iterator(_directory, ec)) {
+        auto name = it.path().filename().string();
+        if(it.path().extension() != ".bin" || name.size() != 20) {
+            invalid.push_back(it.path());
+            continue;
+        }
+        uint64_t hash = strtoull(name.substr(0, 16).c_str(), nullptr, 16);
+        Entry entry;
+        entry.size = fs::file_size(it.path(), ec);
+        _entries[hash] = entry;
+        _currentSizeInBytes += entry.size;
+        existing.emplace_back(fs::last_write_time(it.path(), ec), hash);
+    }
+    for(auto& path : invalid) {
+        fs::remove(path, ec);
+    }
+    std::sort(existing.begin(), existing.end());
+    for(auto& e : existing) {
+        _entries[e.second].lastUse = ++_useCounter;
+    }
+
+    _ready = true;
+    evict();
+    Log("Program cache at %s contains %d entries (%zu bytes)", _directory.c_str(), (int)_entries.size(), _currentSizeInBytes);
+    return true;
+}
+
+void ProgramBlobCache::attach(filament::backend::Platform* platform) {
+    if(!_valid || !platform) {
+        return;
+    }
+    // callbacks can only be set once per platform (e.g. a platform shared across viewer instances)
+    if(platform->hasBlobFunc()) {
+        return;
+    }
+    platform->setBlobFunc(
+        [this](const void* key, size_t keySize, const void* value, size_t valueSize) {
+            insert(key, keySize, value, valueSize);
+        },
+        [this](const void* key, size_t keySize, void* value, size_t valueSize) {
+            return retrieve(key, keySize, value, valueSize);
+        });
+}
+
+std::string ProgramBlobCache::pathForHash(uint64_t hash) const {
+    return (fs::path(_directory) / (toHex(hash) + ".bin")).string();
+}
+
+size_t ProgramBlobCache::retrieve(const void* key, size_t keySize, void* value, size_t valueSize) {
+    uint64_t hash = fnv1a(key, keySize);
+
+    std::lock_guard lock(_mutex);
+    if(!open()) {
+        return 0;
+    }
+    auto pos = _entries.find(hash);
+    if(pos == _entries.end()) {
+        return 0;
+    }
+
+    std::ifstream in(pathForHash(hash), std::ios::binary);
+    BlobHeader header;
+    if(!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != kBlobMagic || header.keySize != keySize) {
+        return 0;
+    }
+
+    // the filename is only a hash, so compare the full key to rule out collisions
+    std::vector<char> storedKey(keySize);
+    if(!in.read(storedKey.data(), keySize) || memcmp(storedKey.data(), key, keySize) != 0) {
+        return 0;
+    }
+
+    if(value && valueSize >= header.valueSize) {
+        if(!in.read(static_cast<char*>(value), header.valueSize)) {
+            return 0;
+        }
+    }
+    pos->second.lastUse = ++_useCounter;
+    return header.valueSize;
+}
+
+void ProgramBlobCache::insert(const void* key, size_t keySize, const void* value, size_t valueSize) {
+    uint64_t hash = fnv1a(key, keySize);
+    BlobHeader header { kBlobMagic, (uint32_t)keySize, (uint64_t)valueSize };
+    size_t totalSize = sizeof(header) + keySize + valueSize;
+    if(totalSize > _maxSizeInBytes) {
+        return;
+    }
+
+    std::lock_guard lock(_mutex);
+    if(!open()) {
+        return;
+    }
+    auto path = pathForHash(hash);
+    auto tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(static_cast<const char*>(key), keySize);
+        out.write(static_cast<const char*>(value), valueSize);
+        if(!out) {
+            Log("Failed to write program cache entry %s", tmpPath.c_str());
+            return;
+        }
+    }
+
+    // write-then-rename so a crash mid-write never leaves a truncated entry behind
+    std::error_code ec;
+    fs::rename(tmpPath, path, ec);
+    if(ec) {
+        fs::remove(tmpPath, ec);
+        return;
+    }
+
+    auto& entry = _entries[hash];
+    _currentSizeInBytes = _currentSizeInBytes - entry.size + totalSize;
+    entry.size = totalSize;
+    entry.lastUse = ++_useCounter;
+    evict();
+}
+
+void ProgramBlobCache::evict() {
+    std::error_code ec;
+    while(_currentSizeInBytes > _maxSizeInBytes && !_entries.empty()) {
+        auto lru = std::min_element(_entries.begin(), _entries.end(), [](const auto& a, const auto& b) {
+            return a.second.lastUse < b.second.lastUse;
+        });
+        fs::remove(pathForHash(lru->first), ec);
+        _currentSizeInBytes -= lru->second.size;
+        _entries.erase(lru);
+    }
+}
+
+} // namespace polyvox
+
+#endif
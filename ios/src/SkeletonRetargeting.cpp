@@ -0,0 +1,158 @@
+#include <string_view>
+#include <unordered_map>
+
+#include "SkeletonRetargeting.hpp"
+#include "BoneTracks.hpp"
+#include "Log.hpp"
+
+namespace polyvox {
+
+using namespace filament;
+using namespace filament::math;
+
+int RetargetCache::addSkeleton(const char** const boneNames, int numBones, const float* const restPose) {
+    if(numBones <= 0) {
+        Log("ERROR: a skeleton must have at least one bone.");
+        return -1;
+    }
+    Skeleton skeleton;
+    skeleton.mBoneNames.assign(boneNames, boneNames + numBones);
+    if(restPose) {
+        std::vector<float> pose(numBones * BoneTrack::COMPONENT_COUNT);
+        interleavedToBoneTracks(restPose, 1, numBones, true, pose.data());
+        normalizeBoneRotations(pose.data(), numBones);
+        skeleton.mRestTransforms.resize(numBones);
+        for(int i = 0; i < numBones; i++) {
+            skeleton.mRestTransforms[i] = composeBoneTransform(pose.data(), numBones, i);
+        }
+    }
+    const int id = _nextSkeletonId++;
+    _skeletons.emplace(id, std::move(skeleton));
+    return id;
+}
+
+bool RetargetCache::removeSkeleton(int skeleton) {
+    if(_skeletons.erase(skeleton) == 0) {
+        Log("ERROR: skeleton %d not found.", skeleton);
+        return false;
+    }
+    for(auto it = _maps.begin(); it != _maps.end();) {
+        it = it->first.first == skeleton ? _maps.erase(it) : std::next(it);
+    }
+    return true;
+}
+
+const Skeleton* RetargetCache::getSkeleton(int skeleton) const {
+    const auto it = _skeletons.find(skeleton);
+    return it == _skeletons.end() ? nullptr : &it->second;
+}
+
+std::shared_ptr<const RetargetMap> RetargetCache::getOrBuild(
+    int skeleton,
+    int32_t key,
+    gltfio::FilamentInstance* instance,
+    const utils::NameComponentManager& ncm,
+    TransformManager& transformManager) {
+    const auto cached = _maps.find({ skeleton, key });
+    if(cached != _maps.end()) {
+        return cached->second;
+    }
+    const Skeleton* source = getSkeleton(skeleton);
+    if(!source) {
+        Log("ERROR: skeleton %d not found.", skeleton);
+        return nullptr;
+    }
+    std::shared_ptr<const RetargetMap> map = build(*source, instance, ncm, transformManager, false);
+    if(!map) {
+        return nullptr;
+    }
+    _maps.emplace(std::make_pair(skeleton, key), map);
+    return map;
+}
+
+void RetargetCache::removeTarget(int32_t key) {
+    for(auto it = _maps.begin(); it != _maps.end();) {
+        it = it->first.second == key ? _maps.erase(it) : std::next(it);
+    }
+}
+
+std::shared_ptr<RetargetMap> RetargetCache::build(
+    const Skeleton& skeleton,
+    gltfio::FilamentInstance* instance,
+    const utils::NameComponentManager& ncm,
+    TransformManager& transformManager,
+    bool requireAll) {
+    const size_t numBones = skeleton.mBoneNames.size();
+    std::vector<const char*> names(numBones);
+    for(size_t i = 0; i < numBones; i++) {
+        names[i] = skeleton.mBoneNames[i].c_str();
+    }
+    std::vector<utils::Entity> joints(numBones);
+    findJoints(instance, ncm, names.data(), numBones, joints.data());
+
+    auto map = std::make_shared<RetargetMap>();
+    map->mJointInstances.resize(numBones);
+    map->mRestTransforms.resize(numBones);
+    map->mCorrections.resize(numBones);
+    for(size_t i = 0; i < numBones; i++) {
+        if(joints[i].isNull()) {
+            if(requireAll) {
+                Log("Failed to find bone %s", names[i]);
+                return nullptr;
+            }
+            continue;
+        }
+        const auto jointInstance = transformManager.getInstance(joints[i]);
+        const mat4f rest = transformManager.getTransform(jointInstance);
+        map->mJointInstances[i] = jointInstance;
+        map->mRestTransforms[i] = rest;
+        map->mCorrections[i] = skeleton.mRestTransforms.empty() ? rest : rest * inverse(skeleton.mRestTransforms[i]);
+        map->mNumMapped++;
+    }
+    if(map->mNumMapped == 0) {
+        Log("ERROR: none of the skeleton's %zu bones match a joint in the asset.", numBones);
+        return nullptr;
+    }
+    return map;
+}
+
+void RetargetCache::findJoints(
+    gltfio::FilamentInstance* instance,
+    const utils::NameComponentManager& ncm,
+    const char* const* names,
+    size_t numNames,
+    utils::Entity* out) {
+    // index the requested names rather than the joints, as there are usually far fewer
+    std::unordered_map<std::string_view, size_t> requested;
+    requested.reserve(numNames);
+    for(size_t i = 0; i < numNames; i++) {
+        out[i] = utils::Entity();
+        requested.emplace(names[i], i);
+    }
+    size_t numFound = 0;
+    for(size_t skinIndex = 0; skinIndex < instance->getSkinCount() && numFound < requested.size(); skinIndex++) {
+        const utils::Entity* joints = instance->getJointsAt(skinIndex);
+        const size_t numJoints = instance->getJointCountAt(skinIndex);
+        for(size_t j = 0; j < numJoints; j++) {
+            const auto nameInstance = ncm.getInstance(joints[j]);
+            if(!nameInstance.isValid()) {
+                continue;
+            }
+            const char* jointName = ncm.getName(nameInstance);
+            if(!jointName) {
+                continue;
+            }
+            const auto it = requested.find(jointName);
+            if(it != requested.end() && out[it->second].isNull()) {
+                out[it->second] = joints[j];
+                numFound++;
+            }
+        }
+    }
+    // a name listed more than once maps to the same joint each time
+    for(size_t i = 0; i < numNames; i++) {
+        out[i] = out[requested[names[i]]];
+    }
+}
+
+}
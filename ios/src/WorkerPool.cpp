@@ -0,0 +1,76 @@
+#include "WorkerPool.hpp"
+
+namespace polyvox {
+
+WorkerPool::WorkerPool(size_t numWorkers) {
+    mWorkers.reserve(numWorkers);
+    for(size_t i = 0; i < numWorkers; i++) {
+        mWorkers.emplace_back([this] { work(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard lock(mMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+    for(auto& worker : mWorkers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::claim() {
+    // mJob, mContext and mCount can't change until every worker has checked back in, so they're safe to read here
+    size_t index;
+    while((index = mNext.fetch_add(1, std::memory_order_relaxed)) < mCount) {
+        mJob(mContext, index);
+    }
+}
+
+void WorkerPool::run(size_t count, Job job, void* context) {
+    if(count == 0) {
+        return;
+    }
+    {
+        std::lock_guard lock(mMutex);
+        mJob = job;
+        mContext = context;
+        mCount = count;
+        mNext.store(0, std::memory_order_relaxed);
+        mNumBusy = mWorkers.size();
+        mGeneration++;
+    }
+    mWake.notify_all();
+
+    claim();
+
+    // every worker must have finished with this loop before the next one can be published
+    std::unique_lock lock(mMutex);
+    mDone.wait(lock, [this] { return mNumBusy == 0; });
+}
+
+void WorkerPool::work() {
+    uint64_t generation = 0;
+    while(true) {
+        {
+            std::unique_lock lock(mMutex);
+            mWake.wait(lock, [&] { return mStop || mGeneration != generation; });
+            if(mStop) {
+                return;
+            }
+            generation = mGeneration;
+        }
+        claim();
+        bool last;
+        {
+            std::lock_guard lock(mMutex);
+            last = --mNumBusy == 0;
+        }
+        if(last) {
+            mDone.notify_one();
+        }
+    }
+}
+
+}
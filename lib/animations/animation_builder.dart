@@ -53,6 +53,33 @@ class AnimationBuilder {
         _frameLengthInMs);
   }
 
+  ///
+  /// As [build], but returns the same animation as a handful of curve keys per morph target (to be evaluated natively)
+  /// rather than a weight for every frame.
+  ///
+  MorphCurveAnimationData buildCurves() {
+    if (availableMorphs.isEmpty || _duration == 0) {
+      throw Exception();
+    }
+    var start = _interpMorphStart!;
+    var end = _interpMorphEnd!;
+    var keys = <CurveKey>[];
+    // weights are zero outside the interpolated range
+    if (start > 0) {
+      keys.add(const CurveKey(0, 0));
+      keys.add(CurveKey(start, 0));
+    }
+    keys.add(CurveKey(start, _interpMorphStartValue!));
+    keys.add(CurveKey(end, _interpMorphEndValue!));
+    if (end < _duration) {
+      keys.add(CurveKey(end, 0));
+      keys.add(CurveKey(_duration, 0));
+    }
+    return MorphCurveAnimationData(meshName, {
+      for (var i in _morphTargets) availableMorphs[i]: AnimationCurve(keys)
+    });
+  }
+
   AnimationBuilder setDuration(double secs) {
     _duration = secs;
     return this;
@@ -45,3 +45,68 @@ class BoneAnimationData {
   BoneAnimationData(
       this.boneName, this.meshNames, this.frameData, this.frameLengthInMs);
 }
+
+///
+/// How an [AnimationCurve] interpolates between keys.
+/// [cubic] is a Hermite spline using the [CurveKey.outTangent] of each key and the [CurveKey.inTangent] of the next (in units per second).
+///
+enum CurveInterpolation { step, linear, cubic }
+
+class CurveKey {
+  /// in seconds
+  final double time;
+  final double value;
+  final double inTangent;
+  final double outTangent;
+  const CurveKey(this.time, this.value,
+      {this.inTangent = 0.0, this.outTangent = 0.0});
+}
+
+///
+/// A keyframed curve that is evaluated natively every frame. The value is held at the first/last key outside the range of [keys].
+/// [keys] must be sorted by time; two keys may share a time to create a discontinuity.
+///
+class AnimationCurve {
+  final CurveInterpolation interpolation;
+  final List<CurveKey> keys;
+  AnimationCurve(this.keys, {this.interpolation = CurveInterpolation.linear}) {
+    assert(keys.isNotEmpty);
+  }
+}
+
+///
+/// Animates the morph targets under a mesh named [meshName] with a curve per morph target (keyed by morph target name).
+/// This is far more compact than [MorphAnimationData] for procedurally authored animations, as only the keys are stored/transferred
+/// rather than a weight for every morph target at every frame. The animation lasts until the last key of any curve.
+///
+class MorphCurveAnimationData {
+  final String meshName;
+  final Map<String, AnimationCurve> curves;
+  MorphCurveAnimationData(this.meshName, this.curves);
+}
+
+///
+/// The components of a bone transform that can be animated by an [AnimationCurve], relative to the bone's rest transform.
+/// Rotation components are normalized after evaluation.
+///
+enum BoneChannel {
+  translationX,
+  translationY,
+  translationZ,
+  rotationX,
+  rotationY,
+  rotationZ,
+  rotationW,
+  scaleX,
+  scaleY,
+  scaleZ
+}
+
+///
+/// Animates bones (keyed by name) with a curve per [BoneChannel]. Channels without a curve are held at the rest transform.
+///
+class BoneCurveAnimationData {
+  final List<String> meshNames;
+  final Map<String, Map<BoneChannel, AnimationCurve>> curves;
+  BoneCurveAnimationData(this.meshNames, this.curves);
+}
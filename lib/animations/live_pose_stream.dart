@@ -0,0 +1,58 @@
+import 'dart:typed_data';
+
+import 'package:flutter_filament/animations/animation_data.dart';
+import 'package:vector_math/vector_math_64.dart';
+
+///
+/// A channel for streaming live poses (e.g. lip-sync weights or motion capture) to an entity without copying or blocking.
+///
+/// [morphWeights] and [bonePose] are views directly onto native memory. Write the next pose into them, then call [publish];
+/// the most recent pose published before each frame is applied on the render thread.
+/// After [publish], both getters return views onto a different buffer (which holds an older pose), so every value must be rewritten
+/// before the next [publish], and views must not be kept across calls to [publish].
+///
+/// Bone transforms are relative to each bone's transform when the stream was created (as per [BoneChannel]).
+///
+/// The stream is removed along with its entity (by `removeAsset` or `clearAssets`),
+/// after which [morphWeights], [bonePose] and [publish] throw. Views obtained before then must not be used either.
+///
+abstract class LivePoseStream {
+  int get numMorphWeights;
+  int get numBones;
+
+  ///
+  /// One weight for every morph target of the stream's mesh.
+  ///
+  Float32List get morphWeights;
+
+  ///
+  /// The transform of every bone, laid out as one block of [numBones] values for each [BoneChannel] in turn
+  /// (i.e. the value of [channel] for [bone] is at `channel.index * numBones + bone`).
+  ///
+  Float32List get bonePose;
+
+  ///
+  /// Makes the values written to [morphWeights] and [bonePose] available to the render thread.
+  /// This doesn't block or copy, and can be called as often as new poses arrive.
+  ///
+  void publish();
+
+  ///
+  /// Writes the transform of [bone] to [bonePose].
+  ///
+  void setBone(int bone, Vector3 translation, Quaternion rotation,
+      [Vector3? scale]) {
+    final pose = bonePose;
+    final n = numBones;
+    pose[BoneChannel.translationX.index * n + bone] = translation.x;
+    pose[BoneChannel.translationY.index * n + bone] = translation.y;
+    pose[BoneChannel.translationZ.index * n + bone] = translation.z;
+    pose[BoneChannel.rotationX.index * n + bone] = rotation.x;
+    pose[BoneChannel.rotationY.index * n + bone] = rotation.y;
+    pose[BoneChannel.rotationZ.index * n + bone] = rotation.z;
+    pose[BoneChannel.rotationW.index * n + bone] = rotation.w;
+    pose[BoneChannel.scaleX.index * n + bone] = scale?.x ?? 1.0;
+    pose[BoneChannel.scaleY.index * n + bone] = scale?.y ?? 1.0;
+    pose[BoneChannel.scaleZ.index * n + bone] = scale?.z ?? 1.0;
+  }
+}
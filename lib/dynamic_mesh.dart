@@ -0,0 +1,67 @@
+import 'dart:typed_data';
+
+import 'package:flutter_filament/filament_controller.dart';
+
+///
+/// The per-vertex attributes of a [DynamicMesh] (in the order the native API expects them).
+///
+enum DynamicMeshAttribute {
+  position,
+  normal,
+  uv,
+  color,
+  custom0,
+  custom1,
+  custom2,
+  custom3,
+  custom4,
+  custom5,
+  custom6,
+  custom7
+}
+
+///
+/// How a [DynamicMesh]'s indices are assembled into primitives (the values match Filament's RenderableManager::PrimitiveType).
+///
+enum DynamicMeshPrimitiveType {
+  points(0),
+  lines(1),
+  lineStrip(3),
+  triangles(4),
+  triangleStrip(5);
+
+  final int value;
+  const DynamicMeshPrimitiveType(this.value);
+}
+
+///
+/// A mesh whose vertices and indices are rewritten by the caller (e.g. a live sensor surface or a trail), as often as every frame.
+///
+/// Every getter returns a view directly onto native memory, which the render thread uploads to the GPU without copying.
+/// Write the next vertices and indices into them, then call [publish]; the most recent mesh published before each frame is drawn.
+/// As with [LivePoseStream], after [publish] the getters return views onto a different buffer (which holds older data), so every value
+/// in use must be rewritten before the next [publish], and views must not be kept across calls to [publish].
+///
+abstract class DynamicMesh {
+  FilamentEntity get entity;
+  int get maxVertices;
+  int get maxIndices;
+
+  ///
+  /// The values of [attribute] ([maxVertices] blocks of however many floats the attribute was created with), or null if the mesh doesn't have it.
+  ///
+  Float32List? attribute(DynamicMeshAttribute attribute);
+
+  Float32List get positions => attribute(DynamicMeshAttribute.position)!;
+  Float32List? get normals => attribute(DynamicMeshAttribute.normal);
+  Float32List? get uvs => attribute(DynamicMeshAttribute.uv);
+  Float32List? get colors => attribute(DynamicMeshAttribute.color);
+
+  Uint32List get indices;
+
+  ///
+  /// Makes the first [numVertices] vertices and [numIndices] indices available to the render thread (which draws nothing if either is zero).
+  /// Indices must be less than [numVertices]. This doesn't block or copy, and can be called as often as new data arrives.
+  ///
+  void publish(int numVertices, int numIndices);
+}
@@ -1,10 +1,13 @@
 // ignore_for_file: constant_identifier_names
 
 import 'dart:async';
+import 'dart:typed_data';
 import 'dart:ui' as ui;
 import 'package:flutter/widgets.dart';
 
 import 'package:flutter_filament/animations/animation_data.dart';
+import 'package:flutter_filament/animations/live_pose_stream.dart';
+import 'package:flutter_filament/dynamic_mesh.dart';
 import 'package:vector_math/vector_math_64.dart';
 
 // a handle that can be safely passed back to the rendering layer to manipulate an Entity
@@ -15,6 +18,31 @@ enum ToneMapper { ACES, FILMIC, LINEAR }
 // see filament Manipulator.h for more details
 enum ManipulatorMode { ORBIT, MAP, FREE_FLIGHT }
 
+// feature bits describing a specialized material package (see SpecializedMaterialProvider.hpp)
+class MaterialFeature {
+  static const DOUBLE_SIDED = 1 << 0;
+  static const UNLIT = 1 << 1;
+  static const VERTEX_COLORS = 1 << 2;
+  static const BASE_COLOR_TEXTURE = 1 << 3;
+  static const NORMAL_TEXTURE = 1 << 4;
+  static const OCCLUSION_TEXTURE = 1 << 5;
+  static const EMISSIVE_TEXTURE = 1 << 6;
+  static const SPECULAR_GLOSSINESS = 1 << 7;
+  static const METALLIC_ROUGHNESS_TEXTURE = 1 << 8;
+  static const CLEAR_COAT = 1 << 9;
+  static const CLEAR_COAT_TEXTURES = 1 << 10;
+  static const TRANSMISSION = 1 << 11;
+  static const TRANSMISSION_TEXTURE = 1 << 12;
+  static const SHEEN = 1 << 13;
+  static const SHEEN_TEXTURES = 1 << 14;
+  static const VOLUME = 1 << 15;
+  static const VOLUME_TEXTURE = 1 << 16;
+  static const IOR = 1 << 17;
+  static const TEXTURE_TRANSFORMS = 1 << 18;
+  static const ALPHA_MODE_MASK = 1 << 24;
+  static const ALPHA_MODE_BLEND = 2 << 24;
+}
+
 class TextureDetails {
   final int textureId;
 
@@ -26,6 +54,108 @@ class TextureDetails {
       {required this.textureId, required this.width, required this.height});
 }
 
+///
+/// Easing curves for tweens (see [FilamentController.tweenPosition] etc).
+///
+enum TweenEasing {
+  linear,
+  easeInQuad,
+  easeOutQuad,
+  easeInOutQuad,
+  easeInCubic,
+  easeOutCubic,
+  easeInOutCubic,
+  easeInOutSine
+}
+
+///
+/// How the bounding boxes of skinned meshes follow animations (see [FilamentController.setAnimatedBounds]).
+///
+enum AnimatedBoundsMode {
+  /// the boxes computed at load (i.e. the bind pose), which animations can move vertices outside of
+  bindPose,
+
+  /// the bind pose plus every pose of each glTF animation currently playing, precomputed once per animation
+  perClip,
+
+  /// the current positions of the joints, recomputed every frame the entity is posed (which also covers bone animations and live poses)
+  perFrame
+}
+
+/// How a [TransitionCondition] compares an animation state parameter with its value.
+///
+enum TransitionConditionOp {
+  greater,
+  less,
+  equal,
+  notEqual,
+
+  /// holds while the parameter is non-zero; the parameter is reset to zero when the transition is taken
+  trigger
+}
+
+///
+/// A condition on an animation state transition (see [FilamentController.addAnimationStateTransition]).
+///
+class TransitionCondition {
+  final int parameter;
+  final TransitionConditionOp op;
+  final double value;
+
+  const TransitionCondition(this.parameter, this.op, [this.value = 0.0]);
+}
+
+///
+/// Everything about an entity that doesn't change once it has been loaded (see [FilamentController.getAssetMetadata]).
+///
+class AssetMetadata {
+  final List<({String name, double duration})> animations;
+
+  /// the name, entity and morph target names of each mesh
+  final List<({String name, FilamentEntity entity, List<String> morphTargets})>
+      meshes;
+  final List<String> joints;
+  final List<({String name, FilamentEntity entity})> cameras;
+  final List<({String name, FilamentEntity entity})> lights;
+
+  /// the bounding box when the entity was loaded
+  final Vector3 boundsMin;
+  final Vector3 boundsMax;
+
+  AssetMetadata(this.animations, this.meshes, this.joints, this.cameras,
+      this.lights, this.boundsMin, this.boundsMax);
+
+  factory AssetMetadata.fromJson(Map<String, dynamic> json) {
+    List<({String name, FilamentEntity entity})> entities(List<dynamic> list) =>
+        list
+            .map((e) => (name: e["name"] as String, entity: e["entity"] as int))
+            .toList();
+    Vector3 vector(List<dynamic> v) => Vector3(
+        (v[0] as num).toDouble(),
+        (v[1] as num).toDouble(),
+        (v[2] as num).toDouble());
+    return AssetMetadata(
+        (json["animations"] as List<dynamic>)
+            .map((a) => (
+                  name: a["name"] as String,
+                  duration: (a["duration"] as num).toDouble()
+                ))
+            .toList(),
+        (json["meshes"] as List<dynamic>)
+            .map((m) => (
+                  name: m["name"] as String,
+                  entity: m["entity"] as int,
+                  morphTargets: (m["morphTargets"] as List<dynamic>).cast<String>()
+                ))
+            .toList(),
+        (json["joints"] as List<dynamic>).cast<String>(),
+        entities(json["cameras"]),
+        entities(json["lights"]),
+        vector(json["bounds"]["min"]),
+        vector(json["bounds"]["max"]));
+  }
+}
+
 abstract class FilamentController {
   ///
   /// A Stream containing every FilamentEntity added to the scene (i.e. via [loadGlb], [loadGltf] or [addLight]).
@@ -168,6 +298,26 @@ abstract class FilamentController {
   ///
   Future loadIbl(String lightingPath, {double intensity = 30000});
 
+  ///
+  /// Loads an equirectangular HDR (.hdr/.exr) image from the specified path and converts it to an image-based light in the background.
+  /// This returns immediately; the current IBL (if any) is replaced once prefiltering has completed.
+  /// If [cacheDirectory] is provided (and exists), the prefiltered result is cached there so subsequent loads of the same image are fast.
+  ///
+  Future loadIblFromEquirect(String path,
+      {double intensity = 30000, String? cacheDirectory});
+
+  ///
+  /// Loads a KTX skybox and/or KTX image-based light in the background and swaps them in together on the same frame,
+  /// so the scene never shows a new skybox with the old lighting (or vice versa).
+  /// If [crossfade] is non-zero, the current IBL fades out and the new IBL fades in over that duration (the skybox is swapped at the midpoint).
+  /// Rendering continues with the current environment while the new one loads.
+  ///
+  Future loadEnvironment(
+      {String? skyboxPath,
+      String? iblPath,
+      double intensity = 30000,
+      Duration crossfade = Duration.zero});
+
   ///
   /// Removes the image-based light from the scene.
   ///
@@ -202,11 +352,40 @@ abstract class FilamentController {
   ///
   Future clearLights();
 
+  ///
+  /// Creates a [DynamicMesh] with room for [maxVertices] vertices and [maxIndices] indices, drawn with the compiled material at [materialPath].
+  /// Positions are always included; [normals], [uvs] and [colors] add those attributes, and [customComponents] gives the number of floats
+  /// (1-4) of each custom attribute the material requires (e.g. `{DynamicMeshAttribute.custom0: 1}`).
+  /// Uploads cycle through [numBuffers] GPU buffers (2 or 3) so a buffer is never rewritten while an earlier frame may still be drawing it.
+  ///
+  Future<DynamicMesh> createDynamicMesh(String materialPath,
+      {required int maxVertices,
+      required int maxIndices,
+      DynamicMeshPrimitiveType primitiveType =
+          DynamicMeshPrimitiveType.triangles,
+      bool normals = false,
+      bool uvs = false,
+      bool colors = false,
+      Map<DynamicMeshAttribute, int> customComponents = const {},
+      int numBuffers = 3});
+
+  ///
+  /// Removes a [DynamicMesh] created with [createDynamicMesh]. The mesh must not be used afterwards.
+  ///
+  Future removeDynamicMesh(DynamicMesh mesh);
+
   ///
   /// Load the .glb asset at the given path and insert into the scene.
+  /// If [unlit] is true, all materials in the asset are rendered with the (much cheaper) unlit shading model and only the base color/vertex color is used.
   ///
   Future<FilamentEntity> loadGlb(String path, {bool unlit = false});
 
+  ///
+  /// Register a pre-built material package (.filamat) at [packagePath] to be used instead of the ubershader for any glTF material whose features exactly match [features] (a bitmask of [MaterialFeature] values).
+  /// The package must be compiled from the gltfio material template. Only affects assets loaded after this call.
+  ///
+  Future addMaterialSpecialization(String packagePath, int features);
+
   ///
   /// Load the .gltf asset at the given path and insert into the scene.
   /// [relativeResourcePath] is the folder path where the glTF resources are stored;
@@ -256,6 +435,12 @@ abstract class FilamentController {
 
   Future<List<String>> getAnimationNames(FilamentEntity entity);
 
+  ///
+  /// Returns the names, durations, meshes, morph targets, joints, cameras, lights and bounds of [entity] in a single call.
+  /// These are gathered when the entity is loaded, so this never waits for the render thread (unlike most other methods).
+  ///
+  Future<AssetMetadata> getAssetMetadata(FilamentEntity entity);
+
   ///
   /// Returns the length (in seconds) of the animation at the given index.
   ///
@@ -266,11 +451,77 @@ abstract class FilamentController {
   /// Animate the morph targets in [entity]. See [MorphTargetAnimation] for an explanation as to how to construct the animation frame data.
   /// This method will check the morph target names specified in [animation] against the morph target names that actually exist exist under [meshName] in [entity],
   /// throwing an exception if any cannot be found.
-  /// It is permissible for [animation] to omit any targets that do exist under [meshName]; these simply won't be animated.
+  /// It is permissible for [animation] to omit any targets that do exist under [meshName]; these simply won't be animated
+  /// (though omitted targets whose index lies between the first and last animated targets are held at zero).
+  /// Weights are linearly interpolated between frames. Each mesh can have one morph animation at a time; setting another animation for the same mesh replaces it.
   ///
   Future setMorphAnimationData(
       FilamentEntity entity, MorphAnimationData animation);
 
+  ///
+  /// Animate the morph targets in [entity] with curves that are evaluated natively every frame (see [MorphCurveAnimationData]).
+  /// Morph target names are checked as per [setMorphAnimationData]. Replaces any existing morph animation for the same mesh.
+  ///
+  Future setMorphCurveAnimation(
+      FilamentEntity entity, MorphCurveAnimationData animation);
+
+  ///
+  /// Animate bones in [entity] with curves that are evaluated natively every frame (see [BoneCurveAnimationData]).
+  /// Replaces any existing bone animation for [entity].
+  ///
+  Future setBoneCurveAnimation(
+      FilamentEntity entity, BoneCurveAnimationData animation);
+
+  ///
+  /// Registers the bones of a source rig (e.g. the rig a set of animations was captured on) and returns a handle for [createBoneAnimationClip].
+  /// Bone names are matched against each entity once, the first time a clip for this skeleton is set on it, rather than every time.
+  /// [restPose] optionally holds the local rest transform of each bone in the source rig (10 values per bone, as per [BoneChannel]).
+  /// If given, clip frames are the source rig's local transforms and are corrected for the difference between the two rest poses;
+  /// otherwise they are relative to each entity's rest pose.
+  ///
+  Future<int> createSkeleton(List<String> boneNames, {Float32List? restPose});
+
+  ///
+  /// Removes [skeleton] along with every clip created for it.
+  ///
+  Future removeSkeleton(int skeleton);
+
+  ///
+  /// Registers bone animation frames for [skeleton] and returns a handle that can be passed to [setBoneAnimationClip] for any entity
+  /// with matching joints. [frameData] holds 10 values per bone per frame (as per [BoneChannel]), and is converted (and compressed, if enabled
+  /// with [setAnimationCompression]) once, here.
+  ///
+  Future<int> createBoneAnimationClip(
+      int skeleton, Float32List frameData, double frameLengthInMs);
+
+  Future removeBoneAnimationClip(int clip);
+
+  ///
+  /// Replaces any bone animation for [entity] with [clip]. Bones with no matching joint in [entity] are ignored.
+  ///
+  Future setBoneAnimationClip(FilamentEntity entity, int clip);
+
+  ///
+  /// If [enabled], morph and bone animation frames are compressed when set (weights and translations are quantized to 16 bits, rotations to 48 bits),
+  /// and frames that can be interpolated from their neighbours to within [maxError] are dropped. This substantially reduces memory for long animations,
+  /// at the cost of a small amount of precision. Only affects animations set after this is called. Disabled by default.
+  ///
+  Future setAnimationCompression(bool enabled, {double maxError = 0.0});
+
+  ///
+  /// Compresses [animation] into a blob that can be stored (e.g. bundled as an asset) and later passed to [setCompressedMorphAnimationData],
+  /// avoiding the cost of compressing the animation at runtime. See [setAnimationCompression] for [maxError].
+  ///
+  Future<Uint8List> compressMorphAnimation(MorphAnimationData animation,
+      {double maxError = 0.0});
+
+  ///
+  /// As [setMorphAnimationData], but with frame data previously compressed by [compressMorphAnimation].
+  /// [morphTargets] must match (in order) the morph targets of the [MorphAnimationData] that was compressed.
+  ///
+  Future setCompressedMorphAnimationData(FilamentEntity entity,
+      String meshName, List<String> morphTargets, Uint8List data);
+
   ///
   /// Animates morph target weights/bone transforms (where each frame requires a duration of [frameLengthInMs].
   /// [morphWeights] is a list of doubles in frame-major format.
@@ -282,12 +533,14 @@ abstract class FilamentController {
   ///
   /// Removes/destroys the specified entity from the scene.
   /// [entity] will no longer be a valid handle after this method is called; ensure you immediately discard all references once this method is complete.
+  /// Any [LivePoseStream] for [entity] is removed too, and throws if used afterwards.
   ///
   Future removeAsset(FilamentEntity entity);
 
   ///
   /// Removes/destroys all renderable entities from the scene (including cameras).
   /// All [FilamentEntity] handles will no longer be valid after this method is called; ensure you immediately discard all references to all entities once this method is complete.
+  /// Every [LivePoseStream] is removed too, and throws if used afterwards.
   ///
   Future clearAssets();
 
@@ -308,17 +561,233 @@ abstract class FilamentController {
 
   ///
   /// Schedules the glTF animation at [index] in [entity] to start playing on the next frame.
+  /// [startOffset] (in seconds) starts playback part-way through the animation, e.g. so several instances of the same model don't move in lockstep.
   ///
   Future playAnimation(FilamentEntity entity, int index,
       {bool loop = false,
       bool reverse = false,
       bool replaceActive = true,
-      double crossfade = 0.0});
+      double crossfade = 0.0,
+      double startOffset = 0.0});
+
+  ///
+  /// Moves the glTF animation at [index] in [entity] to [seconds]. If the animation isn't playing, the entity is posed at that time and held there
+  /// (until the animation is seeked again, played or stopped). Seeking is applied even while animations are paused, and is cheap to call
+  /// at pointer-move rates (e.g. when scrubbing a timeline): only the most recent seek before each frame is evaluated.
+  /// An animation posed this way is always sampled from the table described in [setAnimationBaking] (at its sample rate), whether or not baking is enabled.
+  ///
+  Future seekAnimation(FilamentEntity entity, int index, double seconds);
 
-  Future setAnimationFrame(
-      FilamentEntity entity, int index, int animationFrame);
+  ///
+  /// Seeks the glTF animation at [index] in [entity] to [animationFrame], where the animation is treated as running at [framesPerSecond]
+  /// (see [seekAnimation]).
+  ///
+  Future setAnimationFrame(FilamentEntity entity, int index, int animationFrame,
+      {double framesPerSecond = 60.0});
   Future stopAnimation(FilamentEntity entity, int animationIndex);
 
+  ///
+  /// Sets the speed at which animations play (1.0 is normal speed, 0.5 is half speed, etc). Must not be negative.
+  /// If [entity] is provided, only that entity's animations are affected (and the scale is multiplied with the global time scale).
+  ///
+  Future setAnimationTimeScale(double timeScale, {FilamentEntity? entity});
+
+  ///
+  /// Pauses (or resumes) all animations, or only those for [entity] if provided.
+  ///
+  Future setAnimationsPaused(bool paused, {FilamentEntity? entity});
+
+  ///
+  /// If [timestep] is non-null, every rendered frame advances animations by exactly [timestep] rather than the actual frame time.
+  /// This makes playback deterministic (e.g. when capturing frames offline). Pass null to return to real time.
+  ///
+  Future setFixedAnimationTimestep(Duration? timestep);
+
+  ///
+  /// Enables (or disables) animation level-of-detail. When enabled, animations for entities that are hidden or outside the camera frustum keep time but aren't evaluated,
+  /// and entities covering less than [halfRateScreenSize] (or [quarterRateScreenSize]) of the viewport height are only evaluated every 2nd (or 4th) frame.
+  /// Disabled by default, as entities outside the frustum may still cast visible shadows.
+  ///
+  Future setAnimationLod(bool enabled,
+      {double halfRateScreenSize = 0.1, double quarterRateScreenSize = 0.03});
+
+  ///
+  /// Returns the number of times skinned entities have had their bone matrices recomputed, and the number of recomputations that were skipped
+  /// because the pose hadn't changed (or because several animations on the same entity only needed a single update).
+  /// If [reset] is true, both counters are reset to zero.
+  ///
+  Future<({int updated, int skipped})> getSkinUpdateStats({bool reset = false});
+
+  ///
+  /// Creates a [LivePoseStream] driving the morph targets of the mesh named [meshName] and/or the bones named in [boneNames] in [entity].
+  /// Only one stream can exist for each entity at a time. Streamed poses are applied after (i.e. override) any animations.
+  ///
+  Future<LivePoseStream> createLivePoseStream(FilamentEntity entity,
+      {String? meshName, List<String> boneNames = const []});
+
+  ///
+  /// Removes the [LivePoseStream] for [entity], returning its bones to their transforms when the stream was created.
+  /// The stream throws if used afterwards.
+  ///
+  Future removeLivePoseStream(FilamentEntity entity);
+
+  ///
+  /// Returns a handle to the joint (or any other node) named [jointName] in [entity], for attaching constraints.
+  ///
+  Future<FilamentEntity> getJointHandle(FilamentEntity entity, String jointName);
+
+  ///
+  /// Adds an analytic two-bone IK constraint (e.g. shoulder, elbow, wrist) to [entity], returning an ID for the methods below.
+  /// Constraints are solved natively every frame after animations, layers and live poses have been applied, in the order they were added.
+  /// The target starts at [endJoint]'s current position; move it with [setConstraintTarget] or [setConstraintTargetEntity].
+  ///
+  Future<int> addTwoBoneIkConstraint(FilamentEntity entity,
+      FilamentEntity upperJoint, FilamentEntity lowerJoint, FilamentEntity endJoint,
+      {double weight = 1.0});
+
+  ///
+  /// Adds an IK constraint over the chain [joints] (from the root to the end effector), solved by cyclic coordinate descent
+  /// or (if [fabrik] is true) forward and backward reaching IK, in at most [iterations] iterations per frame.
+  ///
+  Future<int> addChainIkConstraint(
+      FilamentEntity entity, List<FilamentEntity> joints,
+      {bool fabrik = false, int iterations = 10, double weight = 1.0});
+
+  ///
+  /// Adds a constraint turning [joint] so its local [forward] axis (by default +Z) points at the target, rotating it by no more than
+  /// [maxAngle] radians (or without limit if null).
+  ///
+  Future<int> addLookAtConstraint(FilamentEntity entity, FilamentEntity joint,
+      {Vector3? forward, double? maxAngle, double weight = 1.0});
+
+  ///
+  /// Sets the world-space target of [constraint], replacing any entity set with [setConstraintTargetEntity].
+  ///
+  Future setConstraintTarget(
+      FilamentEntity entity, int constraint, Vector3 target);
+
+  ///
+  /// Makes [constraint] follow the world position of [target] (e.g. a prop or another entity's joint) every frame.
+  ///
+  Future setConstraintTargetEntity(
+      FilamentEntity entity, int constraint, FilamentEntity target);
+
+  ///
+  /// Sets the world-space position that a two-bone IK constraint bends its middle joint towards.
+  ///
+  Future setConstraintPole(FilamentEntity entity, int constraint, Vector3 pole);
+
+  ///
+  /// Blends [constraint] with the animated pose, from 0 (no effect) to 1.
+  ///
+  Future setConstraintWeight(
+      FilamentEntity entity, int constraint, double weight);
+
+  ///
+  /// Removes [constraint], returning its joints to the animated pose.
+  ///
+  Future removeConstraint(FilamentEntity entity, int constraint);
+
+  ///
+  /// If [enabled], glTF animations are pre-sampled at [sampleRate] frames per second the first time they are played, and played back from that table
+  /// rather than evaluated from the glTF channels every frame. The table is shared by every entity loaded from the same path.
+  /// This trades a one-off cost (and a little precision) for cheaper playback when many copies of a model are animating.
+  /// Only affects animations started after this is called. Disabled by default.
+  ///
+  Future setAnimationBaking(bool enabled, {double sampleRate = 30.0});
+
+  ///
+  /// Adds a blend layer playing the glTF animation at [index] on [entity] and returns its ID.
+  /// Layers are blended in the order they were added, over the pose of any animations started with [playAnimation] (or the entity's rest pose if none are playing).
+  /// An override layer moves the pose towards its animation by [weight] (so a weight of 1 replaces it);
+  /// an [additive] layer adds the difference between its animation's current frame and its first frame, scaled by [weight].
+  /// Layers play from the table described in [setAnimationBaking] (at its sample rate), whether or not baking is enabled.
+  /// Layers never complete; if [loop] is false, the layer holds its last frame.
+  ///
+  Future<int> addAnimationLayer(FilamentEntity entity, int index,
+      {double weight = 1.0, bool additive = false, bool loop = true});
+
+  ///
+  /// Removes the blend layer [layer] from [entity]. Joints that are no longer affected by any layer return to their rest pose (or the pose of any playing animation).
+  ///
+  Future removeAnimationLayer(FilamentEntity entity, int layer);
+
+  ///
+  /// Sets the weight (between 0 and 1) of the blend layer [layer] on [entity].
+  ///
+  Future setAnimationLayerWeight(FilamentEntity entity, int layer, double weight);
+
+  ///
+  /// Sets the playback position of the blend layer [layer] on [entity] to [seconds].
+  ///
+  Future setAnimationLayerTime(FilamentEntity entity, int layer, double seconds);
+
+  ///
+  /// Sets the playback speed of the blend layer [layer] on [entity] (negative values play backwards).
+  ///
+  Future setAnimationLayerSpeed(FilamentEntity entity, int layer, double speed);
+
+  ///
+  /// Restricts the blend layer [layer] on [entity] to the nodes named in [joints], each scaled by its weight (between 0 and 1).
+  /// If [includeDescendants] is true, each listed joint also applies to every node beneath it (unless that node is listed itself).
+  /// Passing an empty map removes the mask.
+  ///
+  Future setAnimationLayerMask(
+      FilamentEntity entity, int layer, Map<String, double> joints,
+      {bool includeDescendants = true});
+
+  ///
+  /// Adds a parameter to the animation state machine of [entity] (creating the state machine if needed) and returns its index.
+  /// The state machine plays its states via blend layers beneath any added with [addAnimationLayer], and is evaluated natively every frame,
+  /// so once it has been set up only parameter changes need to be sent.
+  ///
+  Future<int> addAnimationStateParameter(FilamentEntity entity, String name,
+      {double value = 0.0});
+
+  ///
+  /// Adds a state playing the glTF animations at [indices] and returns its index.
+  /// If more than one animation is given, they are blended by the value of [blendParameter] at the ascending [thresholds] (e.g. idle, walk and run
+  /// at speeds of 0, 1 and 3). Blended animations share the same normalized time, so animations of different lengths stay in step.
+  ///
+  Future<int> addAnimationState(FilamentEntity entity, String name,
+      List<int> indices,
+      {List<double>? thresholds,
+      int blendParameter = -1,
+      double speed = 1.0,
+      bool loop = true});
+
+  ///
+  /// Adds a transition from state [from] (or from any other state if null) to state [to], taken once every one of [conditions] holds and
+  /// (if [exitTime] is set) the normalized time of the state being left has reached [exitTime]. The states are crossfaded over [crossfade] seconds.
+  /// Returns the index of the transition.
+  ///
+  Future<int> addAnimationStateTransition(FilamentEntity entity, int? from,
+      int to, List<TransitionCondition> conditions,
+      {double crossfade = 0.25, double? exitTime});
+
+  ///
+  /// Sets the value of [parameter] in the animation state machine of [entity]. Transitions and blend weights pick it up on the next frame.
+  ///
+  Future setAnimationStateParameter(
+      FilamentEntity entity, int parameter, double value);
+
+  ///
+  /// Moves the animation state machine of [entity] to [state] (crossfading over [crossfade] seconds), regardless of any transitions.
+  /// No state plays until this has been called at least once.
+  ///
+  Future setAnimationState(FilamentEntity entity, int state,
+      {double crossfade = 0.0});
+
+  ///
+  /// Returns the index of the current state of the animation state machine of [entity], or -1 if it hasn't been started.
+  ///
+  Future<int> getAnimationState(FilamentEntity entity);
+
+  ///
+  /// Removes the animation state machine of [entity] (and every state, parameter and transition added to it).
+  ///
+  Future removeAnimationStateMachine(FilamentEntity entity);
+
   ///
   /// Sets the current scene camera to the glTF camera under [name] in [entity].
   ///
@@ -394,6 +863,13 @@ abstract class FilamentController {
   ///
   Future setViewFrustumCulling(bool enabled);
 
+  ///
+  /// Sets how the bounding boxes of the skinned meshes in [entity] follow its animations, so frustum culling can stay enabled without
+  /// animated meshes popping out of view. [padding] is added to every box (e.g. to allow for morph targets).
+  ///
+  Future setAnimatedBounds(FilamentEntity entity, AnimatedBoundsMode mode,
+      {double padding = 0.0});
+
   ///
   /// Sets the camera exposure.
   ///
@@ -416,6 +892,68 @@ abstract class FilamentController {
   Future setMaterialColor(
       FilamentEntity entity, String meshName, int materialIndex, Color color);
 
+  //
+  // Tweens are evaluated natively once per frame (alongside animations, so they respect setAnimationTimeScale and pausing),
+  // so any number can run without a call per frame from Dart. Each returns an ID that can be passed to cancelTween.
+  // onComplete is called when the tween ends, with `finished` set to false if it was cancelled, replaced by another tween of the
+  // same property on the same target, or its target was removed.
+  //
+
+  ///
+  /// Tweens the position of [entity] from [from] to [to] over [duration].
+  ///
+  Future<int> tweenPosition(
+      FilamentEntity entity, Vector3 from, Vector3 to, Duration duration,
+      {TweenEasing easing = TweenEasing.linear,
+      void Function(bool finished)? onComplete});
+
+  ///
+  /// Tweens the rotation of [entity] from [from] to [to] (along the shortest arc) over [duration].
+  ///
+  Future<int> tweenRotation(
+      FilamentEntity entity, Quaternion from, Quaternion to, Duration duration,
+      {TweenEasing easing = TweenEasing.linear,
+      void Function(bool finished)? onComplete});
+
+  ///
+  /// Tweens the (uniform) scale of [entity] from [from] to [to] over [duration].
+  ///
+  Future<int> tweenScale(
+      FilamentEntity entity, double from, double to, Duration duration,
+      {TweenEasing easing = TweenEasing.linear,
+      void Function(bool finished)? onComplete});
+
+  ///
+  /// Tweens the `baseColorFactor` of the material at [materialIndex] in [entity] under node [meshName] (see [setMaterialColor]).
+  ///
+  Future<int> tweenMaterialColor(FilamentEntity entity, String meshName,
+      int materialIndex, Color from, Color to, Duration duration,
+      {TweenEasing easing = TweenEasing.linear,
+      void Function(bool finished)? onComplete});
+
+  ///
+  /// Tweens the intensity of [light] (as returned by [addLight]) from [from] to [to] over [duration].
+  ///
+  Future<int> tweenLightIntensity(
+      FilamentEntity light, double from, double to, Duration duration,
+      {TweenEasing easing = TweenEasing.linear,
+      void Function(bool finished)? onComplete});
+
+  ///
+  /// Tweens the exposure of the active camera (see [setCameraExposure]) over [duration].
+  ///
+  Future<int> tweenCameraExposure(
+      ({double aperture, double shutterSpeed, double sensitivity}) from,
+      ({double aperture, double shutterSpeed, double sensitivity}) to,
+      Duration duration,
+      {TweenEasing easing = TweenEasing.linear,
+      void Function(bool finished)? onComplete});
+
+  ///
+  /// Stops the tween [tween] where it is. Returns false if it had already ended.
+  ///
+  Future<bool> cancelTween(int tween);
+
   ///
   /// Scale [entity] to fit within the unit cube.
   ///
@@ -452,6 +990,30 @@ abstract class FilamentController {
   ///
   Future hide(FilamentEntity entity, String meshName);
 
+  ///
+  /// Draws many copies of the node [meshName] under [entity] with hardware instancing (so each primitive is drawn once per batch of copies,
+  /// rather than once per copy), using the node's materials. Pass [primitiveIndex] to only draw one primitive of the mesh.
+  /// [transforms] holds 16 values (a column-major 4x4 matrix, relative to the root of [entity]) per copy.
+  /// Returns an entity that parents every copy; the original node is left as-is (call [hide] to remove it).
+  /// Skinned and Draco-compressed meshes can't be instanced.
+  /// Nodes with the EXT_mesh_gpu_instancing extension are instanced this way automatically when loaded.
+  ///
+  Future<FilamentEntity> createInstancedMesh(
+      FilamentEntity entity, String meshName, Float32List transforms,
+      {int primitiveIndex = -1});
+
+  ///
+  /// Replaces the transforms of the copies from [offset] (one per 16 values in [transforms]) in an instanced mesh created with [createInstancedMesh].
+  ///
+  Future setInstanceTransforms(
+      FilamentEntity instancedMesh, Float32List transforms,
+      {int offset = 0});
+
+  ///
+  /// Removes an instanced mesh created with [createInstancedMesh]. Instanced meshes are also removed along with the asset they were created from.
+  ///
+  Future removeInstancedMesh(FilamentEntity instancedMesh);
+
   ///
   /// Used to select the entity in the scene at the given viewport coordinates.
   /// Called by `FilamentGestureDetector` on a mouse/finger down event. You probably don't want to call this yourself.
@@ -1,6 +1,8 @@
 import 'dart:async';
+import 'dart:convert';
 import 'dart:ffi';
 import 'dart:io';
+import 'dart:typed_data';
 import 'dart:ui' as ui;
 import 'dart:developer' as dev;
 import 'package:flutter/services.dart';
@@ -10,6 +12,8 @@ import 'package:flutter/widgets.dart';
 import 'package:flutter_filament/filament_controller.dart';
 
 import 'package:flutter_filament/animations/animation_data.dart';
+import 'package:flutter_filament/animations/live_pose_stream.dart';
+import 'package:flutter_filament/dynamic_mesh.dart';
 import 'package:flutter_filament/generated_bindings.dart';
 import 'package:flutter_filament/rendering_surface.dart';
 import 'package:vector_math/vector_math_64.dart';
@@ -39,6 +43,18 @@ class FilamentControllerFFI extends FilamentController {
 
   final String? uberArchivePath;
 
+  ///
+  /// Directory for the on-disk shader program cache (OpenGL backends only).
+  /// If null, a default per-user cache directory is used on Linux/Windows and the cache is disabled on Android.
+  ///
+  final String? programCacheDirectory;
+
+  ///
+  /// Cached programs are discarded whenever the GPU driver (i.e. the OpenGL vendor, renderer or version) changes.
+  /// If given, this is an additional identifier whose change does the same.
+  ///
+  final String? programCacheDriverTag;
+
   Pointer<Void> _driver = nullptr.cast<Void>();
 
   @override
@@ -59,6 +75,19 @@ class FilamentControllerFFI extends FilamentController {
   final _lights = <FilamentEntity>{};
   final _entities = <FilamentEntity>{};
 
+  // the number of bones in each skeleton created with createSkeleton
+  final _skeletonBoneCounts = <int, int>{};
+
+  // the live pose stream of each entity, closed before the native stream is freed (when it or its entity is removed)
+  final _livePoseStreams = <FilamentEntity, _LivePoseStreamFFI>{};
+
+  void _closeLivePoseStreams() {
+    for (final stream in _livePoseStreams.values) {
+      stream._close();
+    }
+    _livePoseStreams.clear();
+  }
+
   final _onLoadController = StreamController<FilamentEntity>.broadcast();
   Stream<FilamentEntity> get onLoad => _onLoadController.stream;
 
@@ -69,7 +98,10 @@ class FilamentControllerFFI extends FilamentController {
   /// This controller uses platform channels to bridge Dart with the C/C++ code for the Filament API.
   /// Setting up the context/texture (since this is platform-specific) and the render ticker are platform-specific; all other methods are passed through by the platform channel to the methods specified in FlutterFilamentApi.h.
   ///
-  FilamentControllerFFI({this.uberArchivePath}) {
+  FilamentControllerFFI(
+      {this.uberArchivePath,
+      this.programCacheDirectory,
+      this.programCacheDriverTag}) {
     // on some platforms, we ignore the resize event raised by the Flutter RenderObserver
     // in favour of a window-level event passed via the method channel.
     // (this is because there is no apparent way to exactly synchronize resizing a Flutter widget and resizing a pixel buffer, so we need
@@ -150,6 +182,15 @@ class FilamentControllerFFI extends FilamentController {
 
     _viewer = null;
 
+    if (_tweenCallback != null) {
+      set_tween_callback(_assetManager!, nullptr);
+      _tweenCallback!.close();
+      _tweenCallback = null;
+      _tweenCompletions.clear();
+    }
+
+    _skeletonBoneCounts.clear();
+    _closeLivePoseStreams();
     _assetManager = null;
     destroy_filament_viewer_ffi(viewer!);
     hasViewer.value = false;
@@ -204,6 +245,17 @@ class FilamentControllerFFI extends FilamentController {
 
     dev.log("Got rendering surface");
 
+    if (programCacheDirectory != null) {
+      final directoryPtr = programCacheDirectory!.toNativeUtf8();
+      final driverTagPtr = programCacheDriverTag?.toNativeUtf8() ?? nullptr;
+      configure_program_cache(
+          directoryPtr.cast<Char>(), 0, driverTagPtr.cast<Char>());
+      calloc.free(directoryPtr);
+      if (driverTagPtr != nullptr) {
+        calloc.free(driverTagPtr);
+      }
+    }
+
     _viewer = create_filament_viewer_ffi(
         Pointer<Void>.fromAddress(renderingSurface.sharedContext),
         _driver,
@@ -433,6 +485,43 @@ class FilamentControllerFFI extends FilamentController {
     load_ibl_ffi(_viewer!, lightingPath.toNativeUtf8().cast<Char>(), intensity);
   }
 
+  @override
+  Future loadIblFromEquirect(String path,
+      {double intensity = 30000, String? cacheDirectory}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    final pathPtr = path.toNativeUtf8();
+    final cacheDirectoryPtr = cacheDirectory?.toNativeUtf8() ?? nullptr;
+    load_ibl_from_equirect_ffi(_viewer!, pathPtr.cast<Char>(), intensity,
+        cacheDirectoryPtr.cast<Char>());
+    calloc.free(pathPtr);
+    if (cacheDirectoryPtr != nullptr) {
+      calloc.free(cacheDirectoryPtr);
+    }
+  }
+
+  @override
+  Future loadEnvironment(
+      {String? skyboxPath,
+      String? iblPath,
+      double intensity = 30000,
+      Duration crossfade = Duration.zero}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    final skyboxPathPtr = skyboxPath?.toNativeUtf8() ?? nullptr;
+    final iblPathPtr = iblPath?.toNativeUtf8() ?? nullptr;
+    load_environment_ffi(_viewer!, skyboxPathPtr.cast<Char>(),
+        iblPathPtr.cast<Char>(), intensity, crossfade.inMicroseconds / 1e6);
+    if (skyboxPathPtr != nullptr) {
+      calloc.free(skyboxPathPtr);
+    }
+    if (iblPathPtr != nullptr) {
+      calloc.free(iblPathPtr);
+    }
+  }
+
   @override
   Future removeSkybox() async {
     if (_viewer == null) {
@@ -494,12 +583,59 @@ class FilamentControllerFFI extends FilamentController {
   }
 
   @override
-  Future<FilamentEntity> loadGlb(String path, {bool unlit = false}) async {
+  Future<DynamicMesh> createDynamicMesh(String materialPath,
+      {required int maxVertices,
+      required int maxIndices,
+      DynamicMeshPrimitiveType primitiveType =
+          DynamicMeshPrimitiveType.triangles,
+      bool normals = false,
+      bool uvs = false,
+      bool colors = false,
+      Map<DynamicMeshAttribute, int> customComponents = const {},
+      int numBuffers = 3}) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-    if (unlit) {
-      throw Exception("Not yet implemented");
+    final components = List<int>.filled(DynamicMeshAttribute.values.length, 0);
+    components[DynamicMeshAttribute.position.index] = 3;
+    components[DynamicMeshAttribute.normal.index] = normals ? 3 : 0;
+    components[DynamicMeshAttribute.uv.index] = uvs ? 2 : 0;
+    components[DynamicMeshAttribute.color.index] = colors ? 4 : 0;
+    for (final entry in customComponents.entries) {
+      if (entry.key.index < DynamicMeshAttribute.custom0.index) {
+        throw Exception("${entry.key} is not a custom attribute");
+      }
+      components[entry.key.index] = entry.value;
+    }
+    var materialPathPtr = materialPath.toNativeUtf8().cast<Char>();
+    var componentsPtr = calloc<Int>(components.length);
+    for (int i = 0; i < components.length; i++) {
+      componentsPtr.elementAt(i).value = components[i];
+    }
+    var mesh = create_dynamic_mesh_ffi(_viewer!, materialPathPtr,
+        primitiveType.value, componentsPtr, maxVertices, maxIndices, numBuffers);
+    calloc.free(materialPathPtr);
+    calloc.free(componentsPtr);
+    if (mesh == nullptr) {
+      throw Exception("Failed to create dynamic mesh, check logs for details");
+    }
+    return _DynamicMeshFFI(mesh, components, maxVertices, maxIndices);
+  }
+
+  @override
+  Future removeDynamicMesh(DynamicMesh mesh) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (!remove_dynamic_mesh_ffi(_viewer!, (mesh as _DynamicMeshFFI)._mesh)) {
+      throw Exception("Failed to remove dynamic mesh");
+    }
+  }
+
+  @override
+  Future<FilamentEntity> loadGlb(String path, {bool unlit = false}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
     }
     var entity =
         load_glb_ffi(_assetManager!, path.toNativeUtf8().cast<Char>(), unlit);
@@ -511,6 +647,20 @@ class FilamentControllerFFI extends FilamentController {
     return entity;
   }
 
+  @override
+  Future addMaterialSpecialization(String packagePath, int features) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    final packagePathPtr = packagePath.toNativeUtf8();
+    final result = add_material_specialization_ffi(
+        _assetManager!, packagePathPtr.cast<Char>(), features);
+    calloc.free(packagePathPtr);
+    if (!result) {
+      throw Exception("Failed to add material specialization $packagePath");
+    }
+  }
+
   @override
   Future<FilamentEntity> loadGltf(String path, String relativeResourcePath,
       {bool force = false}) async {
@@ -630,6 +780,22 @@ class FilamentControllerFFI extends FilamentController {
     return names;
   }
 
+  @override
+  Future<AssetMetadata> getAssetMetadata(FilamentEntity entity) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    var length = get_asset_metadata(_assetManager!, entity, nullptr, 0);
+    if (length == -1) {
+      throw Exception("Failed to get asset metadata, check logs for details");
+    }
+    var outPtr = calloc<Char>(length + 1);
+    get_asset_metadata(_assetManager!, entity, outPtr, length + 1);
+    var json = outPtr.cast<Utf8>().toDartString(length: length);
+    calloc.free(outPtr);
+    return AssetMetadata.fromJson(jsonDecode(json));
+  }
+
   @override
   Future<double> getAnimationDuration(
       FilamentEntity entity, int animationIndex) async {
@@ -654,35 +820,320 @@ class FilamentControllerFFI extends FilamentController {
       dataPtr.elementAt(i).value = animation.data[i];
     }
 
-    // the morph targets in [animation] might be a subset of those that actually exist in the mesh (and might not have the same order)
-    // we don't want to reorder the data (?? or do we? this is probably more efficient for the backend?)
-    // so let's get the actual list of morph targets from the mesh and pass the relevant indices to the native side.
-    var meshMorphTargets =
-        await getMorphTargetNames(entity, animation.meshName);
+    Pointer<Int> idxPtr;
+    try {
+      idxPtr = await _getMorphTargetIndices(
+          entity, animation.meshName, animation.morphTargets);
+    } catch (err) {
+      calloc.free(dataPtr);
+      rethrow;
+    }
+
+    set_morph_animation(
+        _assetManager!,
+        entity,
+        animation.meshName.toNativeUtf8().cast<Char>(),
+        dataPtr,
+        idxPtr,
+        animation.numMorphTargets,
+        animation.numFrames,
+        (animation.frameLengthInMs));
+    calloc.free(dataPtr);
+    calloc.free(idxPtr);
+  }
+
+  ///
+  /// The morph targets in an animation might be a subset of those that actually exist in the mesh (and might not have the same order)
+  /// so this gets the actual list of morph targets from the mesh and returns the index of each (allocated with calloc, to be freed by the caller).
+  ///
+  Future<Pointer<Int>> _getMorphTargetIndices(
+      FilamentEntity entity, String meshName, List<String> morphTargets) async {
+    var meshMorphTargets = await getMorphTargetNames(entity, meshName);
 
-    Pointer<Int> idxPtr = calloc<Int>(animation.morphTargets.length);
-    for (int i = 0; i < animation.numMorphTargets; i++) {
-      var index = meshMorphTargets.indexOf(animation.morphTargets[i]);
+    Pointer<Int> idxPtr = calloc<Int>(morphTargets.length);
+    for (int i = 0; i < morphTargets.length; i++) {
+      var index = meshMorphTargets.indexOf(morphTargets[i]);
       if (index == -1) {
-        calloc.free(dataPtr);
         calloc.free(idxPtr);
         throw Exception(
-            "Morph target ${animation.morphTargets[i]} is specified in the animation but could not be found in the mesh ${animation.meshName} under entity $entity");
+            "Morph target ${morphTargets[i]} is specified in the animation but could not be found in the mesh $meshName under entity $entity");
       }
       idxPtr.elementAt(i).value = index;
     }
+    return idxPtr;
+  }
 
-    set_morph_animation(
+  ///
+  /// Flattens [curves] into the arrays expected by set_morph_animation_curves/set_bone_animation_curves (allocated with calloc, to be freed by the caller).
+  ///
+  ({Pointer<Int> interpolations, Pointer<Int> keyCounts, Pointer<Float> keys})
+      _flattenCurves(List<AnimationCurve> curves) {
+    var interpolations = calloc<Int>(curves.length);
+    var keyCounts = calloc<Int>(curves.length);
+    var numKeys = curves.fold<int>(0, (sum, curve) => sum + curve.keys.length);
+    var keys = calloc<Float>(numKeys * 4);
+    int offset = 0;
+    for (int i = 0; i < curves.length; i++) {
+      interpolations.elementAt(i).value = curves[i].interpolation.index;
+      keyCounts.elementAt(i).value = curves[i].keys.length;
+      for (var key in curves[i].keys) {
+        keys.elementAt(offset++).value = key.time;
+        keys.elementAt(offset++).value = key.value;
+        keys.elementAt(offset++).value = key.inTangent;
+        keys.elementAt(offset++).value = key.outTangent;
+      }
+    }
+    return (interpolations: interpolations, keyCounts: keyCounts, keys: keys);
+  }
+
+  @override
+  Future setMorphCurveAnimation(
+      FilamentEntity entity, MorphCurveAnimationData animation) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    var morphTargets = animation.curves.keys.toList();
+    var idxPtr = await _getMorphTargetIndices(
+        entity, animation.meshName, morphTargets);
+    var curves = _flattenCurves(animation.curves.values.toList());
+    var meshNamePtr = animation.meshName.toNativeUtf8();
+    var result = set_morph_animation_curves(
         _assetManager!,
         entity,
-        animation.meshName.toNativeUtf8().cast<Char>(),
-        dataPtr,
+        meshNamePtr.cast<Char>(),
         idxPtr,
+        curves.interpolations,
+        curves.keyCounts,
+        curves.keys,
+        morphTargets.length);
+    calloc.free(meshNamePtr);
+    calloc.free(idxPtr);
+    calloc.free(curves.interpolations);
+    calloc.free(curves.keyCounts);
+    calloc.free(curves.keys);
+    if (!result) {
+      throw Exception(
+          "Failed to set morph curve animation for ${animation.meshName}");
+    }
+  }
+
+  @override
+  Future setBoneCurveAnimation(
+      FilamentEntity entity, BoneCurveAnimationData animation) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    var boneNames = animation.curves.keys.toList();
+    var channels = <int>[];
+    var curveList = <AnimationCurve>[];
+    for (int bone = 0; bone < boneNames.length; bone++) {
+      animation.curves[boneNames[bone]]!.forEach((channel, curve) {
+        channels.add(bone * BoneChannel.values.length + channel.index);
+        curveList.add(curve);
+      });
+    }
+
+    var boneNamesPtr = calloc<Pointer<Char>>(boneNames.length);
+    for (int i = 0; i < boneNames.length; i++) {
+      boneNamesPtr.elementAt(i).value = boneNames[i].toNativeUtf8().cast<Char>();
+    }
+    var meshNamesPtr = calloc<Pointer<Char>>(animation.meshNames.length);
+    for (int i = 0; i < animation.meshNames.length; i++) {
+      meshNamesPtr.elementAt(i).value =
+          animation.meshNames[i].toNativeUtf8().cast<Char>();
+    }
+    var channelsPtr = calloc<Int>(channels.length);
+    for (int i = 0; i < channels.length; i++) {
+      channelsPtr.elementAt(i).value = channels[i];
+    }
+    var curves = _flattenCurves(curveList);
+
+    var result = set_bone_animation_curves(
+        _assetManager!,
+        entity,
+        boneNamesPtr,
+        boneNames.length,
+        meshNamesPtr,
+        animation.meshNames.length,
+        channelsPtr,
+        curves.interpolations,
+        curves.keyCounts,
+        curves.keys,
+        curveList.length);
+
+    for (int i = 0; i < boneNames.length; i++) {
+      calloc.free(boneNamesPtr.elementAt(i).value);
+    }
+    for (int i = 0; i < animation.meshNames.length; i++) {
+      calloc.free(meshNamesPtr.elementAt(i).value);
+    }
+    calloc.free(boneNamesPtr);
+    calloc.free(meshNamesPtr);
+    calloc.free(channelsPtr);
+    calloc.free(curves.interpolations);
+    calloc.free(curves.keyCounts);
+    calloc.free(curves.keys);
+    if (!result) {
+      throw Exception("Failed to set bone curve animation");
+    }
+  }
+
+  @override
+  Future<int> createSkeleton(List<String> boneNames,
+      {Float32List? restPose}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (restPose != null &&
+        restPose.length != boneNames.length * BoneChannel.values.length) {
+      throw Exception(
+          "Rest pose must contain ${BoneChannel.values.length} values per bone");
+    }
+    var boneNamesPtr = calloc<Pointer<Char>>(boneNames.length);
+    for (int i = 0; i < boneNames.length; i++) {
+      boneNamesPtr.elementAt(i).value = boneNames[i].toNativeUtf8().cast<Char>();
+    }
+    Pointer<Float> restPosePtr = nullptr;
+    if (restPose != null) {
+      restPosePtr = calloc<Float>(restPose.length);
+      restPosePtr.asTypedList(restPose.length).setAll(0, restPose);
+    }
+    var skeleton = create_skeleton(
+        _assetManager!, boneNamesPtr, boneNames.length, restPosePtr);
+    for (int i = 0; i < boneNames.length; i++) {
+      calloc.free(boneNamesPtr.elementAt(i).value);
+    }
+    calloc.free(boneNamesPtr);
+    if (restPosePtr != nullptr) {
+      calloc.free(restPosePtr);
+    }
+    if (skeleton == -1) {
+      throw Exception("Failed to create skeleton, check logs for details");
+    }
+    _skeletonBoneCounts[skeleton] = boneNames.length;
+    return skeleton;
+  }
+
+  @override
+  Future removeSkeleton(int skeleton) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    _skeletonBoneCounts.remove(skeleton);
+    if (!remove_skeleton(_assetManager!, skeleton)) {
+      throw Exception("Failed to remove skeleton");
+    }
+  }
+
+  @override
+  Future<int> createBoneAnimationClip(
+      int skeleton, Float32List frameData, double frameLengthInMs) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    var numBones = _skeletonBoneCounts[skeleton];
+    if (numBones == null) {
+      throw Exception("Skeleton $skeleton not found");
+    }
+    var frameSize = numBones * BoneChannel.values.length;
+    if (frameData.isEmpty || frameData.length % frameSize != 0) {
+      throw Exception(
+          "Frame data must contain $frameSize values (${BoneChannel.values.length} per bone) per frame");
+    }
+    var frameDataPtr = calloc<Float>(frameData.length);
+    frameDataPtr.asTypedList(frameData.length).setAll(0, frameData);
+    var clip = create_bone_animation_clip(_assetManager!, skeleton,
+        frameDataPtr, frameData.length ~/ frameSize, frameLengthInMs);
+    calloc.free(frameDataPtr);
+    if (clip == -1) {
+      throw Exception(
+          "Failed to create bone animation clip, check logs for details");
+    }
+    return clip;
+  }
+
+  @override
+  Future removeBoneAnimationClip(int clip) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (!remove_bone_animation_clip(_assetManager!, clip)) {
+      throw Exception("Failed to remove bone animation clip");
+    }
+  }
+
+  @override
+  Future setBoneAnimationClip(FilamentEntity entity, int clip) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (!set_bone_animation_clip(_assetManager!, entity, clip)) {
+      throw Exception(
+          "Failed to set bone animation clip, check logs for details");
+    }
+  }
+
+  @override
+  Future setAnimationCompression(bool enabled, {double maxError = 0.0}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    set_animation_compression(_assetManager!, enabled, maxError);
+  }
+
+  @override
+  Future<Uint8List> compressMorphAnimation(MorphAnimationData animation,
+      {double maxError = 0.0}) async {
+    var dataPtr = calloc<Float>(animation.data.length);
+    for (int i = 0; i < animation.data.length; i++) {
+      dataPtr.elementAt(i).value = animation.data[i];
+    }
+    var size = compress_morph_animation(
+        dataPtr,
         animation.numMorphTargets,
         animation.numFrames,
-        (animation.frameLengthInMs));
+        animation.frameLengthInMs,
+        maxError,
+        nullptr,
+        0);
+    if (size == 0) {
+      calloc.free(dataPtr);
+      throw Exception("Failed to compress morph animation");
+    }
+    var outPtr = calloc<Uint8>(size);
+    compress_morph_animation(dataPtr, animation.numMorphTargets,
+        animation.numFrames, animation.frameLengthInMs, maxError, outPtr, size);
+    var blob = Uint8List.fromList(outPtr.asTypedList(size));
+    calloc.free(dataPtr);
+    calloc.free(outPtr);
+    return blob;
+  }
+
+  @override
+  Future setCompressedMorphAnimationData(FilamentEntity entity,
+      String meshName, List<String> morphTargets, Uint8List data) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    var idxPtr =
+        await _getMorphTargetIndices(entity, meshName, morphTargets);
+    var dataPtr = calloc<Uint8>(data.length);
+    dataPtr.asTypedList(data.length).setAll(0, data);
+    var meshNamePtr = meshName.toNativeUtf8();
+    var result = set_morph_animation_compressed(
+        _assetManager!,
+        entity,
+        meshNamePtr.cast<Char>(),
+        dataPtr.cast<Void>(),
+        data.length,
+        idxPtr,
+        morphTargets.length);
+    calloc.free(meshNamePtr);
     calloc.free(dataPtr);
     calloc.free(idxPtr);
+    if (!result) {
+      throw Exception("Failed to set compressed morph animation for $meshName");
+    }
   }
 
   @override
@@ -729,6 +1180,7 @@ class FilamentControllerFFI extends FilamentController {
       throw Exception("No viewer available, ignoring");
     }
     _entities.remove(entity);
+    _livePoseStreams.remove(entity)?._close();
     remove_asset_ffi(_viewer!, entity);
     _onUnloadController.add(entity);
   }
@@ -738,6 +1190,7 @@ class FilamentControllerFFI extends FilamentController {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
+    _closeLivePoseStreams();
     clear_assets_ffi(_viewer!);
 
     for (final entity in _entities) {
@@ -775,21 +1228,35 @@ class FilamentControllerFFI extends FilamentController {
       {bool loop = false,
       bool reverse = false,
       bool replaceActive = true,
-      double crossfade = 0.0}) async {
+      double crossfade = 0.0,
+      double startOffset = 0.0}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    play_animation_ffi(_assetManager!, entity, index, loop, reverse,
+        replaceActive, crossfade, startOffset);
+  }
+
+  @override
+  Future seekAnimation(FilamentEntity entity, int index, double seconds) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-    play_animation_ffi(
-        _assetManager!, entity, index, loop, reverse, replaceActive, crossfade);
+    if (!seek_animation(_assetManager!, entity, index, seconds)) {
+      throw Exception("Failed to seek animation $index");
+    }
   }
 
   @override
-  Future setAnimationFrame(
-      FilamentEntity entity, int index, int animationFrame) async {
+  Future setAnimationFrame(FilamentEntity entity, int index, int animationFrame,
+      {double framesPerSecond = 60.0}) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-    set_animation_frame(_assetManager!, entity, index, animationFrame);
+    if (!set_animation_frame(
+        _assetManager!, entity, index, animationFrame, framesPerSecond)) {
+      throw Exception("Failed to set frame for animation $index");
+    }
   }
 
   @override
@@ -801,121 +1268,574 @@ class FilamentControllerFFI extends FilamentController {
   }
 
   @override
-  Future setCamera(FilamentEntity entity, String? name) async {
+  Future setAnimationTimeScale(double timeScale,
+      {FilamentEntity? entity}) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-    var result = set_camera(
-        _viewer!, entity, name?.toNativeUtf8().cast<Char>() ?? nullptr);
-    if (!result) {
-      throw Exception("Failed to set camera");
+    if (entity == null) {
+      set_animation_time_scale(_assetManager!, timeScale);
+    } else if (!set_asset_animation_time_scale(
+        _assetManager!, entity, timeScale)) {
+      throw Exception("Failed to set animation time scale for entity $entity");
     }
   }
 
   @override
-  Future setToneMapping(ToneMapper mapper) async {
+  Future setAnimationsPaused(bool paused, {FilamentEntity? entity}) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-
-    set_tone_mapping_ffi(_viewer!, mapper.index);
+    if (entity == null) {
+      set_animations_paused(_assetManager!, paused);
+    } else if (!set_asset_animations_paused(_assetManager!, entity, paused)) {
+      throw Exception("Failed to pause animations for entity $entity");
+    }
   }
 
   @override
-  Future setPostProcessing(bool enabled) async {
+  Future setFixedAnimationTimestep(Duration? timestep) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
+    set_fixed_animation_timestep(
+        _assetManager!, (timestep?.inMicroseconds ?? 0) / 1e6);
+  }
 
-    set_post_processing_ffi(_viewer!, enabled);
+  @override
+  Future setAnimationLod(bool enabled,
+      {double halfRateScreenSize = 0.1,
+      double quarterRateScreenSize = 0.03}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    set_animation_lod(
+        _assetManager!, enabled, halfRateScreenSize, quarterRateScreenSize);
   }
 
   @override
-  Future setBloom(double bloom) async {
+  Future setAnimationBaking(bool enabled, {double sampleRate = 30.0}) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-    set_bloom_ffi(_viewer!, bloom);
+    set_animation_baking(_assetManager!, enabled, sampleRate);
   }
 
   @override
-  Future setCameraFocalLength(double focalLength) async {
+  Future<int> addAnimationLayer(FilamentEntity entity, int index,
+      {double weight = 1.0, bool additive = false, bool loop = true}) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-    set_camera_focal_length(_viewer!, focalLength);
+    var layer = add_animation_layer(
+        _assetManager!, entity, index, weight, additive, loop);
+    if (layer == -1) {
+      throw Exception("Failed to add animation layer, check logs for details");
+    }
+    return layer;
   }
 
   @override
-  Future setCameraFocusDistance(double focusDistance) async {
+  Future removeAnimationLayer(FilamentEntity entity, int layer) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-    set_camera_focus_distance(_viewer!, focusDistance);
+    if (!remove_animation_layer(_assetManager!, entity, layer)) {
+      throw Exception("Failed to remove animation layer $layer");
+    }
   }
 
   @override
-  Future setCameraPosition(double x, double y, double z) async {
+  Future setAnimationLayerWeight(
+      FilamentEntity entity, int layer, double weight) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-    set_camera_position(_viewer!, x, y, z);
+    if (!set_animation_layer_weight(_assetManager!, entity, layer, weight)) {
+      throw Exception("Failed to set weight for animation layer $layer");
+    }
   }
 
   @override
-  Future moveCameraToAsset(FilamentEntity entity) async {
+  Future setAnimationLayerTime(
+      FilamentEntity entity, int layer, double seconds) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-    move_camera_to_asset(_viewer!, entity);
+    if (!set_animation_layer_time(_assetManager!, entity, layer, seconds)) {
+      throw Exception("Failed to set time for animation layer $layer");
+    }
   }
 
   @override
-  Future setViewFrustumCulling(bool enabled) async {
+  Future setAnimationLayerSpeed(
+      FilamentEntity entity, int layer, double speed) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-    set_view_frustum_culling(_viewer!, enabled);
+    if (!set_animation_layer_speed(_assetManager!, entity, layer, speed)) {
+      throw Exception("Failed to set speed for animation layer $layer");
+    }
   }
 
   @override
-  Future setCameraExposure(
-      double aperture, double shutterSpeed, double sensitivity) async {
+  Future setAnimationLayerMask(
+      FilamentEntity entity, int layer, Map<String, double> joints,
+      {bool includeDescendants = true}) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-    set_camera_exposure(_viewer!, aperture, shutterSpeed, sensitivity);
+    var names = joints.keys.toList();
+    var namesPtr = calloc<Pointer<Char>>(names.length);
+    var weightsPtr = calloc<Float>(names.length);
+    for (int i = 0; i < names.length; i++) {
+      namesPtr.elementAt(i).value = names[i].toNativeUtf8().cast<Char>();
+      weightsPtr.elementAt(i).value = joints[names[i]]!;
+    }
+    var result = set_animation_layer_mask(_assetManager!, entity, layer,
+        namesPtr, weightsPtr, names.length, includeDescendants);
+    for (int i = 0; i < names.length; i++) {
+      calloc.free(namesPtr.elementAt(i).value);
+    }
+    calloc.free(namesPtr);
+    calloc.free(weightsPtr);
+    if (!result) {
+      throw Exception("Failed to set mask for animation layer $layer");
+    }
   }
 
   @override
-  Future setCameraRotation(double rads, double x, double y, double z) async {
+  Future<int> addAnimationStateParameter(FilamentEntity entity, String name,
+      {double value = 0.0}) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-    set_camera_rotation(_viewer!, rads, x, y, z);
+    var namePtr = name.toNativeUtf8().cast<Char>();
+    var parameter =
+        add_animation_state_parameter(_assetManager!, entity, namePtr, value);
+    calloc.free(namePtr);
+    if (parameter == -1) {
+      throw Exception(
+          "Failed to add animation state parameter, check logs for details");
+    }
+    return parameter;
   }
 
   @override
-  Future setCameraModelMatrix(List<double> matrix) async {
+  Future<int> addAnimationState(
+      FilamentEntity entity, String name, List<int> indices,
+      {List<double>? thresholds,
+      int blendParameter = -1,
+      double speed = 1.0,
+      bool loop = true}) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-    assert(matrix.length == 16);
-    var ptr = calloc<Float>(16);
-    for (int i = 0; i < 16; i++) {
-      ptr.elementAt(i).value = matrix[i];
+    if (thresholds != null && thresholds.length != indices.length) {
+      throw Exception("Expected one threshold per animation");
     }
-    set_camera_model_matrix(_viewer!, ptr);
-    calloc.free(ptr);
+    var namePtr = name.toNativeUtf8().cast<Char>();
+    var indicesPtr = calloc<Int>(indices.length);
+    var thresholdsPtr = calloc<Float>(indices.length);
+    for (int i = 0; i < indices.length; i++) {
+      indicesPtr.elementAt(i).value = indices[i];
+      thresholdsPtr.elementAt(i).value = thresholds?[i] ?? 0.0;
+    }
+    var state = add_animation_state(_assetManager!, entity, namePtr,
+        indicesPtr, thresholdsPtr, indices.length, blendParameter, speed, loop);
+    calloc.free(namePtr);
+    calloc.free(indicesPtr);
+    calloc.free(thresholdsPtr);
+    if (state == -1) {
+      throw Exception("Failed to add animation state, check logs for details");
+    }
+    return state;
   }
 
   @override
-  Future setMaterialColor(FilamentEntity entity, String meshName,
-      int materialIndex, Color color) async {
+  Future<int> addAnimationStateTransition(FilamentEntity entity, int? from,
+      int to, List<TransitionCondition> conditions,
+      {double crossfade = 0.25, double? exitTime}) async {
     if (_viewer == null) {
       throw Exception("No viewer available, ignoring");
     }
-    var result = set_material_color(
+    var parametersPtr = calloc<Int>(conditions.length);
+    var opsPtr = calloc<Int>(conditions.length);
+    var valuesPtr = calloc<Float>(conditions.length);
+    for (int i = 0; i < conditions.length; i++) {
+      parametersPtr.elementAt(i).value = conditions[i].parameter;
+      opsPtr.elementAt(i).value = conditions[i].op.index;
+      valuesPtr.elementAt(i).value = conditions[i].value;
+    }
+    var transition = add_animation_state_transition(
+        _assetManager!,
+        entity,
+        from ?? -1,
+        to,
+        crossfade,
+        exitTime ?? -1.0,
+        parametersPtr,
+        opsPtr,
+        valuesPtr,
+        conditions.length);
+    calloc.free(parametersPtr);
+    calloc.free(opsPtr);
+    calloc.free(valuesPtr);
+    if (transition == -1) {
+      throw Exception(
+          "Failed to add animation state transition, check logs for details");
+    }
+    return transition;
+  }
+
+  @override
+  Future setAnimationStateParameter(
+      FilamentEntity entity, int parameter, double value) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (!set_animation_state_parameter(
+        _assetManager!, entity, parameter, value)) {
+      throw Exception(
+          "Failed to set animation state parameter $parameter, check logs for details");
+    }
+  }
+
+  @override
+  Future setAnimationState(FilamentEntity entity, int state,
+      {double crossfade = 0.0}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (!set_animation_state(_assetManager!, entity, state, crossfade)) {
+      throw Exception(
+          "Failed to set animation state $state, check logs for details");
+    }
+  }
+
+  @override
+  Future<int> getAnimationState(FilamentEntity entity) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    return get_animation_state(_assetManager!, entity);
+  }
+
+  @override
+  Future removeAnimationStateMachine(FilamentEntity entity) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (!remove_animation_state_machine(_assetManager!, entity)) {
+      throw Exception(
+          "Failed to remove animation state machine, check logs for details");
+    }
+  }
+
+  @override
+  Future<({int updated, int skipped})> getSkinUpdateStats(
+      {bool reset = false}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    final updatedPtr = calloc<Uint64>();
+    final skippedPtr = calloc<Uint64>();
+    get_skin_update_stats(_assetManager!, updatedPtr, skippedPtr, reset);
+    final stats = (updated: updatedPtr.value, skipped: skippedPtr.value);
+    calloc.free(updatedPtr);
+    calloc.free(skippedPtr);
+    return stats;
+  }
+
+  @override
+  Future<LivePoseStream> createLivePoseStream(FilamentEntity entity,
+      {String? meshName, List<String> boneNames = const []}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    var meshNamePtr = meshName?.toNativeUtf8().cast<Char>() ?? nullptr;
+    var boneNamesPtr = calloc<Pointer<Char>>(boneNames.length);
+    for (int i = 0; i < boneNames.length; i++) {
+      boneNamesPtr.elementAt(i).value = boneNames[i].toNativeUtf8().cast<Char>();
+    }
+    var stream = create_live_pose_stream(
+        _assetManager!, entity, meshNamePtr, boneNamesPtr, boneNames.length);
+    for (int i = 0; i < boneNames.length; i++) {
+      calloc.free(boneNamesPtr.elementAt(i).value);
+    }
+    calloc.free(boneNamesPtr);
+    if (meshNamePtr != nullptr) {
+      calloc.free(meshNamePtr);
+    }
+    if (stream == nullptr) {
+      throw Exception(
+          "Failed to create live pose stream, check logs for details");
+    }
+    return _livePoseStreams[entity] = _LivePoseStreamFFI(stream);
+  }
+
+  @override
+  Future removeLivePoseStream(FilamentEntity entity) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    _livePoseStreams.remove(entity)?._close();
+    if (!remove_live_pose_stream(_assetManager!, entity)) {
+      throw Exception("Failed to remove live pose stream");
+    }
+  }
+
+  @override
+  Future<FilamentEntity> getJointHandle(
+      FilamentEntity entity, String jointName) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    var jointNamePtr = jointName.toNativeUtf8();
+    var joint =
+        get_joint_handle(_assetManager!, entity, jointNamePtr.cast<Char>());
+    calloc.free(jointNamePtr);
+    if (joint == 0) {
+      throw Exception("Failed to find joint $jointName");
+    }
+    return joint;
+  }
+
+  @override
+  Future<int> addTwoBoneIkConstraint(FilamentEntity entity,
+      FilamentEntity upperJoint, FilamentEntity lowerJoint, FilamentEntity endJoint,
+      {double weight = 1.0}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    var constraint = add_two_bone_ik_constraint(
+        _assetManager!, entity, upperJoint, lowerJoint, endJoint, weight);
+    if (constraint == -1) {
+      throw Exception("Failed to add IK constraint, check logs for details");
+    }
+    return constraint;
+  }
+
+  @override
+  Future<int> addChainIkConstraint(
+      FilamentEntity entity, List<FilamentEntity> joints,
+      {bool fabrik = false, int iterations = 10, double weight = 1.0}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    var jointsPtr = calloc<Int32>(joints.length);
+    for (int i = 0; i < joints.length; i++) {
+      jointsPtr.elementAt(i).value = joints[i];
+    }
+    var constraint = add_chain_ik_constraint(_assetManager!, entity, jointsPtr,
+        joints.length, fabrik, iterations, weight);
+    calloc.free(jointsPtr);
+    if (constraint == -1) {
+      throw Exception("Failed to add IK constraint, check logs for details");
+    }
+    return constraint;
+  }
+
+  @override
+  Future<int> addLookAtConstraint(FilamentEntity entity, FilamentEntity joint,
+      {Vector3? forward, double? maxAngle, double weight = 1.0}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    forward ??= Vector3(0, 0, 1);
+    var constraint = add_look_at_constraint(_assetManager!, entity, joint,
+        forward.x, forward.y, forward.z, maxAngle ?? double.infinity, weight);
+    if (constraint == -1) {
+      throw Exception(
+          "Failed to add look-at constraint, check logs for details");
+    }
+    return constraint;
+  }
+
+  @override
+  Future setConstraintTarget(
+      FilamentEntity entity, int constraint, Vector3 target) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (!set_constraint_target(
+        _assetManager!, entity, constraint, target.x, target.y, target.z)) {
+      throw Exception("Failed to set constraint target");
+    }
+  }
+
+  @override
+  Future setConstraintTargetEntity(
+      FilamentEntity entity, int constraint, FilamentEntity target) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (!set_constraint_target_entity(
+        _assetManager!, entity, constraint, target)) {
+      throw Exception("Failed to set constraint target");
+    }
+  }
+
+  @override
+  Future setConstraintPole(
+      FilamentEntity entity, int constraint, Vector3 pole) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (!set_constraint_pole(
+        _assetManager!, entity, constraint, pole.x, pole.y, pole.z)) {
+      throw Exception("Failed to set constraint pole");
+    }
+  }
+
+  @override
+  Future setConstraintWeight(
+      FilamentEntity entity, int constraint, double weight) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (!set_constraint_weight(_assetManager!, entity, constraint, weight)) {
+      throw Exception("Failed to set constraint weight");
+    }
+  }
+
+  @override
+  Future removeConstraint(FilamentEntity entity, int constraint) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (!remove_constraint(_assetManager!, entity, constraint)) {
+      throw Exception("Failed to remove constraint");
+    }
+  }
+
+  @override
+  Future setCamera(FilamentEntity entity, String? name) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    var result = set_camera(
+        _viewer!, entity, name?.toNativeUtf8().cast<Char>() ?? nullptr);
+    if (!result) {
+      throw Exception("Failed to set camera");
+    }
+  }
+
+  @override
+  Future setToneMapping(ToneMapper mapper) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+
+    set_tone_mapping_ffi(_viewer!, mapper.index);
+  }
+
+  @override
+  Future setPostProcessing(bool enabled) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+
+    set_post_processing_ffi(_viewer!, enabled);
+  }
+
+  @override
+  Future setBloom(double bloom) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    set_bloom_ffi(_viewer!, bloom);
+  }
+
+  @override
+  Future setCameraFocalLength(double focalLength) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    set_camera_focal_length(_viewer!, focalLength);
+  }
+
+  @override
+  Future setCameraFocusDistance(double focusDistance) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    set_camera_focus_distance(_viewer!, focusDistance);
+  }
+
+  @override
+  Future setCameraPosition(double x, double y, double z) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    set_camera_position(_viewer!, x, y, z);
+  }
+
+  @override
+  Future moveCameraToAsset(FilamentEntity entity) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    move_camera_to_asset(_viewer!, entity);
+  }
+
+  @override
+  Future setViewFrustumCulling(bool enabled) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    set_view_frustum_culling(_viewer!, enabled);
+  }
+
+  @override
+  Future setAnimatedBounds(FilamentEntity entity, AnimatedBoundsMode mode,
+      {double padding = 0.0}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (!set_animated_bounds(_assetManager!, entity, mode.index, padding)) {
+      throw Exception("Failed to set animated bounds, check logs for details");
+    }
+  }
+
+  @override
+  Future setCameraExposure(
+      double aperture, double shutterSpeed, double sensitivity) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    set_camera_exposure(_viewer!, aperture, shutterSpeed, sensitivity);
+  }
+
+  @override
+  Future setCameraRotation(double rads, double x, double y, double z) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    set_camera_rotation(_viewer!, rads, x, y, z);
+  }
+
+  @override
+  Future setCameraModelMatrix(List<double> matrix) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    assert(matrix.length == 16);
+    var ptr = calloc<Float>(16);
+    for (int i = 0; i < 16; i++) {
+      ptr.elementAt(i).value = matrix[i];
+    }
+    set_camera_model_matrix(_viewer!, ptr);
+    calloc.free(ptr);
+  }
+
+  @override
+  Future setMaterialColor(FilamentEntity entity, String meshName,
+      int materialIndex, Color color) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    var result = set_material_color(
         _assetManager!,
         entity,
         meshName.toNativeUtf8().cast<Char>(),
@@ -929,6 +1849,165 @@ class FilamentControllerFFI extends FilamentController {
     }
   }
 
+  NativeCallable<Void Function(Int32, Bool)>? _tweenCallback;
+  final _tweenCompletions = <int, void Function(bool finished)>{};
+
+  // [start] is passed [from] and [to] in native memory and returns the tween ID (or -1)
+  int _startTween(List<double> from, List<double> to,
+      int Function(Pointer<Float> from, Pointer<Float> to) start,
+      void Function(bool finished)? onComplete) {
+    if (_tweenCallback == null) {
+      // completions are posted from the render thread to this isolate
+      _tweenCallback = NativeCallable<Void Function(Int32, Bool)>.listener(
+          (int tween, bool finished) {
+        _tweenCompletions.remove(tween)?.call(finished);
+      });
+      set_tween_callback(_assetManager!, _tweenCallback!.nativeFunction);
+    }
+    final fromPtr = calloc<Float>(4);
+    final toPtr = calloc<Float>(4);
+    for (int i = 0; i < from.length; i++) {
+      fromPtr.elementAt(i).value = from[i];
+      toPtr.elementAt(i).value = to[i];
+    }
+    final tween = start(fromPtr, toPtr);
+    calloc.free(fromPtr);
+    calloc.free(toPtr);
+    if (tween == -1) {
+      throw Exception("Failed to start tween, check logs for details");
+    }
+    // the completion can't be delivered before this runs, as the listener callback is queued on this isolate
+    if (onComplete != null) {
+      _tweenCompletions[tween] = onComplete;
+    }
+    return tween;
+  }
+
+  double _seconds(Duration duration) => duration.inMicroseconds / 1e6;
+
+  @override
+  Future<int> tweenPosition(
+      FilamentEntity entity, Vector3 from, Vector3 to, Duration duration,
+      {TweenEasing easing = TweenEasing.linear,
+      void Function(bool finished)? onComplete}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    return _startTween(
+        [from.x, from.y, from.z],
+        [to.x, to.y, to.z],
+        (fromPtr, toPtr) => tween_property(_assetManager!, entity, 0, fromPtr,
+            toPtr, _seconds(duration), easing.index),
+        onComplete);
+  }
+
+  @override
+  Future<int> tweenRotation(
+      FilamentEntity entity, Quaternion from, Quaternion to, Duration duration,
+      {TweenEasing easing = TweenEasing.linear,
+      void Function(bool finished)? onComplete}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    return _startTween(
+        [from.x, from.y, from.z, from.w],
+        [to.x, to.y, to.z, to.w],
+        (fromPtr, toPtr) => tween_property(_assetManager!, entity, 1, fromPtr,
+            toPtr, _seconds(duration), easing.index),
+        onComplete);
+  }
+
+  @override
+  Future<int> tweenScale(
+      FilamentEntity entity, double from, double to, Duration duration,
+      {TweenEasing easing = TweenEasing.linear,
+      void Function(bool finished)? onComplete}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    return _startTween(
+        [from],
+        [to],
+        (fromPtr, toPtr) => tween_property(_assetManager!, entity, 2, fromPtr,
+            toPtr, _seconds(duration), easing.index),
+        onComplete);
+  }
+
+  @override
+  Future<int> tweenMaterialColor(FilamentEntity entity, String meshName,
+      int materialIndex, Color from, Color to, Duration duration,
+      {TweenEasing easing = TweenEasing.linear,
+      void Function(bool finished)? onComplete}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    final meshNamePtr = meshName.toNativeUtf8();
+    try {
+      return _startTween(
+          [
+            from.red / 255.0,
+            from.green / 255.0,
+            from.blue / 255.0,
+            from.alpha / 255.0
+          ],
+          [to.red / 255.0, to.green / 255.0, to.blue / 255.0, to.alpha / 255.0],
+          (fromPtr, toPtr) => tween_material_color(
+              _assetManager!,
+              entity,
+              meshNamePtr.cast<Char>(),
+              materialIndex,
+              fromPtr,
+              toPtr,
+              _seconds(duration),
+              easing.index),
+          onComplete);
+    } finally {
+      calloc.free(meshNamePtr);
+    }
+  }
+
+  @override
+  Future<int> tweenLightIntensity(
+      FilamentEntity light, double from, double to, Duration duration,
+      {TweenEasing easing = TweenEasing.linear,
+      void Function(bool finished)? onComplete}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    return _startTween(
+        [from],
+        [to],
+        (fromPtr, toPtr) => tween_property(_assetManager!, light, 4, fromPtr,
+            toPtr, _seconds(duration), easing.index),
+        onComplete);
+  }
+
+  @override
+  Future<int> tweenCameraExposure(
+      ({double aperture, double shutterSpeed, double sensitivity}) from,
+      ({double aperture, double shutterSpeed, double sensitivity}) to,
+      Duration duration,
+      {TweenEasing easing = TweenEasing.linear,
+      void Function(bool finished)? onComplete}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    return _startTween(
+        [from.aperture, from.shutterSpeed, from.sensitivity],
+        [to.aperture, to.shutterSpeed, to.sensitivity],
+        (fromPtr, toPtr) => tween_camera_exposure(
+            _viewer!, fromPtr, toPtr, _seconds(duration), easing.index),
+        onComplete);
+  }
+
+  @override
+  Future<bool> cancelTween(int tween) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    return cancel_tween(_assetManager!, tween);
+  }
+
   @override
   Future transformToUnitCube(FilamentEntity entity) async {
     if (_viewer == null) {
@@ -985,6 +2064,61 @@ class FilamentControllerFFI extends FilamentController {
     }
   }
 
+  @override
+  Future<FilamentEntity> createInstancedMesh(
+      FilamentEntity entity, String meshName, Float32List transforms,
+      {int primitiveIndex = -1}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (transforms.isEmpty || transforms.length % 16 != 0) {
+      throw Exception("Transforms must contain 16 values per instance");
+    }
+    var meshNamePtr = meshName.toNativeUtf8().cast<Char>();
+    var transformsPtr = calloc<Float>(transforms.length);
+    transformsPtr.asTypedList(transforms.length).setAll(0, transforms);
+    var instancedMesh = create_instanced_mesh_ffi(_assetManager!, entity,
+        meshNamePtr, primitiveIndex, transformsPtr, transforms.length ~/ 16);
+    calloc.free(meshNamePtr);
+    calloc.free(transformsPtr);
+    if (instancedMesh == _FILAMENT_ASSET_ERROR) {
+      throw Exception(
+          "Failed to create instanced mesh $meshName, check logs for details");
+    }
+    return instancedMesh;
+  }
+
+  @override
+  Future setInstanceTransforms(
+      FilamentEntity instancedMesh, Float32List transforms,
+      {int offset = 0}) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (transforms.isEmpty || transforms.length % 16 != 0) {
+      throw Exception("Transforms must contain 16 values per instance");
+    }
+    var transformsPtr = calloc<Float>(transforms.length);
+    transformsPtr.asTypedList(transforms.length).setAll(0, transforms);
+    var result = set_instance_transforms_ffi(_assetManager!, instancedMesh,
+        transformsPtr, offset, transforms.length ~/ 16);
+    calloc.free(transformsPtr);
+    if (!result) {
+      throw Exception(
+          "Failed to set instance transforms, check logs for details");
+    }
+  }
+
+  @override
+  Future removeInstancedMesh(FilamentEntity instancedMesh) async {
+    if (_viewer == null) {
+      throw Exception("No viewer available, ignoring");
+    }
+    if (!remove_instanced_mesh_ffi(_assetManager!, instancedMesh)) {
+      throw Exception("Failed to remove instanced mesh");
+    }
+  }
+
   @override
   String? getNameForEntity(FilamentEntity entity) {
     final result = get_name_for_entity(_assetManager!, entity);
@@ -1119,3 +2253,108 @@ class FilamentControllerFFI extends FilamentController {
     return Frustum.matrix(projectionMatrix);
   }
 }
+
+class _LivePoseStreamFFI extends LivePoseStream {
+  final Pointer<Void> _stream;
+  @override
+  late final int numMorphWeights;
+  @override
+  late final int numBones;
+  // views onto each slot, created once so publishing never allocates
+  final _morphWeights = <Float32List>[];
+  final _bonePoses = <Float32List>[];
+  int _writeSlot;
+  // set once the native stream has been (or is about to be) freed
+  bool _closed = false;
+
+  _LivePoseStreamFFI(this._stream)
+      : _writeSlot = get_live_pose_stream_write_slot(_stream) {
+    final numMorphWeightsPtr = calloc<Int>();
+    final numBonesPtr = calloc<Int>();
+    get_live_pose_stream_layout(_stream, numMorphWeightsPtr, numBonesPtr);
+    numMorphWeights = numMorphWeightsPtr.value;
+    numBones = numBonesPtr.value;
+    calloc.free(numMorphWeightsPtr);
+    calloc.free(numBonesPtr);
+    for (int slot = 0; slot < 3; slot++) {
+      final ptr = get_live_pose_stream_slot(_stream, slot);
+      _morphWeights.add(ptr.asTypedList(numMorphWeights));
+      _bonePoses.add(ptr
+          .elementAt(numMorphWeights)
+          .asTypedList(numBones * BoneChannel.values.length));
+    }
+  }
+
+  void _close() {
+    _closed = true;
+    _morphWeights.clear();
+    _bonePoses.clear();
+  }
+
+  void _checkOpen() {
+    if (_closed) {
+      throw Exception("Live pose stream has been removed");
+    }
+  }
+
+  @override
+  Float32List get morphWeights {
+    _checkOpen();
+    return _morphWeights[_writeSlot];
+  }
+
+  @override
+  Float32List get bonePose {
+    _checkOpen();
+    return _bonePoses[_writeSlot];
+  }
+
+  @override
+  void publish() {
+    _checkOpen();
+    _writeSlot = publish_live_pose(_stream);
+  }
+}
+
+class _DynamicMeshFFI extends DynamicMesh {
+  final Pointer<Void> _mesh;
+  @override
+  late final FilamentEntity entity;
+  @override
+  final int maxVertices;
+  @override
+  final int maxIndices;
+  // views onto each slot, created once so publishing never allocates
+  final _attributes = <List<Float32List?>>[];
+  final _indices = <Uint32List>[];
+  int _writeSlot;
+
+  _DynamicMeshFFI(
+      this._mesh, List<int> components, this.maxVertices, this.maxIndices)
+      : _writeSlot = get_dynamic_mesh_write_slot(_mesh) {
+    entity = get_dynamic_mesh_entity(_mesh);
+    for (int slot = 0; slot < 3; slot++) {
+      _attributes.add([
+        for (final attribute in DynamicMeshAttribute.values)
+          components[attribute.index] == 0
+              ? null
+              : get_dynamic_mesh_attribute(_mesh, slot, attribute.index)
+                  .asTypedList(maxVertices * components[attribute.index])
+      ]);
+      _indices
+          .add(get_dynamic_mesh_indices(_mesh, slot).asTypedList(maxIndices));
+    }
+  }
+
+  @override
+  Float32List? attribute(DynamicMeshAttribute attribute) =>
+      _attributes[_writeSlot][attribute.index];
+
+  @override
+  Uint32List get indices => _indices[_writeSlot];
+
+  @override
+  void publish(int numVertices, int numIndices) {
+    _writeSlot = publish_dynamic_mesh(_mesh, numVertices, numIndices);
+  }
+}
@@ -4,6 +4,16 @@
 // ignore_for_file: type=lint
 import 'dart:ffi' as ffi;
 
+@ffi.Native<
+        ffi.Void Function(
+            ffi.Pointer<ffi.Char>, ffi.Size, ffi.Pointer<ffi.Char>)>(
+    symbol: 'configure_program_cache', assetId: 'flutter_filament_plugin')
+external void configure_program_cache(
+  ffi.Pointer<ffi.Char> directory,
+  int maxSizeInBytes,
+  ffi.Pointer<ffi.Char> driverTag,
+);
+
 @ffi.Native<
         ffi.Pointer<ffi.Void> Function(
             ffi.Pointer<ffi.Void>,
@@ -122,6 +132,29 @@ external void load_ibl(
   double intensity,
 );
 
+@ffi.Native<
+        ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>,
+            ffi.Float, ffi.Pointer<ffi.Char>)>(
+    symbol: 'load_ibl_from_equirect', assetId: 'flutter_filament_plugin')
+external void load_ibl_from_equirect(
+  ffi.Pointer<ffi.Void> viewer,
+  ffi.Pointer<ffi.Char> path,
+  double intensity,
+  ffi.Pointer<ffi.Char> cacheDirectory,
+);
+
+@ffi.Native<
+        ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>,
+            ffi.Pointer<ffi.Char>, ffi.Float, ffi.Float)>(
+    symbol: 'load_environment', assetId: 'flutter_filament_plugin')
+external void load_environment(
+  ffi.Pointer<ffi.Void> viewer,
+  ffi.Pointer<ffi.Char> skyboxPath,
+  ffi.Pointer<ffi.Char> iblPath,
+  double intensity,
+  double crossfadeInSecs,
+);
+
 @ffi.Native<ffi.Void Function(ffi.Pointer<ffi.Void>)>(
     symbol: 'remove_skybox', assetId: 'flutter_filament_plugin')
 external void remove_skybox(
@@ -174,6 +207,65 @@ external void clear_lights(
   ffi.Pointer<ffi.Void> viewer,
 );
 
+@ffi.Native<
+    ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>,
+        ffi.Int, ffi.Pointer<ffi.Int>, ffi.Int, ffi.Int, ffi.Int)>(
+    symbol: 'create_dynamic_mesh', assetId: 'flutter_filament_plugin')
+external ffi.Pointer<ffi.Void> create_dynamic_mesh(
+  ffi.Pointer<ffi.Void> viewer,
+  ffi.Pointer<ffi.Char> materialPath,
+  int primitiveType,
+  ffi.Pointer<ffi.Int> components,
+  int maxVertices,
+  int maxIndices,
+  int numBuffers,
+);
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>)>(
+    symbol: 'remove_dynamic_mesh', assetId: 'flutter_filament_plugin')
+external bool remove_dynamic_mesh(
+  ffi.Pointer<ffi.Void> viewer,
+  ffi.Pointer<ffi.Void> mesh,
+);
+
+@ffi.Native<EntityId Function(ffi.Pointer<ffi.Void>)>(
+    symbol: 'get_dynamic_mesh_entity', assetId: 'flutter_filament_plugin')
+external int get_dynamic_mesh_entity(
+  ffi.Pointer<ffi.Void> mesh,
+);
+
+@ffi.Native<
+        ffi.Pointer<ffi.Float> Function(ffi.Pointer<ffi.Void>, ffi.Int, ffi.Int)>(
+    symbol: 'get_dynamic_mesh_attribute', assetId: 'flutter_filament_plugin')
+external ffi.Pointer<ffi.Float> get_dynamic_mesh_attribute(
+  ffi.Pointer<ffi.Void> mesh,
+  int slot,
+  int attribute,
+);
+
+@ffi.Native<ffi.Pointer<ffi.Uint32> Function(ffi.Pointer<ffi.Void>, ffi.Int)>(
+    symbol: 'get_dynamic_mesh_indices', assetId: 'flutter_filament_plugin')
+external ffi.Pointer<ffi.Uint32> get_dynamic_mesh_indices(
+  ffi.Pointer<ffi.Void> mesh,
+  int slot,
+);
+
+@ffi.Native<ffi.Int Function(ffi.Pointer<ffi.Void>)>(
+    symbol: 'get_dynamic_mesh_write_slot', assetId: 'flutter_filament_plugin')
+external int get_dynamic_mesh_write_slot(
+  ffi.Pointer<ffi.Void> mesh,
+);
+
+@ffi.Native<ffi.Int Function(ffi.Pointer<ffi.Void>, ffi.Int, ffi.Int)>(
+    symbol: 'publish_dynamic_mesh',
+    assetId: 'flutter_filament_plugin',
+    isLeaf: true)
+external int publish_dynamic_mesh(
+  ffi.Pointer<ffi.Void> mesh,
+  int numVertices,
+  int numIndices,
+);
+
 @ffi.Native<
     EntityId Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>,
         ffi.Bool)>(symbol: 'load_glb', assetId: 'flutter_filament_plugin')
@@ -183,6 +275,16 @@ external int load_glb(
   bool unlit,
 );
 
+@ffi.Native<
+        ffi.Bool Function(
+            ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>, ffi.Uint32)>(
+    symbol: 'add_material_specialization', assetId: 'flutter_filament_plugin')
+external bool add_material_specialization(
+  ffi.Pointer<ffi.Void> assetManager,
+  ffi.Pointer<ffi.Char> packagePath,
+  int features,
+);
+
 @ffi.Native<
         EntityId Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>,
             ffi.Pointer<ffi.Char>)>(
@@ -388,9 +490,208 @@ external void set_bone_animation(
   double frameLengthInMs,
 );
 
+@ffi.Native<
+        ffi.Bool Function(
+            ffi.Pointer<ffi.Void>,
+            EntityId,
+            ffi.Pointer<ffi.Float>,
+            ffi.Int,
+            ffi.Int,
+            ffi.Pointer<ffi.Pointer<ffi.Char>>,
+            ffi.Pointer<ffi.Pointer<ffi.Char>>,
+            ffi.Int,
+            ffi.Float)>(
+    symbol: 'set_bone_animation_trs', assetId: 'flutter_filament_plugin')
+external bool set_bone_animation_trs(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<ffi.Float> frameData,
+  int numFrames,
+  int numBones,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> boneNames,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> meshName,
+  int numMeshTargets,
+  double frameLengthInMs,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Bool, ffi.Float)>(
+    symbol: 'set_animation_compression', assetId: 'flutter_filament_plugin')
+external void set_animation_compression(
+  ffi.Pointer<ffi.Void> assetManager,
+  bool enabled,
+  double maxError,
+);
+
+@ffi.Native<
+        ffi.Size Function(ffi.Pointer<ffi.Float>, ffi.Int, ffi.Int, ffi.Float,
+            ffi.Float, ffi.Pointer<ffi.Uint8>, ffi.Size)>(
+    symbol: 'compress_morph_animation', assetId: 'flutter_filament_plugin')
+external int compress_morph_animation(
+  ffi.Pointer<ffi.Float> morphData,
+  int numMorphTargets,
+  int numFrames,
+  double frameLengthInMs,
+  double maxError,
+  ffi.Pointer<ffi.Uint8> out,
+  int capacity,
+);
+
+@ffi.Native<
+        ffi.Size Function(ffi.Pointer<ffi.Float>, ffi.Int, ffi.Int, ffi.Bool,
+            ffi.Float, ffi.Float, ffi.Pointer<ffi.Uint8>, ffi.Size)>(
+    symbol: 'compress_bone_animation', assetId: 'flutter_filament_plugin')
+external int compress_bone_animation(
+  ffi.Pointer<ffi.Float> frameData,
+  int numFrames,
+  int numBones,
+  bool includesScale,
+  double frameLengthInMs,
+  double maxError,
+  ffi.Pointer<ffi.Uint8> out,
+  int capacity,
+);
+
+@ffi.Native<
+        ffi.Bool Function(
+            ffi.Pointer<ffi.Void>,
+            EntityId,
+            ffi.Pointer<ffi.Char>,
+            ffi.Pointer<ffi.Void>,
+            ffi.Size,
+            ffi.Pointer<ffi.Int>,
+            ffi.Int)>(
+    symbol: 'set_morph_animation_compressed',
+    assetId: 'flutter_filament_plugin')
+external bool set_morph_animation_compressed(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<ffi.Char> entityName,
+  ffi.Pointer<ffi.Void> data,
+  int size,
+  ffi.Pointer<ffi.Int> morphIndices,
+  int numMorphTargets,
+);
+
+@ffi.Native<
+        ffi.Bool Function(
+            ffi.Pointer<ffi.Void>,
+            EntityId,
+            ffi.Pointer<ffi.Void>,
+            ffi.Size,
+            ffi.Int,
+            ffi.Pointer<ffi.Pointer<ffi.Char>>,
+            ffi.Pointer<ffi.Pointer<ffi.Char>>,
+            ffi.Int)>(
+    symbol: 'set_bone_animation_compressed', assetId: 'flutter_filament_plugin')
+external bool set_bone_animation_compressed(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<ffi.Void> data,
+  int size,
+  int numBones,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> boneNames,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> meshName,
+  int numMeshTargets,
+);
+
+@ffi.Native<
+        ffi.Bool Function(
+            ffi.Pointer<ffi.Void>,
+            EntityId,
+            ffi.Pointer<ffi.Char>,
+            ffi.Pointer<ffi.Int>,
+            ffi.Pointer<ffi.Int>,
+            ffi.Pointer<ffi.Int>,
+            ffi.Pointer<ffi.Float>,
+            ffi.Int)>(
+    symbol: 'set_morph_animation_curves', assetId: 'flutter_filament_plugin')
+external bool set_morph_animation_curves(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<ffi.Char> entityName,
+  ffi.Pointer<ffi.Int> morphIndices,
+  ffi.Pointer<ffi.Int> interpolations,
+  ffi.Pointer<ffi.Int> keyCounts,
+  ffi.Pointer<ffi.Float> keys,
+  int numCurves,
+);
+
+@ffi.Native<
+        ffi.Bool Function(
+            ffi.Pointer<ffi.Void>,
+            EntityId,
+            ffi.Pointer<ffi.Pointer<ffi.Char>>,
+            ffi.Int,
+            ffi.Pointer<ffi.Pointer<ffi.Char>>,
+            ffi.Int,
+            ffi.Pointer<ffi.Int>,
+            ffi.Pointer<ffi.Int>,
+            ffi.Pointer<ffi.Int>,
+            ffi.Pointer<ffi.Float>,
+            ffi.Int)>(
+    symbol: 'set_bone_animation_curves', assetId: 'flutter_filament_plugin')
+external bool set_bone_animation_curves(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> boneNames,
+  int numBones,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> meshName,
+  int numMeshTargets,
+  ffi.Pointer<ffi.Int> channels,
+  ffi.Pointer<ffi.Int> interpolations,
+  ffi.Pointer<ffi.Int> keyCounts,
+  ffi.Pointer<ffi.Float> keys,
+  int numCurves,
+);
+
+@ffi.Native<
+        ffi.Int Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Pointer<ffi.Char>>,
+            ffi.Int, ffi.Pointer<ffi.Float>)>(
+    symbol: 'create_skeleton', assetId: 'flutter_filament_plugin')
+external int create_skeleton(
+  ffi.Pointer<ffi.Void> assetManager,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> boneNames,
+  int numBones,
+  ffi.Pointer<ffi.Float> restPose,
+);
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Int)>(
+    symbol: 'remove_skeleton', assetId: 'flutter_filament_plugin')
+external bool remove_skeleton(
+  ffi.Pointer<ffi.Void> assetManager,
+  int skeleton,
+);
+
+@ffi.Native<
+        ffi.Int Function(ffi.Pointer<ffi.Void>, ffi.Int, ffi.Pointer<ffi.Float>,
+            ffi.Int, ffi.Float)>(
+    symbol: 'create_bone_animation_clip', assetId: 'flutter_filament_plugin')
+external int create_bone_animation_clip(
+  ffi.Pointer<ffi.Void> assetManager,
+  int skeleton,
+  ffi.Pointer<ffi.Float> frameData,
+  int numFrames,
+  double frameLengthInMs,
+);
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Int)>(
+    symbol: 'remove_bone_animation_clip', assetId: 'flutter_filament_plugin')
+external bool remove_bone_animation_clip(
+  ffi.Pointer<ffi.Void> assetManager,
+  int clip,
+);
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int)>(
+    symbol: 'set_bone_animation_clip', assetId: 'flutter_filament_plugin')
+external bool set_bone_animation_clip(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int clip,
+);
+
 @ffi.Native<
         ffi.Void Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Bool,
-            ffi.Bool, ffi.Bool, ffi.Float)>(
+            ffi.Bool, ffi.Bool, ffi.Float, ffi.Float)>(
     symbol: 'play_animation', assetId: 'flutter_filament_plugin')
 external void play_animation(
   ffi.Pointer<ffi.Void> assetManager,
@@ -400,16 +701,29 @@ external void play_animation(
   bool reverse,
   bool replaceActive,
   double crossfade,
+  double startOffset,
+);
+
+@ffi.Native<
+        ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Float)>(
+    symbol: 'seek_animation', assetId: 'flutter_filament_plugin')
+external bool seek_animation(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int animationIndex,
+  double timeInSecs,
 );
 
 @ffi.Native<
-        ffi.Void Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Int)>(
+        ffi.Bool Function(
+            ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Int, ffi.Float)>(
     symbol: 'set_animation_frame', assetId: 'flutter_filament_plugin')
-external void set_animation_frame(
+external bool set_animation_frame(
   ffi.Pointer<ffi.Void> assetManager,
   int asset,
   int animationIndex,
   int animationFrame,
+  double framesPerSecond,
 );
 
 @ffi.Native<ffi.Void Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int)>(
@@ -420,6 +734,468 @@ external void stop_animation(
   int index,
 );
 
+@ffi.Native<ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Float)>(
+    symbol: 'set_animation_time_scale', assetId: 'flutter_filament_plugin')
+external void set_animation_time_scale(
+  ffi.Pointer<ffi.Void> assetManager,
+  double timeScale,
+);
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Float)>(
+    symbol: 'set_asset_animation_time_scale',
+    assetId: 'flutter_filament_plugin')
+external bool set_asset_animation_time_scale(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  double timeScale,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Bool)>(
+    symbol: 'set_animations_paused', assetId: 'flutter_filament_plugin')
+external void set_animations_paused(
+  ffi.Pointer<ffi.Void> assetManager,
+  bool paused,
+);
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Bool)>(
+    symbol: 'set_asset_animations_paused', assetId: 'flutter_filament_plugin')
+external bool set_asset_animations_paused(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  bool paused,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Float)>(
+    symbol: 'set_fixed_animation_timestep', assetId: 'flutter_filament_plugin')
+external void set_fixed_animation_timestep(
+  ffi.Pointer<ffi.Void> assetManager,
+  double timestepInSecs,
+);
+
+@ffi.Native<
+        ffi.Void Function(
+            ffi.Pointer<ffi.Void>, ffi.Bool, ffi.Float, ffi.Float)>(
+    symbol: 'set_animation_lod', assetId: 'flutter_filament_plugin')
+external void set_animation_lod(
+  ffi.Pointer<ffi.Void> assetManager,
+  bool enabled,
+  double halfRateScreenSize,
+  double quarterRateScreenSize,
+);
+
+@ffi.Native<ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Bool, ffi.Float)>(
+    symbol: 'set_animation_baking', assetId: 'flutter_filament_plugin')
+external void set_animation_baking(
+  ffi.Pointer<ffi.Void> assetManager,
+  bool enabled,
+  double sampleRate,
+);
+
+@ffi.Native<
+        ffi.Int Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Float,
+            ffi.Bool, ffi.Bool)>(
+    symbol: 'add_animation_layer', assetId: 'flutter_filament_plugin')
+external int add_animation_layer(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int index,
+  double weight,
+  bool additive,
+  bool loop,
+);
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int)>(
+    symbol: 'remove_animation_layer', assetId: 'flutter_filament_plugin')
+external bool remove_animation_layer(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int layer,
+);
+
+@ffi.Native<
+        ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Float)>(
+    symbol: 'set_animation_layer_weight', assetId: 'flutter_filament_plugin')
+external bool set_animation_layer_weight(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int layer,
+  double weight,
+);
+
+@ffi.Native<
+        ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Float)>(
+    symbol: 'set_animation_layer_time', assetId: 'flutter_filament_plugin')
+external bool set_animation_layer_time(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int layer,
+  double timeInSecs,
+);
+
+@ffi.Native<
+        ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Float)>(
+    symbol: 'set_animation_layer_speed', assetId: 'flutter_filament_plugin')
+external bool set_animation_layer_speed(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int layer,
+  double speed,
+);
+
+@ffi.Native<
+        ffi.Bool Function(
+            ffi.Pointer<ffi.Void>,
+            EntityId,
+            ffi.Int,
+            ffi.Pointer<ffi.Pointer<ffi.Char>>,
+            ffi.Pointer<ffi.Float>,
+            ffi.Int,
+            ffi.Bool)>(
+    symbol: 'set_animation_layer_mask', assetId: 'flutter_filament_plugin')
+external bool set_animation_layer_mask(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int layer,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> jointNames,
+  ffi.Pointer<ffi.Float> weights,
+  int count,
+  bool includeDescendants,
+);
+
+@ffi.Native<
+        ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Uint64>,
+            ffi.Pointer<ffi.Uint64>, ffi.Bool)>(
+    symbol: 'get_skin_update_stats', assetId: 'flutter_filament_plugin')
+external void get_skin_update_stats(
+  ffi.Pointer<ffi.Void> assetManager,
+  ffi.Pointer<ffi.Uint64> updated,
+  ffi.Pointer<ffi.Uint64> skipped,
+  bool reset,
+);
+
+@ffi.Native<
+        ffi.Int32 Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int,
+            ffi.Pointer<ffi.Float>, ffi.Pointer<ffi.Float>, ffi.Float, ffi.Int)>(
+    symbol: 'tween_property', assetId: 'flutter_filament_plugin')
+external int tween_property(
+  ffi.Pointer<ffi.Void> assetManager,
+  int entity,
+  int property,
+  ffi.Pointer<ffi.Float> from,
+  ffi.Pointer<ffi.Float> to,
+  double durationInSecs,
+  int easing,
+);
+
+@ffi.Native<
+        ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            EntityId,
+            ffi.Pointer<ffi.Char>,
+            ffi.Int,
+            ffi.Pointer<ffi.Float>,
+            ffi.Pointer<ffi.Float>,
+            ffi.Float,
+            ffi.Int)>(
+    symbol: 'tween_material_color', assetId: 'flutter_filament_plugin')
+external int tween_material_color(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<ffi.Char> meshName,
+  int materialIndex,
+  ffi.Pointer<ffi.Float> from,
+  ffi.Pointer<ffi.Float> to,
+  double durationInSecs,
+  int easing,
+);
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Int32)>(
+    symbol: 'cancel_tween', assetId: 'flutter_filament_plugin')
+external bool cancel_tween(
+  ffi.Pointer<ffi.Void> assetManager,
+  int tween,
+);
+
+@ffi.Native<
+        ffi.Void Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<
+                ffi.NativeFunction<
+                    ffi.Void Function(ffi.Int32 tween, ffi.Bool finished)>>)>(
+    symbol: 'set_tween_callback', assetId: 'flutter_filament_plugin')
+external void set_tween_callback(
+  ffi.Pointer<ffi.Void> assetManager,
+  ffi.Pointer<
+          ffi.NativeFunction<
+              ffi.Void Function(ffi.Int32 tween, ffi.Bool finished)>>
+      callback,
+);
+
+@ffi.Native<
+        ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Void>, EntityId,
+            ffi.Pointer<ffi.Char>, ffi.Pointer<ffi.Pointer<ffi.Char>>, ffi.Int)>(
+    symbol: 'create_live_pose_stream', assetId: 'flutter_filament_plugin')
+external ffi.Pointer<ffi.Void> create_live_pose_stream(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<ffi.Char> meshName,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> boneNames,
+  int numBones,
+);
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId)>(
+    symbol: 'remove_live_pose_stream', assetId: 'flutter_filament_plugin')
+external bool remove_live_pose_stream(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+);
+
+@ffi.Native<
+        ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Int>,
+            ffi.Pointer<ffi.Int>)>(
+    symbol: 'get_live_pose_stream_layout', assetId: 'flutter_filament_plugin')
+external void get_live_pose_stream_layout(
+  ffi.Pointer<ffi.Void> stream,
+  ffi.Pointer<ffi.Int> numMorphWeights,
+  ffi.Pointer<ffi.Int> numBones,
+);
+
+@ffi.Native<ffi.Pointer<ffi.Float> Function(ffi.Pointer<ffi.Void>, ffi.Int)>(
+    symbol: 'get_live_pose_stream_slot', assetId: 'flutter_filament_plugin')
+external ffi.Pointer<ffi.Float> get_live_pose_stream_slot(
+  ffi.Pointer<ffi.Void> stream,
+  int slot,
+);
+
+@ffi.Native<ffi.Int Function(ffi.Pointer<ffi.Void>)>(
+    symbol: 'get_live_pose_stream_write_slot',
+    assetId: 'flutter_filament_plugin')
+external int get_live_pose_stream_write_slot(
+  ffi.Pointer<ffi.Void> stream,
+);
+
+@ffi.Native<ffi.Int Function(ffi.Pointer<ffi.Void>)>(
+    symbol: 'publish_live_pose',
+    assetId: 'flutter_filament_plugin',
+    isLeaf: true)
+external int publish_live_pose(
+  ffi.Pointer<ffi.Void> stream,
+);
+
+@ffi.Native<EntityId Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Pointer<ffi.Char>)>(
+    symbol: 'get_joint_handle', assetId: 'flutter_filament_plugin')
+external int get_joint_handle(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<ffi.Char> jointName,
+);
+
+@ffi.Native<
+        ffi.Int Function(ffi.Pointer<ffi.Void>, EntityId, EntityId, EntityId,
+            EntityId, ffi.Float)>(
+    symbol: 'add_two_bone_ik_constraint', assetId: 'flutter_filament_plugin')
+external int add_two_bone_ik_constraint(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int upperJoint,
+  int lowerJoint,
+  int endJoint,
+  double weight,
+);
+
+@ffi.Native<
+        ffi.Int Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Pointer<EntityId>,
+            ffi.Int, ffi.Bool, ffi.Int, ffi.Float)>(
+    symbol: 'add_chain_ik_constraint', assetId: 'flutter_filament_plugin')
+external int add_chain_ik_constraint(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<EntityId> joints,
+  int numJoints,
+  bool fabrik,
+  int iterations,
+  double weight,
+);
+
+@ffi.Native<
+        ffi.Int Function(ffi.Pointer<ffi.Void>, EntityId, EntityId, ffi.Float,
+            ffi.Float, ffi.Float, ffi.Float, ffi.Float)>(
+    symbol: 'add_look_at_constraint', assetId: 'flutter_filament_plugin')
+external int add_look_at_constraint(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int joint,
+  double forwardX,
+  double forwardY,
+  double forwardZ,
+  double maxAngle,
+  double weight,
+);
+
+@ffi.Native<
+        ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Float,
+            ffi.Float, ffi.Float)>(
+    symbol: 'set_constraint_target', assetId: 'flutter_filament_plugin')
+external bool set_constraint_target(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int constraint,
+  double x,
+  double y,
+  double z,
+);
+
+@ffi.Native<
+        ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, EntityId)>(
+    symbol: 'set_constraint_target_entity',
+    assetId: 'flutter_filament_plugin')
+external bool set_constraint_target_entity(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int constraint,
+  int target,
+);
+
+@ffi.Native<
+        ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Float,
+            ffi.Float, ffi.Float)>(
+    symbol: 'set_constraint_pole', assetId: 'flutter_filament_plugin')
+external bool set_constraint_pole(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int constraint,
+  double x,
+  double y,
+  double z,
+);
+
+@ffi.Native<
+        ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Float)>(
+    symbol: 'set_constraint_weight', assetId: 'flutter_filament_plugin')
+external bool set_constraint_weight(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int constraint,
+  double weight,
+);
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int)>(
+    symbol: 'remove_constraint', assetId: 'flutter_filament_plugin')
+external bool remove_constraint(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int constraint,
+);
+
+@ffi.Native<
+        ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Float)>(
+    symbol: 'set_animated_bounds', assetId: 'flutter_filament_plugin')
+external bool set_animated_bounds(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int mode,
+  double padding,
+);
+
+@ffi.Native<
+        ffi.Int Function(
+            ffi.Pointer<ffi.Void>, EntityId, ffi.Pointer<ffi.Char>, ffi.Float)>(
+    symbol: 'add_animation_state_parameter',
+    assetId: 'flutter_filament_plugin')
+external int add_animation_state_parameter(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<ffi.Char> name,
+  double value,
+);
+
+@ffi.Native<
+        ffi.Int Function(
+            ffi.Pointer<ffi.Void>,
+            EntityId,
+            ffi.Pointer<ffi.Char>,
+            ffi.Pointer<ffi.Int>,
+            ffi.Pointer<ffi.Float>,
+            ffi.Int,
+            ffi.Int,
+            ffi.Float,
+            ffi.Bool)>(
+    symbol: 'add_animation_state', assetId: 'flutter_filament_plugin')
+external int add_animation_state(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<ffi.Char> name,
+  ffi.Pointer<ffi.Int> clipIndices,
+  ffi.Pointer<ffi.Float> thresholds,
+  int numClips,
+  int blendParameter,
+  double speed,
+  bool loop,
+);
+
+@ffi.Native<
+        ffi.Int Function(
+            ffi.Pointer<ffi.Void>,
+            EntityId,
+            ffi.Int,
+            ffi.Int,
+            ffi.Float,
+            ffi.Float,
+            ffi.Pointer<ffi.Int>,
+            ffi.Pointer<ffi.Int>,
+            ffi.Pointer<ffi.Float>,
+            ffi.Int)>(
+    symbol: 'add_animation_state_transition',
+    assetId: 'flutter_filament_plugin')
+external int add_animation_state_transition(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int fromState,
+  int toState,
+  double crossfadeInSecs,
+  double exitTime,
+  ffi.Pointer<ffi.Int> parameters,
+  ffi.Pointer<ffi.Int> ops,
+  ffi.Pointer<ffi.Float> values,
+  int numConditions,
+);
+
+@ffi.Native<
+        ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Float)>(
+    symbol: 'set_animation_state_parameter',
+    assetId: 'flutter_filament_plugin')
+external bool set_animation_state_parameter(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int parameter,
+  double value,
+);
+
+@ffi.Native<
+        ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Float)>(
+    symbol: 'set_animation_state', assetId: 'flutter_filament_plugin')
+external bool set_animation_state(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  int state,
+  double crossfadeInSecs,
+);
+
+@ffi.Native<ffi.Int Function(ffi.Pointer<ffi.Void>, EntityId)>(
+    symbol: 'get_animation_state', assetId: 'flutter_filament_plugin')
+external int get_animation_state(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+);
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId)>(
+    symbol: 'remove_animation_state_machine',
+    assetId: 'flutter_filament_plugin')
+external bool remove_animation_state_machine(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+);
+
 @ffi.Native<ffi.Int Function(ffi.Pointer<ffi.Void>, EntityId)>(
     symbol: 'get_animation_count', assetId: 'flutter_filament_plugin')
 external int get_animation_count(
@@ -468,6 +1244,17 @@ external int get_morph_target_name_count(
   ffi.Pointer<ffi.Char> meshName,
 );
 
+@ffi.Native<
+        ffi.Int Function(
+            ffi.Pointer<ffi.Void>, EntityId, ffi.Pointer<ffi.Char>, ffi.Int)>(
+    symbol: 'get_asset_metadata', assetId: 'flutter_filament_plugin')
+external int get_asset_metadata(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<ffi.Char> outPtr,
+  int capacity,
+);
+
 @ffi.Native<ffi.Void Function(ffi.Pointer<ffi.Void>, EntityId)>(
     symbol: 'remove_asset', assetId: 'flutter_filament_plugin')
 external void remove_asset(
@@ -564,6 +1351,18 @@ external void set_camera_exposure(
   double sensitivity,
 );
 
+@ffi.Native<
+        ffi.Int32 Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Float>,
+            ffi.Pointer<ffi.Float>, ffi.Float, ffi.Int)>(
+    symbol: 'tween_camera_exposure', assetId: 'flutter_filament_plugin')
+external int tween_camera_exposure(
+  ffi.Pointer<ffi.Void> viewer,
+  ffi.Pointer<ffi.Float> from,
+  ffi.Pointer<ffi.Float> to,
+  double durationInSecs,
+  int easing,
+);
+
 @ffi.Native<
         ffi.Void Function(
             ffi.Pointer<ffi.Void>, ffi.Float, ffi.Float, ffi.Float)>(
@@ -689,6 +1488,38 @@ external int reveal_mesh(
   ffi.Pointer<ffi.Char> meshName,
 );
 
+@ffi.Native<
+        EntityId Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Pointer<ffi.Char>,
+            ffi.Int, ffi.Pointer<ffi.Float>, ffi.Int)>(
+    symbol: 'create_instanced_mesh', assetId: 'flutter_filament_plugin')
+external int create_instanced_mesh(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<ffi.Char> meshName,
+  int primitiveIndex,
+  ffi.Pointer<ffi.Float> transforms,
+  int count,
+);
+
+@ffi.Native<
+        ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId,
+            ffi.Pointer<ffi.Float>, ffi.Int, ffi.Int)>(
+    symbol: 'set_instance_transforms', assetId: 'flutter_filament_plugin')
+external bool set_instance_transforms(
+  ffi.Pointer<ffi.Void> assetManager,
+  int instancedMesh,
+  ffi.Pointer<ffi.Float> transforms,
+  int offset,
+  int count,
+);
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId)>(
+    symbol: 'remove_instanced_mesh', assetId: 'flutter_filament_plugin')
+external bool remove_instanced_mesh(
+  ffi.Pointer<ffi.Void> assetManager,
+  int instancedMesh,
+);
+
 @ffi.Native<ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Bool)>(
     symbol: 'set_post_processing', assetId: 'flutter_filament_plugin')
 external void set_post_processing(
@@ -891,6 +1722,29 @@ external void load_ibl_ffi(
   double intensity,
 );
 
+@ffi.Native<
+        ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>,
+            ffi.Float, ffi.Pointer<ffi.Char>)>(
+    symbol: 'load_ibl_from_equirect_ffi', assetId: 'flutter_filament_plugin')
+external void load_ibl_from_equirect_ffi(
+  ffi.Pointer<ffi.Void> viewer,
+  ffi.Pointer<ffi.Char> path,
+  double intensity,
+  ffi.Pointer<ffi.Char> cacheDirectory,
+);
+
+@ffi.Native<
+        ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>,
+            ffi.Pointer<ffi.Char>, ffi.Float, ffi.Float)>(
+    symbol: 'load_environment_ffi', assetId: 'flutter_filament_plugin')
+external void load_environment_ffi(
+  ffi.Pointer<ffi.Void> viewer,
+  ffi.Pointer<ffi.Char> skyboxPath,
+  ffi.Pointer<ffi.Char> iblPath,
+  double intensity,
+  double crossfadeInSecs,
+);
+
 @ffi.Native<ffi.Void Function(ffi.Pointer<ffi.Void>)>(
     symbol: 'remove_skybox_ffi', assetId: 'flutter_filament_plugin')
 external void remove_skybox_ffi(
@@ -943,6 +1797,27 @@ external void clear_lights_ffi(
   ffi.Pointer<ffi.Void> viewer,
 );
 
+@ffi.Native<
+    ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>,
+        ffi.Int, ffi.Pointer<ffi.Int>, ffi.Int, ffi.Int, ffi.Int)>(
+    symbol: 'create_dynamic_mesh_ffi', assetId: 'flutter_filament_plugin')
+external ffi.Pointer<ffi.Void> create_dynamic_mesh_ffi(
+  ffi.Pointer<ffi.Void> viewer,
+  ffi.Pointer<ffi.Char> materialPath,
+  int primitiveType,
+  ffi.Pointer<ffi.Int> components,
+  int maxVertices,
+  int maxIndices,
+  int numBuffers,
+);
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>)>(
+    symbol: 'remove_dynamic_mesh_ffi', assetId: 'flutter_filament_plugin')
+external bool remove_dynamic_mesh_ffi(
+  ffi.Pointer<ffi.Void> viewer,
+  ffi.Pointer<ffi.Void> mesh,
+);
+
 @ffi.Native<
     EntityId Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>,
         ffi.Bool)>(symbol: 'load_glb_ffi', assetId: 'flutter_filament_plugin')
@@ -952,6 +1827,16 @@ external int load_glb_ffi(
   bool unlit,
 );
 
+@ffi.Native<
+        ffi.Bool Function(
+            ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>, ffi.Uint32)>(
+    symbol: 'add_material_specialization_ffi', assetId: 'flutter_filament_plugin')
+external bool add_material_specialization_ffi(
+  ffi.Pointer<ffi.Void> assetManager,
+  ffi.Pointer<ffi.Char> packagePath,
+  int features,
+);
+
 @ffi.Native<
         EntityId Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>,
             ffi.Pointer<ffi.Char>)>(
@@ -1055,9 +1940,33 @@ external void set_bone_animation_ffi(
   double frameLengthInMs,
 );
 
+@ffi.Native<
+        ffi.Bool Function(
+            ffi.Pointer<ffi.Void>,
+            EntityId,
+            ffi.Pointer<ffi.Float>,
+            ffi.Int,
+            ffi.Int,
+            ffi.Pointer<ffi.Pointer<ffi.Char>>,
+            ffi.Pointer<ffi.Pointer<ffi.Char>>,
+            ffi.Int,
+            ffi.Float)>(
+    symbol: 'set_bone_animation_trs_ffi', assetId: 'flutter_filament_plugin')
+external bool set_bone_animation_trs_ffi(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<ffi.Float> frameData,
+  int numFrames,
+  int numBones,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> boneNames,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> meshName,
+  int numMeshTargets,
+  double frameLengthInMs,
+);
+
 @ffi.Native<
         ffi.Void Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Bool,
-            ffi.Bool, ffi.Bool, ffi.Float)>(
+            ffi.Bool, ffi.Bool, ffi.Float, ffi.Float)>(
     symbol: 'play_animation_ffi', assetId: 'flutter_filament_plugin')
 external void play_animation_ffi(
   ffi.Pointer<ffi.Void> assetManager,
@@ -1067,16 +1976,19 @@ external void play_animation_ffi(
   bool reverse,
   bool replaceActive,
   double crossfade,
+  double startOffset,
 );
 
 @ffi.Native<
-        ffi.Void Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Int)>(
+        ffi.Void Function(
+            ffi.Pointer<ffi.Void>, EntityId, ffi.Int, ffi.Int, ffi.Float)>(
     symbol: 'set_animation_frame_ffi', assetId: 'flutter_filament_plugin')
 external void set_animation_frame_ffi(
   ffi.Pointer<ffi.Void> assetManager,
   int asset,
   int animationIndex,
   int animationFrame,
+  double framesPerSecond,
 );
 
 @ffi.Native<ffi.Void Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Int)>(
@@ -1146,6 +2058,38 @@ external void pick_ffi(
   ffi.Pointer<EntityId> entityId,
 );
 
+@ffi.Native<
+        EntityId Function(ffi.Pointer<ffi.Void>, EntityId, ffi.Pointer<ffi.Char>,
+            ffi.Int, ffi.Pointer<ffi.Float>, ffi.Int)>(
+    symbol: 'create_instanced_mesh_ffi', assetId: 'flutter_filament_plugin')
+external int create_instanced_mesh_ffi(
+  ffi.Pointer<ffi.Void> assetManager,
+  int asset,
+  ffi.Pointer<ffi.Char> meshName,
+  int primitiveIndex,
+  ffi.Pointer<ffi.Float> transforms,
+  int count,
+);
+
+@ffi.Native<
+        ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId,
+            ffi.Pointer<ffi.Float>, ffi.Int, ffi.Int)>(
+    symbol: 'set_instance_transforms_ffi', assetId: 'flutter_filament_plugin')
+external bool set_instance_transforms_ffi(
+  ffi.Pointer<ffi.Void> assetManager,
+  int instancedMesh,
+  ffi.Pointer<ffi.Float> transforms,
+  int offset,
+  int count,
+);
+
+@ffi.Native<ffi.Bool Function(ffi.Pointer<ffi.Void>, EntityId)>(
+    symbol: 'remove_instanced_mesh_ffi', assetId: 'flutter_filament_plugin')
+external bool remove_instanced_mesh_ffi(
+  ffi.Pointer<ffi.Void> assetManager,
+  int instancedMesh,
+);
+
 @ffi.Native<ffi.Void Function()>(
     symbol: 'ios_dummy_ffi', assetId: 'flutter_filament_plugin')
 external void ios_dummy_ffi();